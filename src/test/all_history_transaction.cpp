@@ -23,7 +23,6 @@
 //--------------------------------------------------------------------
 
 #include "all_history_transaction.h"
-#include "store_manager.h"
 
 //---------------------Default-Constructor----------------------------
 /**
@@ -67,24 +66,44 @@ AllHistoryTransaction::~AllHistoryTransaction () {}
 //---------------------getNewInstance---------------------------------
 /**
  * @brief Retuns a pointer to a new AllHisotryTransaction. The data of
- *	  the new object will be set using the provided file stream.
+ *	  the new object will be set using the provided line.
  *	
- * Preconditions: The file stream is open and correctly formatted
+ * Preconditions: The line is correctly formatted
  *		  according to Lab 4 specs.  	
  *
  * Postconditions: A new object was created using the provided file to
  *		   set its data. A pointer to the object was then
  *		   returned. 
  * 
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return A pointer to the new instance.
  */
 AllHistoryTransaction * AllHistoryTransaction::getNewInstance 
-				(ifstream &input) const
+				(FieldReader &input) const
 {
 	char type;
-	input >> type;
-	input.ignore (INT_MAX, '\n');
+	type = input.readChar ();
+	return new AllHistoryTransaction (type);
+}
+
+
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new AllHistoryTransaction, read from a snapshot 
+ *	  written by save.
+ *	
+ * Preconditions: The snapshot is at a AllHistoryTransaction saved by save.
+ *
+ * Postconditions: A new AllHistoryTransaction was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+AllHistoryTransaction * AllHistoryTransaction::getNewInstance (SnapshotReader &input) const
+{
+	char type;
+	type = input.getByte ();
 	return new AllHistoryTransaction (type);
 }
 
@@ -103,20 +122,3 @@ AllHistoryTransaction * AllHistoryTransaction::clone () const
 {
 	return new AllHistoryTransaction (getType());
 }
-
-
-//---------------------execute----------------------------------------
-/**
- * @brief Calls the appropriate method on the store manager.
- * 
- * Preconditions: The storemanager is not NULL.
- *
- * Postconditions: The storemanager's method has been called.
- *
- * @param mgr The store manager.
- */
-void AllHistoryTransaction::execute (StoreManager *mgr) const
-{
-	mgr->printAllHistory ();
-}
-
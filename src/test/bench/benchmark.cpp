@@ -0,0 +1,206 @@
+/**
+ * @file benchmark.cpp
+ *
+ * @brief This is the end to end benchmark of the store. It writes an
+ *	  inventory, customer and transactions file with a
+ *	  WorkloadGenerator, then loads the store from them and streams
+ *	  the transactions through it, as runStreaming does, and
+ *	  reports how long each step took and the peak memory used.
+ *
+ *	  usage: benchmark [-i items] [-c customers] [-n commands]
+ *			   [-z skew] [-m P,T,H,I,A] [-s seed] [-r] [-v]
+ *			   directory
+ *
+ *	  -r reuses the files already in the directory, and -v keeps
+ *	  the reports of the store on standard output. The results go
+ *	  to standard error.
+ *
+ *	  Built from src/test, with every source but main.cpp:
+ *
+ *	  g++ -O2 -o benchmark bench/benchmark.cpp
+ *	      bench/workload_generator.cpp
+ *	      $(ls *.cpp | grep -v main.cpp) -pthread
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows setting the scale, skew, command mix and seed of the
+ *	  workload.
+ *	- Reports the time to write the files, the time to load the
+ *	  store, the transactions processed per second, and the peak
+ *	  resident set size.
+ *
+ * Assumptions:
+ *	- It is built with the sources of the store, but not with its
+ *	  main.cpp.
+ *	- The reports of the store are discarded by default, so the
+ *	  time writing them to a terminal is not measured.
+ */
+//--------------------------------------------------------------------
+
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include "workload_generator.h"
+#include "../store_initializer.h"
+
+/**
+ * @brief How the benchmark is run.
+ */
+char const USAGE[] = "usage: benchmark [-i items] [-c customers] "
+		     "[-n commands] [-z skew] [-m P,T,H,I,A] [-s seed] "
+		     "[-r] [-v] directory";
+
+
+//---------------------seconds----------------------------------------
+/**
+ * @brief Returns the time of a monotonic clock.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The time was returned.
+ *
+ * @return The time in seconds.
+ */
+static double seconds ()
+{
+	struct timespec now;
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+//---------------------readMix----------------------------------------
+/**
+ * @brief Reads the MIX_SIZE weights of a mix, separated by commas.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the weights were read, none is
+ *		   negative and one is positive, false otherwise.
+ *
+ * @param text The weights.
+ * @param weights The MIX_SIZE weights read.
+ * @return True if read, false otherwise.
+ */
+static bool readMix (const char *text, int weights [])
+{
+	char *end;
+	int   total = 0;
+
+	for (int i = 0; i < MIX_SIZE; i++) {
+		weights [i] = (int)strtol (text, &end, 10);
+		if (end == text || weights [i] < 0) return false;
+		if (i + 1 < MIX_SIZE && *end++ != ',') return false;
+		total += weights [i];
+		text   = end;
+	}
+	return *end == '\0' && total > 0;
+}
+
+
+/**
+ * @brief Writes the workload, if asked to, and measures the store on
+ *	  it.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @return Zero for success.
+ */
+int main (int argc, char *argv [])
+{
+	long long items = 100000, customers = 10000, commands = 1000000;
+	unsigned long long seed = 343;
+	double    skew = 1.0, start, load, process;
+	int       weights [MIX_SIZE] = { 60, 35, 5, 0, 0 };
+	bool      reuse = false, verbose = false;
+	int       option;
+	struct rusage usage;
+
+	while ((option = getopt (argc, argv, "i:c:n:z:m:s:rv")) != -1) {
+		switch (option) {
+		case 'i': items     = atoll (optarg);	break;
+		case 'c': customers = atoll (optarg);	break;
+		case 'n': commands  = atoll (optarg);	break;
+		case 'z': skew      = atof (optarg);	break;
+		case 's': seed      = strtoull (optarg, NULL, 10); break;
+		case 'r': reuse     = true;		break;
+		case 'v': verbose   = true;		break;
+		case 'm':
+			if (readMix (optarg, weights)) break;
+			cerr << USAGE << endl;
+			return 1;
+		default:
+			cerr << USAGE << endl;
+			return 1;
+		}
+	}
+	if (optind + 1 != argc || items <= 0 || customers <= 0 ||
+	    commands < 0 || skew < 0) {
+		cerr << USAGE << endl;
+		return 1;
+	}
+
+	// The store reads its files from the working directory.
+	mkdir (argv [optind], 0777);
+	if (chdir (argv [optind]) != 0) {
+		cerr << "Error: Failed to enter directory - "
+		     << argv [optind] << endl;
+		return 1;
+	}
+
+	if (!reuse) {
+		WorkloadGenerator workload (seed);
+		workload.setScale (items, customers, commands);
+		workload.setSkew (skew);
+		workload.setMix (weights);
+
+		start = seconds ();
+		if (!workload.generate (INVENTORY_FILE, CUSTOMERS_FILE,
+					TRANSACTIONS_FILE)) {
+			cerr << "Error: Failed to write the workload" << endl;
+			return 1;
+		}
+		cerr << "generate     : " << seconds () - start << " s"
+		     << endl;
+	}
+
+	if (!verbose) {
+		int null = open ("/dev/null", O_WRONLY);
+		cout.flush ();
+		if (null >= 0) {
+			dup2 (null, STDOUT_FILENO);
+			close (null);
+		}
+	}
+
+	StoreInitializer store;
+
+	start    = seconds ();
+	store.initStore ();
+	load     = seconds () - start;
+
+	start   = seconds ();
+	commands = store.streamTransactions ();
+	process  = seconds () - start;
+
+	getrusage (RUSAGE_SELF, &usage);
+	cerr << "load         : " << load << " s" << endl;
+	cerr << "transactions : " << commands << " in " << process << " s, "
+	     << (process > 0 ? (long long)(commands / process) : 0)
+	     << " per second" << endl;
+	cerr << "peak RSS     : " << usage.ru_maxrss << " KB" << endl;
+	return 0;
+}
@@ -0,0 +1,492 @@
+/**
+ * @file workload_generator.cpp
+ *
+ * @brief The WorkloadGenerator writes an inventory, customer and
+ *	  transactions file in the Lab 4 formats, at any scale, for the
+ *	  store to be measured on. The same seed always writes the same
+ *	  files.
+ *
+ * @brief The items purchased and traded follow a Zipf distribution:
+ *	  the item of rank k is picked in proportion to 1 / k^skew. The
+ *	  ranks are sampled by rejection-inversion, which takes no table,
+ *	  so any number of items costs no memory. The ranks are spread
+ *	  over the items, so the popular ones are not adjacent in the
+ *	  inventory.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows setting the number of items, customers and commands.
+ *	- Allows setting the skew of the item popularity; 0 is uniform.
+ *	- Allows setting the mix of the purchase, trade, history,
+ *	  inventory and all history commands, as weights.
+ *	- Allows writing the three files.
+ *
+ * Assumptions:
+ *	- There is at least one item and one customer.
+ *	- Every item is in the inventory, with one to ten copies.
+ *	  Purchases and trades name items of the inventory, by
+ *	  customers that exist.
+ */
+//--------------------------------------------------------------------
+
+#include "workload_generator.h"
+#include <cmath>
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a WorkloadGenerator for the provided seed, with a 
+ *	  small default scale, a skew of 1 and a mix of 60 purchases, 35
+ *	  trades and 5 histories.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This WorkloadGenerator was created.
+ *
+ * @param seed The seed of the random numbers.
+ */
+WorkloadGenerator::WorkloadGenerator (unsigned long long seed)
+{
+	int weights [MIX_SIZE] = { 60, 35, 5, 0, 0 };
+
+	my_state     = seed;
+	my_items     = 100000;
+	my_customers = 10000;
+	my_commands  = 1000000;
+	my_skew      = 1.0;
+	setMix (weights);
+}
+
+
+//---------------------setScale---------------------------------------
+/**
+ * @brief Sets the number of items, customers and commands to write.
+ *
+ * Preconditions: items and customers are positive, and commands is not
+ *		  negative.
+ *
+ * Postconditions: The scale was set.
+ *
+ * @param items The number of items in the inventory.
+ * @param customers The number of customers.
+ * @param commands The number of commands.
+ */
+void WorkloadGenerator::setScale (long long items, long long customers,
+						long long commands)
+{
+	my_items     = items;
+	my_customers = customers;
+	my_commands  = commands;
+}
+
+
+//---------------------setSkew----------------------------------------
+/**
+ * @brief Sets the skew of the item popularity.
+ *
+ * Preconditions: skew is not negative.
+ *
+ * Postconditions: The skew was set.
+ *
+ * @param skew The exponent of the Zipf distribution.
+ */
+void WorkloadGenerator::setSkew (double skew)
+{
+	my_skew = skew;
+}
+
+
+//---------------------setMix-----------------------------------------
+/**
+ * @brief Sets the weight of each command type, in the order of 
+ *	  MIX_TYPES.
+ *
+ * Preconditions: No weight is negative, and one is positive.
+ *
+ * Postconditions: The mix was set.
+ *
+ * @param weights The MIX_SIZE weights.
+ */
+void WorkloadGenerator::setMix (const int weights [])
+{
+	my_total = 0;
+	for (int i = 0; i < MIX_SIZE; i++) {
+		my_mix [i] = weights [i];
+		my_total  += weights [i];
+	}
+}
+
+
+//---------------------generate---------------------------------------
+/**
+ * @brief Writes the inventory, customer and transactions files, from 
+ *	  the seed.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the files were written, false 
+ *		   otherwise.
+ *
+ * @param inventory The inventory file.
+ * @param customers The customer file.
+ * @param commands The transactions file.
+ * @return True if written, false otherwise.
+ */
+bool WorkloadGenerator::generate (const char inventory [], 
+				const char customers [], const char commands [])
+{
+	ofstream items, people, lines;
+
+	prepare ();
+
+	items.open (inventory);
+	writeInventory (items);
+	items.close ();
+
+	people.open (customers);
+	writeCustomers (people);
+	people.close ();
+
+	lines.open (commands);
+	writeCommands (lines);
+	lines.close ();
+
+	return !items.fail () && !people.fail () && !lines.fail ();
+}
+
+
+//---------------------writeInventory---------------------------------
+/**
+ * @brief Writes every item, with its count.
+ *
+ * Preconditions: output is open.
+ *
+ * Postconditions: The inventory was written.
+ *
+ * @param output The inventory file.
+ */
+void WorkloadGenerator::writeInventory (ostream &output)
+{
+	for (long long i = 0; i < my_items && output; i++) {
+		writeItem (output, i, 1 + (int)(nextLong () % 10));
+		output << '\n';
+	}
+}
+
+
+//---------------------writeCustomers---------------------------------
+/**
+ * @brief Writes every customer. The first names are spread, so the 
+ *	  customers are not in the order of their names.
+ *
+ * Preconditions: output is open.
+ *
+ * Postconditions: The customers were written.
+ *
+ * @param output The customer file.
+ */
+void WorkloadGenerator::writeCustomers (ostream &output)
+{
+	for (long long i = 0; i < my_customers && output; i++) {
+		output << getCustomerId (i) << ", Name" 
+		       << (i * 7919) % my_customers << " Last" << i << '\n';
+	}
+}
+
+
+//---------------------writeCommands----------------------------------
+/**
+ * @brief Writes the commands, each of a type drawn from the mix, by a
+ *	  customer drawn uniformly, of an item drawn from the Zipf 
+ *	  distribution.
+ *
+ * Preconditions: output is open.
+ *
+ * Postconditions: The commands were written.
+ *
+ * @param output The transactions file.
+ */
+void WorkloadGenerator::writeCommands (ostream &output)
+{
+	long long i, customer;
+	int pick, type;
+
+	for (i = 0; i < my_commands && output; i++) {
+		pick = (int)(nextLong () % my_total);
+		for (type = 0; pick >= my_mix [type]; type++) 
+			pick -= my_mix [type];
+
+		switch (MIX_TYPES [type]) {
+		case PURCHASE_ID:
+		case TRADE_ID:
+			customer = (long long)(nextLong () % my_customers);
+			output << MIX_TYPES [type] << ", " 
+			       << getCustomerId (customer) << ", ";
+			writeItem (output, nextItem (), -1);
+			break;
+		case HISTORY_ID:
+			customer = (long long)(nextLong () % my_customers);
+			output << HISTORY_ID << ", " << getCustomerId (customer);
+			break;
+		default:
+			output << MIX_TYPES [type];
+		}
+		output << '\n';
+	}
+}
+
+
+//---------------------writeItem--------------------------------------
+/**
+ * @brief Writes the fields of an item, with its count if it is not 
+ *	  negative. The fields follow from the index, and the title 
+ *	  makes the item unique.
+ *
+ * Preconditions: index is in the inventory.
+ *
+ * Postconditions: The item was written, without an end of line.
+ *
+ * @param output The file.
+ * @param index The item.
+ * @param count The count, or -1.
+ */
+void WorkloadGenerator::writeItem (ostream &output, long long index, 
+						int count) const
+{
+	static const char TYPES [] = "RCD";
+	static const char *NAMES [] = { "Artist ", "Conductor ", "Director " };
+	int type = (int)(index % 3);
+
+	output << TYPES [type] << ", ";
+	if (count >= 0) output << count << ", ";
+	output << NAMES [type] << (index / 3) % 5000 << ", Title " << index
+	       << ", " << 1900 + index % 120;
+	if (TYPES [type] == 'C') output << ", Composer " << index % 700;
+}
+
+
+//---------------------getCustomerId----------------------------------
+/**
+ * @brief Returns the ID of a customer. The IDs have 12 digits, and are
+ *	  spread by a stride prime to their range, so they are unique 
+ *	  and not in order.
+ *
+ * Preconditions: index is a customer.
+ *
+ * Postconditions: The ID was returned.
+ *
+ * @param index The customer.
+ * @return The ID.
+ */
+long long WorkloadGenerator::getCustomerId (long long index) const
+{
+	return 100000000000LL + (index * 104729LL) % 900000000000LL;
+}
+
+
+//---------------------nextLong---------------------------------------
+/**
+ * @brief Returns the next random number (splitmix64).
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The state was advanced.
+ *
+ * @return 64 random bits.
+ */
+unsigned long long WorkloadGenerator::nextLong ()
+{
+	unsigned long long bits;
+
+	my_state += 0x9E3779B97F4A7C15ULL;
+	bits = my_state;
+	bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+	return bits ^ (bits >> 31);
+}
+
+
+//---------------------nextDouble-------------------------------------
+/**
+ * @brief Returns the next random number in [0, 1), from its top 53 
+ *	  bits.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The state was advanced.
+ *
+ * @return The number.
+ */
+double WorkloadGenerator::nextDouble ()
+{
+	return (nextLong () >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+//---------------------nextItem---------------------------------------
+/**
+ * @brief Draws an item from the Zipf distribution: a rank by 
+ *	  rejection-inversion (Hormann and Derflinger, 1996), mapped to
+ *	  the item of that rank. A point is drawn under the integral of
+ *	  x^-skew, and its rank is taken if the point is also under the
+ *	  step of that rank. Otherwise a new point is drawn.
+ *
+ * Preconditions: The skew and scale were set, and prepare was run.
+ *
+ * Postconditions: The state was advanced.
+ *
+ * @return The index of the item.
+ */
+long long WorkloadGenerator::nextItem ()
+{
+	double    point, x;
+	long long rank;
+
+	for (;;) {
+		point = my_last + nextDouble () * (my_first - my_last);
+		x     = inverse (point);
+		rank  = (long long)(x + 0.5);
+		if (rank < 1) 
+			rank = 1;
+		else if (rank > my_items) 
+			rank = my_items;
+		if (rank - x <= my_accept || 
+		    point >= integral (rank + 0.5) - density (rank))
+			break;
+	}
+	return (rank - 1) * my_stride % my_items;
+}
+
+
+//---------------------prepare----------------------------------------
+/**
+ * @brief Computes the constants of the sampler, and the stride that 
+ *	  spreads the ranks, from the skew and the number of items.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The sampler is ready.
+ */
+void WorkloadGenerator::prepare ()
+{
+	long long a, b, t;
+
+	my_first  = integral (1.5) - 1.0;
+	my_last   = integral (my_items + 0.5);
+	my_accept = 2.0 - inverse (integral (2.5) - density (2.0));
+
+	// The stride is the first number from the golden section of the 
+	// items on that is prime to them, so no two ranks map to one 
+	// item, and ranks in a row land far apart, on every type.
+	for (my_stride = (long long)(my_items * 0.6180339887); ; 
+							my_stride++) {
+		a = my_stride;
+		b = my_items;
+		while (b != 0) {
+			t = a % b;
+			a = b;
+			b = t;
+		}
+		if (a == 1) break;
+	}
+}
+
+
+//---------------------integral---------------------------------------
+/**
+ * @brief Returns H(x), the integral of x^-skew, from 1: 
+ *	  (x^(1 - skew) - 1) / (1 - skew), or log x for a skew of 1.
+ *
+ * Preconditions: x is positive.
+ *
+ * Postconditions: H(x) was returned.
+ *
+ * @param x The bound.
+ * @return H(x).
+ */
+double WorkloadGenerator::integral (double x) const
+{
+	double log_x = log (x);
+	return expRatio ((1.0 - my_skew) * log_x) * log_x;
+}
+
+
+//---------------------inverse----------------------------------------
+/**
+ * @brief Returns the inverse of H.
+ *
+ * Preconditions: x is in the range of H.
+ *
+ * Postconditions: The inverse was returned.
+ *
+ * @param x The value of H.
+ * @return The bound it is the integral to.
+ */
+double WorkloadGenerator::inverse (double x) const
+{
+	double t = x * (1.0 - my_skew);
+	if (t < -1.0) t = -1.0;
+	return exp (logRatio (t) * x);
+}
+
+
+//---------------------density----------------------------------------
+/**
+ * @brief Returns x^-skew.
+ *
+ * Preconditions: x is positive.
+ *
+ * Postconditions: x^-skew was returned.
+ *
+ * @param x The rank.
+ * @return x^-skew.
+ */
+double WorkloadGenerator::density (double x) const
+{
+	return exp (-my_skew * log (x));
+}
+
+
+//---------------------logRatio---------------------------------------
+/**
+ * @brief Returns log (1 + x) / x. Near 0 its series is used, as the
+ *	  quotient loses its precision there.
+ *
+ * Preconditions: x is greater than -1.
+ *
+ * Postconditions: The ratio was returned.
+ *
+ * @param x The argument.
+ * @return The ratio.
+ */
+double WorkloadGenerator::logRatio (double x)
+{
+	if (fabs (x) > 1e-8) return log1p (x) / x;
+	return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+
+//---------------------expRatio---------------------------------------
+/**
+ * @brief Returns (e^x - 1) / x. Near 0 its series is used, as the 
+ *	  quotient loses its precision there.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The ratio was returned.
+ *
+ * @param x The argument.
+ * @return The ratio.
+ */
+double WorkloadGenerator::expRatio (double x)
+{
+	if (fabs (x) > 1e-8) return expm1 (x) / x;
+	return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
@@ -0,0 +1,392 @@
+/**
+ * @file workload_generator.h
+ *
+ * @brief The WorkloadGenerator writes an inventory, customer and
+ *	  transactions file in the Lab 4 formats, at any scale, for the
+ *	  store to be measured on. The same seed always writes the same
+ *	  files.
+ *
+ * @brief The items purchased and traded follow a Zipf distribution:
+ *	  the item of rank k is picked in proportion to 1 / k^skew. The
+ *	  ranks are sampled by rejection-inversion, which takes no table,
+ *	  so any number of items costs no memory. The ranks are spread
+ *	  over the items, so the popular ones are not adjacent in the
+ *	  inventory.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows setting the number of items, customers and commands.
+ *	- Allows setting the skew of the item popularity; 0 is uniform.
+ *	- Allows setting the mix of the purchase, trade, history,
+ *	  inventory and all history commands, as weights.
+ *	- Allows writing the three files.
+ *
+ * Assumptions:
+ *	- There is at least one item and one customer.
+ *	- Every item is in the inventory, with one to ten copies.
+ *	  Purchases and trades name items of the inventory, by
+ *	  customers that exist.
+ */
+//--------------------------------------------------------------------
+
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <iostream>
+#include <fstream>
+#include "../command.h"
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @brief The number of command types in a mix, in the order
+ *	  purchase, trade, history, inventory and all history.
+ */
+int const MIX_SIZE = 5;
+
+/**
+ * @brief The command types of a mix, in order.
+ */
+char const MIX_TYPES [MIX_SIZE] = { PURCHASE_ID, TRADE_ID, HISTORY_ID,
+				     INVENTORY_ID, ALL_ID };
+
+
+/**
+ * @class WorkloadGenerator
+ */
+class WorkloadGenerator {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a WorkloadGenerator for the provided seed,
+	 *	  with a small default scale, a skew of 1 and a mix of
+	 *	  60 purchases, 35 trades and 5 histories.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This WorkloadGenerator was created.
+	 *
+	 * @param seed The seed of the random numbers.
+	 */
+	WorkloadGenerator (unsigned long long seed);
+
+
+	//---------------------setScale-------------------------------
+	/**
+	 * @brief Sets the number of items, customers and commands to
+	 *	  write.
+	 *
+	 * Preconditions: items and customers are positive, and
+	 *		  commands is not negative.
+	 *
+	 * Postconditions: The scale was set.
+	 *
+	 * @param items The number of items in the inventory.
+	 * @param customers The number of customers.
+	 * @param commands The number of commands.
+	 */
+	void setScale (long long items, long long customers,
+						long long commands);
+
+
+	//---------------------setSkew--------------------------------
+	/**
+	 * @brief Sets the skew of the item popularity.
+	 *
+	 * Preconditions: skew is not negative.
+	 *
+	 * Postconditions: The skew was set.
+	 *
+	 * @param skew The exponent of the Zipf distribution.
+	 */
+	void setSkew (double skew);
+
+
+	//---------------------setMix---------------------------------
+	/**
+	 * @brief Sets the weight of each command type, in the order of
+	 *	  MIX_TYPES.
+	 *
+	 * Preconditions: No weight is negative, and one is positive.
+	 *
+	 * Postconditions: The mix was set.
+	 *
+	 * @param weights The MIX_SIZE weights.
+	 */
+	void setMix (const int weights []);
+
+
+	//---------------------generate-------------------------------
+	/**
+	 * @brief Writes the inventory, customer and transactions files,
+	 *	  from the seed.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the files were written,
+	 *		   false otherwise.
+	 *
+	 * @param inventory The inventory file.
+	 * @param customers The customer file.
+	 * @param commands The transactions file.
+	 * @return True if written, false otherwise.
+	 */
+	bool generate (const char inventory [], const char customers [],
+						const char commands []);
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------writeInventory-------------------------
+	/**
+	 * @brief Writes every item, with its count.
+	 *
+	 * Preconditions: output is open.
+	 *
+	 * Postconditions: The inventory was written.
+	 *
+	 * @param output The inventory file.
+	 */
+	void writeInventory (ostream &output);
+
+
+	//---------------------writeCustomers-------------------------
+	/**
+	 * @brief Writes every customer.
+	 *
+	 * Preconditions: output is open.
+	 *
+	 * Postconditions: The customers were written.
+	 *
+	 * @param output The customer file.
+	 */
+	void writeCustomers (ostream &output);
+
+
+	//---------------------writeCommands--------------------------
+	/**
+	 * @brief Writes the commands, each of a type drawn from the
+	 *	  mix, by a customer drawn uniformly, of an item drawn
+	 *	  from the Zipf distribution.
+	 *
+	 * Preconditions: output is open.
+	 *
+	 * Postconditions: The commands were written.
+	 *
+	 * @param output The transactions file.
+	 */
+	void writeCommands (ostream &output);
+
+
+	//---------------------writeItem------------------------------
+	/**
+	 * @brief Writes the fields of an item, with its count if it
+	 *	  is not negative. The fields follow from the index, and
+	 *	  the title makes the item unique.
+	 *
+	 * Preconditions: index is in the inventory.
+	 *
+	 * Postconditions: The item was written, without an end of
+	 *		   line.
+	 *
+	 * @param output The file.
+	 * @param index The item.
+	 * @param count The count, or -1.
+	 */
+	void writeItem (ostream &output, long long index, int count) const;
+
+
+	//---------------------getCustomerId--------------------------
+	/**
+	 * @brief Returns the ID of a customer. The IDs have 12 digits,
+	 *	  and are spread, so they are not in order.
+	 *
+	 * Preconditions: index is a customer.
+	 *
+	 * Postconditions: The ID was returned.
+	 *
+	 * @param index The customer.
+	 * @return The ID.
+	 */
+	long long getCustomerId (long long index) const;
+
+
+	//---------------------nextLong-------------------------------
+	/**
+	 * @brief Returns the next random number (splitmix64).
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The state was advanced.
+	 *
+	 * @return 64 random bits.
+	 */
+	unsigned long long nextLong ();
+
+
+	//---------------------nextDouble-----------------------------
+	/**
+	 * @brief Returns the next random number in [0, 1).
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The state was advanced.
+	 *
+	 * @return The number.
+	 */
+	double nextDouble ();
+
+
+	//---------------------nextItem-------------------------------
+	/**
+	 * @brief Draws an item from the Zipf distribution: a rank by
+	 *	  rejection-inversion, mapped to the item of that rank.
+	 *
+	 * Preconditions: The skew and scale were set.
+	 *
+	 * Postconditions: The state was advanced.
+	 *
+	 * @return The index of the item.
+	 */
+	long long nextItem ();
+
+
+	//---------------------prepare--------------------------------
+	/**
+	 * @brief Computes the constants of the sampler, and the stride
+	 *	  that spreads the ranks, from the skew and the number
+	 *	  of items.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The sampler is ready.
+	 */
+	void prepare ();
+
+
+	//---------------------integral-------------------------------
+	/**
+	 * @brief Returns H(x), the integral of x^-skew, from 1.
+	 *
+	 * Preconditions: x is positive.
+	 *
+	 * Postconditions: H(x) was returned.
+	 *
+	 * @param x The bound.
+	 * @return H(x).
+	 */
+	double integral (double x) const;
+
+
+	//---------------------inverse--------------------------------
+	/**
+	 * @brief Returns the inverse of H.
+	 *
+	 * Preconditions: x is in the range of H.
+	 *
+	 * Postconditions: The inverse was returned.
+	 *
+	 * @param x The value of H.
+	 * @return The bound it is the integral to.
+	 */
+	double inverse (double x) const;
+
+
+	//---------------------density--------------------------------
+	/**
+	 * @brief Returns x^-skew.
+	 *
+	 * Preconditions: x is positive.
+	 *
+	 * Postconditions: x^-skew was returned.
+	 *
+	 * @param x The rank.
+	 * @return x^-skew.
+	 */
+	double density (double x) const;
+
+
+	//---------------------logRatio-------------------------------
+	/**
+	 * @brief Returns log (1 + x) / x, also near 0.
+	 *
+	 * Preconditions: x is greater than -1.
+	 *
+	 * Postconditions: The ratio was returned.
+	 *
+	 * @param x The argument.
+	 * @return The ratio.
+	 */
+	static double logRatio (double x);
+
+
+	//---------------------expRatio-------------------------------
+	/**
+	 * @brief Returns (e^x - 1) / x, also near 0.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The ratio was returned.
+	 *
+	 * @param x The argument.
+	 * @return The ratio.
+	 */
+	static double expRatio (double x);
+
+	/**
+	 * @brief The state of the random numbers.
+	 */
+	unsigned long long my_state;
+
+	/**
+	 * @brief The number of items, customers and commands.
+	 */
+	long long my_items;
+	long long my_customers;
+	long long my_commands;
+
+	/**
+	 * @brief The exponent of the Zipf distribution.
+	 */
+	double my_skew;
+
+	/**
+	 * @brief The weight of each command type, and their sum.
+	 */
+	int my_mix [MIX_SIZE];
+	int my_total;
+
+	/**
+	 * @brief The constants of the sampler: H(1.5) - 1, H(items +
+	 *	  0.5), and the distance under which a rank is taken
+	 *	  without a test.
+	 */
+	double my_first;
+	double my_last;
+	double my_accept;
+
+	/**
+	 * @brief A number prime to the number of items. The item of
+	 *	  rank k is (k - 1) * my_stride modulo the items.
+	 */
+	long long my_stride;
+};
+#endif /* WORKLOAD_GENERATOR_H */
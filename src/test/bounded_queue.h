@@ -0,0 +1,235 @@
+/**
+ * @file bounded_queue.h
+ *
+ * @brief This class implements a BoundedQueue, a first in first out
+ *	  queue of fixed capacity shared by a producer thread and a
+ *	  consumer thread. A producer that finds the queue full waits
+ *	  for room, so a fast producer can never run more than the
+ *	  capacity ahead of the consumer.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows pushing a value, waiting while the queue is full.
+ *	- Allows popping a value, waiting while the queue is empty.
+ *	- Allows closing the queue, after which pops drain what is
+ *	  left and then fail, and pushes fail.
+ *
+ * Assumptions:
+ * 	- Values have a default constructor and can be copied.
+ *	- The queue is not destroyed while a thread is waiting on it.
+ */
+//--------------------------------------------------------------------
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <pthread.h>
+
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class BoundedQueue
+ */
+template <typename Value>
+class BoundedQueue {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates an empty, open BoundedQueue.
+	 *
+	 * Preconditions: capacity is positive.
+	 *
+	 * Postconditions: This BoundedQueue holds up to capacity
+	 *		   values.
+	 *
+	 * @param capacity The most values held at once.
+	 */
+	explicit BoundedQueue (int capacity)
+	{
+		my_values   = new Value [capacity];
+		my_capacity = capacity;
+		my_head     = 0;
+		my_size     = 0;
+		my_closed   = false;
+		pthread_mutex_init (&my_lock, NULL);
+		pthread_cond_init  (&my_not_full, NULL);
+		pthread_cond_init  (&my_not_empty, NULL);
+	}
+
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Deletes the buffer. Values left in the queue are
+	 *	  dropped.
+	 *
+	 * Preconditions: No thread is waiting on the queue.
+	 *
+ 	 * Postconditions: All resources have been released.
+	 */
+	~BoundedQueue ()
+	{
+		delete [] my_values;
+		my_values = NULL;
+		pthread_cond_destroy  (&my_not_empty);
+		pthread_cond_destroy  (&my_not_full);
+		pthread_mutex_destroy (&my_lock);
+	}
+
+
+	//---------------------push-----------------------------------
+	/**
+	 * @brief Adds a value at the back, waiting for room while the
+	 *	  queue is full.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the value was added,
+	 *		   false if the queue was closed.
+	 *
+	 * @param value The value to add.
+	 * @return True if added, false otherwise.
+	 */
+	bool push (const Value &value)
+	{
+		pthread_mutex_lock (&my_lock);
+		while (my_size == my_capacity && !my_closed)
+			pthread_cond_wait (&my_not_full, &my_lock);
+		if (my_closed) {
+			pthread_mutex_unlock (&my_lock);
+			return false;
+		}
+
+		my_values [(my_head + my_size) % my_capacity] = value;
+		my_size++;
+		pthread_cond_signal (&my_not_empty);
+		pthread_mutex_unlock (&my_lock);
+		return true;
+	}
+
+
+	//---------------------pop------------------------------------
+	/**
+	 * @brief Removes the value at the front, waiting for one while
+	 *	  the queue is empty and open.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The value was set and true was returned, or
+	 *		   false was returned if the queue is closed and
+	 *		   empty.
+	 *
+	 * @param value Set to the value removed.
+	 * @return True if a value was removed, false otherwise.
+	 */
+	bool pop (Value &value)
+	{
+		pthread_mutex_lock (&my_lock);
+		while (my_size == 0 && !my_closed)
+			pthread_cond_wait (&my_not_empty, &my_lock);
+		if (my_size == 0) {
+			pthread_mutex_unlock (&my_lock);
+			return false;
+		}
+
+		value   = my_values [my_head];
+		my_head = (my_head + 1) % my_capacity;
+		my_size--;
+		pthread_cond_signal (&my_not_full);
+		pthread_mutex_unlock (&my_lock);
+		return true;
+	}
+
+
+	//---------------------close----------------------------------
+	/**
+	 * @brief Closes the queue, waking every waiting thread.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: Later pushes fail, and pops fail once the
+	 *		   queue is empty.
+	 */
+	void close ()
+	{
+		pthread_mutex_lock (&my_lock);
+		my_closed = true;
+		pthread_cond_broadcast (&my_not_full);
+		pthread_cond_broadcast (&my_not_empty);
+		pthread_mutex_unlock (&my_lock);
+	}
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------Copy-Constructor-----------------------
+	/**
+	 * @brief Not implemented; threads share one queue.
+	 */
+	BoundedQueue (const BoundedQueue &the_other);
+
+
+	//---------------------operator(=)----------------------------
+	/**
+	 * @brief Not implemented; threads share one queue.
+	 */
+	const BoundedQueue & operator= (const BoundedQueue &the_other);
+
+	/**
+	 * @brief The ring buffer of values.
+	 */
+	Value *my_values;
+
+	/**
+	 * @brief The number of values the buffer holds.
+	 */
+	int my_capacity;
+
+	/**
+	 * @brief The index of the front value.
+	 */
+	int my_head;
+
+	/**
+	 * @brief The number of values in the queue.
+	 */
+	int my_size;
+
+	/**
+	 * @brief True once the queue was closed.
+	 */
+	bool my_closed;
+
+	/**
+	 * @brief Guards every member above.
+	 */
+	pthread_mutex_t my_lock;
+
+	/**
+	 * @brief Signalled when a value is popped.
+	 */
+	pthread_cond_t my_not_full;
+
+	/**
+	 * @brief Signalled when a value is pushed.
+	 */
+	pthread_cond_t my_not_empty;
+};
+#endif /* BOUNDED_QUEUE_H */
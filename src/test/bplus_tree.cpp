@@ -0,0 +1,1245 @@
+/*
+ * @file bplus_tree.cpp
+ *
+ * @brief This class represents a B+tree, an ordered index whose
+ *	  nodes hold many keys each. Every item is stored in a leaf,
+ *	  and the leaves are linked together in order. Inner nodes
+ *	  only hold separator keys used to steer a search to the
+ *	  correct leaf. Wide nodes keep the tree shallow, so a lookup
+ *	  touches only a few nodes, and in-order scans walk the
+ *	  linked leaves sequentially.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date November 16, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ *	- Allows displaying the contents of a BPlusTree using <<.
+ * 	- Allows inserting an object into the tree.
+ *	- Allows retrieving a specified object from the tree.
+ *	- Allows removing an occurrence of an object from the tree.
+ *	- Allows making the tree empty.
+ *	- Allows walking the tree in order with an Iterator, and
+ *	  scanning a range of keys with lowerBound and upperBound.
+ *	- Allows bulk loading sorted items in linear time.
+ *	- Keeps the printed line of each item, so printing the tree
+ *	  again only formats the items inserted since.
+ *	- Keeps the key count and occurrence total of every subtree,
+ *	  so rank, select and range counts take logarithmic time.
+ * Assumptions:
+ * 	- Data objects are not NULL when stored in the tree.
+ *	- Data objects have overloaded operator<< for displaying.
+ *	- Data objects have overloaded comparison operators that
+ *	  form a strict weak ordering.
+ */
+//--------------------------------------------------------------------
+
+#include "bplus_tree.h"
+
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates an empty BPlusTree.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The BPlusTree was instantiated with a NULL root.
+ */
+BPlusTree::BPlusTree ()
+{
+	init ();
+}
+
+
+//---------------------Copy-Constructor-------------------------------
+/**
+ * @brief Copies the other tree into this tree.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The other tree was copied into this tree.
+ *
+ * @param other The tree to copy.
+ */
+BPlusTree::BPlusTree (const BPlusTree &the_other)
+{
+	init ();
+	*this = the_other;
+}
+
+
+//---------------------Destructor-------------------------------------
+/**
+ * @brief Deletes all dynamically allocated objects within the tree.
+ *
+ * Preconditions: makeEmpty is implemented.
+ *
+ * Postconditions: This BPlusTree is empty with a NULL root.
+ */
+BPlusTree::~BPlusTree ()
+{
+	makeEmpty ();
+}
+
+
+//---------------------init-------------------------------------------
+/**
+ * @brief Sets up an empty tree. Shared by the constructors.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The tree is empty.
+ */
+void BPlusTree::init ()
+{
+	my_root  = NULL;
+	my_first = NULL;
+}
+
+
+//---------------------newLeaf----------------------------------------
+/**
+ * @brief Allocates an empty leaf.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: A pointer to the new leaf was returned.
+ *
+ * @return The new leaf.
+ */
+BPlusTree::Leaf * BPlusTree::newLeaf () const
+{
+	Leaf *leaf  = new Leaf;
+	leaf->leaf  = true;
+	leaf->count = 0;
+	leaf->size  = 0;
+	leaf->total = 0;
+	leaf->next  = NULL;
+	leaf->stale = false;
+	return leaf;
+}
+
+
+//---------------------render-----------------------------------------
+/**
+ * @brief Formats the lines of the keys of the leaf that are not 
+ *	  printed yet, and splices them into its lines. Lines printed
+ *	  before are copied over as they are.
+ *
+ * Preconditions: The leaf is stale.
+ *
+ * Postconditions: The leaf's lines hold every key's line.
+ *
+ * @param leaf The leaf.
+ */
+void BPlusTree::render (Leaf *leaf) const
+{
+	string lines;
+	int index, offset = 0;
+
+	for (index = 0; index < leaf->count; index++) {
+		if (leaf->lengths [index] >= 0) {
+			lines.append (leaf->lines, offset, 
+						leaf->lengths [index]);
+			offset += leaf->lengths [index];
+			continue;
+		}
+		ostringstream line;
+		line << *leaf->keys [index] << endl;
+		lines += line.str ();
+		leaf->lengths [index] = line.str ().size ();
+	}
+	leaf->lines.swap (lines);
+	leaf->stale = false;
+}
+
+
+//---------------------newInner---------------------------------------
+/**
+ * @brief Allocates an empty inner node.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: A pointer to the new inner node was returned.
+ *
+ * @return The new inner node.
+ */
+BPlusTree::Inner * BPlusTree::newInner () const
+{
+	Inner *inner = new Inner;
+	inner->leaf  = false;
+	inner->count = 0;
+	inner->size  = 0;
+	inner->total = 0;
+	return inner;
+}
+
+
+//---------------------insert-----------------------------------------
+/**
+ * @brief Inserts an item into the tree. If an equal item is already
+ *	  stored its occurrence count is incremented and ownership of
+ *	  item stays with the client.
+ *
+ * Preconditions: The item is not NULL, and there must be enough
+ *		  memory for any new nodes.
+ *
+ * Postconditions: The item was inserted into the tree.
+ *
+ * @param item The item to insert into the tree.
+ * @return True if successfully inserted, false otherwise.
+ */
+bool BPlusTree::insert (Object *the_item)
+{
+	return insertOccurrences (the_item, 1);
+}
+
+
+//---------------------insertOccurrences------------------------------
+/**
+ * @brief Inserts an item with the provided number of occurrences,
+ *	  growing a new root if the old one split.
+ *
+ * Preconditions: The item is not NULL and count is positive.
+ *
+ * Postconditions: The item was inserted, or its count was raised by
+ *		   count if already stored.
+ *
+ * @param item The item to insert.
+ * @param count The occurrences to add.
+ * @return True if successfully inserted, false otherwise.
+ */
+bool BPlusTree::insertOccurrences (Object *the_item, int count)
+{
+	Object *up_key  = NULL;
+	Node   *up_node = NULL;
+
+	// The first item starts a single leaf.
+	if (my_root == NULL) {
+		my_root  = newLeaf ();
+		my_first = static_cast<Leaf *> (my_root);
+	}
+
+	insertHelper (my_root, the_item, count, up_key, up_node);
+
+	// The root split, so the tree grows one level.
+	if (up_node != NULL) growRoot (up_key, up_node);
+	return true;
+}
+
+
+//---------------------growRoot---------------------------------------
+/**
+ * @brief Grows the tree one level after the root split.
+ *
+ * Preconditions: up_node is the new right sibling of the root.
+ *
+ * Postconditions: A new root over the old root and up_node was 
+ *		   installed.
+ *
+ * @param up_key The separator for up_node.
+ * @param up_node The new right sibling of the root.
+ */
+void BPlusTree::growRoot (Object *up_key, Node *up_node)
+{
+	Inner *root        = newInner ();
+	root->count        = 1;
+	root->keys [0]     = up_key;
+	root->children [0] = my_root;
+	root->children [1] = up_node;
+	root->size         = my_root->size + up_node->size;
+	root->total        = my_root->total + up_node->total;
+	my_root            = root;
+}
+
+
+//---------------------sum--------------------------------------------
+/**
+ * @brief Sets the size and total of the provided node from its keys,
+ *	  or from its children if it is an inner node.
+ *
+ * Preconditions: node is not NULL, and the size and total of its 
+ *		  children are up to date.
+ *
+ * Postconditions: The size and total of node are up to date.
+ *
+ * @param node The node to sum.
+ */
+void BPlusTree::sum (Node *node) const
+{
+	int index;
+
+	if (node->leaf) {
+		Leaf *leaf  = static_cast<Leaf *> (node);
+		leaf->size  = leaf->count;
+		leaf->total = 0;
+		for (index = 0; index < leaf->count; index++)
+			leaf->total += leaf->occurences [index];
+		return;
+	}
+
+	Inner *inner = static_cast<Inner *> (node);
+	inner->size  = 0;
+	inner->total = 0;
+	for (index = 0; index <= inner->count; index++) {
+		inner->size  += inner->children [index]->size;
+		inner->total += inner->children [index]->total;
+	}
+}
+
+
+//---------------------insertHelper-----------------------------------
+/**
+ * @brief A helper method for recursively inserting an item into the
+ *	  provided subtree. If the subtree root overflows it is split
+ *	  in two, and the new right sibling and its separator are
+ *	  handed back to the caller.
+ *
+ * Preconditions: root is not NULL.
+ *
+ * Postconditions: The item was inserted, and the size and total of
+ *		   root and up_node are up to date. up_node is the new
+ *		   right sibling of root if it split, NULL otherwise.
+ *
+ * @param root The root of the subtree.
+ * @param item The item being inserted.
+ * @param count The occurrences to add.
+ * @param up_key The separator for up_node.
+ * @param up_node The new right sibling of root, or NULL.
+ * @return True if the item was new to the subtree, false if only its
+ *	   count was raised.
+ */
+bool BPlusTree::insertHelper (Node *root, Object *the_item, int count,
+				Object *&up_key, Node *&up_node)
+{
+	int  index, pos, half;
+	bool added;
+	up_node = NULL;
+
+	if (root->leaf) {
+		Leaf *leaf = static_cast<Leaf *> (root);
+		pos = lowerIndex (leaf, *the_item);
+		leaf->total += count;
+
+		// Ownership of Object goes back to client.
+		if (pos < leaf->count && 
+		    leaf->keys [pos]->compareTo (*the_item) == 0) {
+			leaf->occurences [pos] += count;
+			return false;
+		}
+
+		// Shift larger keys right to open the slot.
+		for (index = leaf->count; index > pos; index--) {
+			leaf->keys [index]       = leaf->keys [index - 1];
+			leaf->occurences [index] = leaf->occurences [index - 1];
+			leaf->lengths [index]    = leaf->lengths [index - 1];
+		}
+		// We're taking ownership of the Object.
+		leaf->keys [pos]       = the_item;
+		leaf->occurences [pos] = count;
+		leaf->lengths [pos]    = -1;
+		leaf->stale            = true;
+		leaf->count++;
+		leaf->size++;
+
+		if (leaf->count <= ORDER) return true;
+
+		// Too full, so move the upper half to a new leaf.
+		Leaf *right  = newLeaf ();
+		half         = leaf->count / 2;
+		right->count = leaf->count - half;
+		right->stale = true;
+		for (index = 0; index < right->count; index++) {
+			right->keys [index]       = leaf->keys [half + index];
+			right->occurences [index] = leaf->occurences [half + index];
+			right->lengths [index]    = leaf->lengths [half + index];
+		}
+		// The printed lines are split where the halves meet.
+		for (pos = 0, index = 0; index < half; index++)
+			if (leaf->lengths [index] >= 0) 
+				pos += leaf->lengths [index];
+		right->lines.assign (leaf->lines, pos, string::npos);
+		leaf->lines.erase (pos);
+		leaf->count = half;
+		right->next = leaf->next;
+		leaf->next  = right;
+		up_key      = right->keys [0];
+		up_node     = right;
+		// The halves share the counts the leaf had.
+		sum (right);
+		leaf->size  -= right->size;
+		leaf->total -= right->total;
+		return true;
+	}
+
+	Inner  *inner = static_cast<Inner *> (root);
+	Object *child_key  = NULL;
+	Node   *child_node = NULL;
+
+	pos   = upperIndex (inner, *the_item);
+	added = insertHelper (inner->children [pos], the_item, count,
+						child_key, child_node);
+	inner->total += count;
+	if (added) inner->size++;
+	if (child_node == NULL) return added;
+
+	// Link the child's new sibling in right after it.
+	for (index = inner->count; index > pos; index--) {
+		inner->keys [index]         = inner->keys [index - 1];
+		inner->children [index + 1] = inner->children [index];
+	}
+	inner->keys [pos]         = child_key;
+	inner->children [pos + 1] = child_node;
+	inner->count++;
+
+	if (inner->count <= ORDER) return added;
+
+	// Too full, so the middle key moves up and the upper half
+	// moves to a new inner node.
+	Inner *right = newInner ();
+	half         = inner->count / 2;
+	right->count = inner->count - half - 1;
+	for (index = 0; index < right->count; index++)
+		right->keys [index] = inner->keys [half + 1 + index];
+	for (index = 0; index <= right->count; index++)
+		right->children [index] = inner->children [half + 1 + index];
+	up_key       = inner->keys [half];
+	up_node      = right;
+	inner->count = half;
+	sum (right);
+	inner->size  -= right->size;
+	inner->total -= right->total;
+	return added;
+}
+
+
+//---------------------build------------------------------------------
+/**
+ * @brief Adds the provided items, with their occurrence counts, to the
+ *	  tree. An empty tree is bulk loaded bottom up: the items are
+ *	  spread evenly over leaves filled to FILL keys, then each 
+ *	  level of inner nodes is built over the one below it. A tree
+ *	  that already holds items inserts them one at a time instead.
+ * 
+ * Preconditions: items is sorted in ascending order with no two items
+ *		  equal, and counts[i] is positive for every items[i].
+ * 
+ * Postconditions: The tree took ownership of the items and holds them
+ *		   with their counts.
+ * 
+ * @param items The sorted items.
+ * @param counts The occurrence count of each item.
+ */
+void BPlusTree::build (const vector<Object *> &items, 
+					const vector<int> &counts)
+{
+	vector<Node *>   level;	// Nodes of the level being built.
+	vector<Object *> lows;	// Smallest key under each node.
+	vector<Node *>   parents;
+	vector<Object *> parent_lows;
+	int total, nodes, size, next, node, index;
+	Leaf *prev = NULL;
+
+	if (my_root != NULL) {
+		for (index = 0; index < (int)items.size (); index++)
+			insertOccurrences (items [index], counts [index]);
+		return;
+	}
+	if (items.empty ()) return;
+
+	// Spread the items evenly over just enough leaves.
+	total = items.size ();
+	nodes = (total + FILL - 1) / FILL;
+	next  = 0;
+	for (node = 0; node < nodes; node++) {
+		size = (total - next) / (nodes - node);
+		Leaf *leaf  = newLeaf ();
+		leaf->count = size;
+		leaf->stale = true;
+		for (index = 0; index < size; index++) {
+			leaf->keys [index]       = items [next + index];
+			leaf->occurences [index] = counts [next + index];
+			leaf->lengths [index]    = -1;
+		}
+		sum (leaf);
+		// Link the leaves together in order.
+		if (prev != NULL) prev->next = leaf;
+		else my_first = leaf;
+		prev = leaf;
+
+		level.push_back (leaf);
+		lows.push_back (leaf->keys [0]);
+		next += size;
+	}
+
+	// Build inner levels until a single root remains.
+	while (level.size () > 1) {
+		total = level.size ();
+		nodes = (total + FILL) / (FILL + 1);
+		next  = 0;
+		parents.clear ();
+		parent_lows.clear ();
+		for (node = 0; node < nodes; node++) {
+			size = (total - next) / (nodes - node);
+			Inner *inner = newInner ();
+			inner->count = size - 1;
+			for (index = 0; index < size; index++) {
+				inner->children [index] = level [next + index];
+				// Each child but the first gets a separator.
+				if (index > 0)
+					inner->keys [index - 1] = lows [next + index];
+			}
+			sum (inner);
+			parents.push_back (inner);
+			parent_lows.push_back (lows [next]);
+			next += size;
+		}
+		level.swap (parents);
+		lows.swap (parent_lows);
+	}
+	my_root = level [0];
+}
+
+
+//---------------------retrieve---------------------------------------
+/**
+ * @brief Searches the tree for the given target, if found a pointer
+ *	  to the object is returned, NULL otherwise.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: A pointer to the object was returned if it was
+ *		   found, NULL otherwise.
+ *
+ * @param target The item to search for.
+ * @return Pointer to the object if found, NULL otherwise.
+ */
+const Object * BPlusTree::retrieve (const Object &the_item) const
+{
+	int index;
+	Leaf *leaf = find (the_item, index);
+
+	if (leaf == NULL) return NULL;
+	return leaf->keys [index];
+}
+
+
+//---------------------remove-----------------------------------------
+/**
+ * @brief Removes one occurrence of the provided item from the tree.
+ *	  The item stays in the tree once its count reaches zero, as
+ *	  in BSTree. The total of each node on the path to its leaf
+ *	  drops by one.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if an occurrence of the item was
+ *		   found and removed, false otherwise.
+ *
+ * @param item The item to remove from the tree.
+ * @return True if removed, false otherwise.
+ */
+bool BPlusTree::remove (const Object &the_item)
+{
+	int  index;
+	Leaf *leaf = find (the_item, index);
+
+	if (leaf == NULL || leaf->occurences [index] <= 0) return false;
+
+	leaf->occurences [index]--;
+	for (Node *node = my_root; node != leaf; ) {
+		Inner *inner = static_cast<Inner *> (node);
+		inner->total--;
+		node = inner->children [upperIndex (inner, the_item)];
+	}
+	leaf->total--;
+	return true;
+}
+
+
+//---------------------getOccurrence----------------------------------
+/**
+ * @brief Returns the occurrence count of the item.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The occurrence count, or zero if the item is not
+ *		   stored, was returned.
+ *
+ * @param item The item to get the count of.
+ * @return Occurrence count of the item.
+ */
+int BPlusTree::getOccurrence (const Object &the_item) const
+{
+	int index;
+	Leaf *leaf = find (the_item, index);
+
+	if (leaf == NULL) return 0;
+	return leaf->occurences [index];
+}
+
+
+//---------------------find-------------------------------------------
+/**
+ * @brief Finds the leaf slot holding the provided item.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The leaf holding the item was returned and index 
+ *		   was set to its slot, or NULL was returned if it is
+ *		   not stored.
+ *
+ * @param item The item being searched for.
+ * @param index Set to the slot of the item in the leaf.
+ * @return The leaf holding the item, or NULL.
+ */
+BPlusTree::Leaf * BPlusTree::find (const Object &the_item, 
+						int &index) const
+{
+	Leaf *leaf = findLeaf (the_item);
+	if (leaf == NULL) return NULL;
+
+	index = lowerIndex (leaf, the_item);
+	if (index < leaf->count && leaf->keys [index]->compareTo (the_item) == 0)
+		return leaf;
+	return NULL;
+}
+
+
+//---------------------findLeaf---------------------------------------
+/**
+ * @brief Returns the leaf the provided target belongs in.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The leaf covering target was returned, or NULL if 
+ *		   the tree is empty.
+ *
+ * @param target The item being searched for.
+ * @return The leaf covering target, or NULL.
+ */
+BPlusTree::Leaf * BPlusTree::findLeaf (const Object &target) const
+{
+	Node *node = my_root;
+	if (node == NULL) return NULL;
+
+	while (!node->leaf) {
+		Inner *inner = static_cast<Inner *> (node);
+		node = inner->children [upperIndex (inner, target)];
+	}
+	return static_cast<Leaf *> (node);
+}
+
+
+//---------------------lowerIndex-------------------------------------
+/**
+ * @brief Binary searches a node for the first key that is not less
+ *	  than the provided target.
+ *
+ * Preconditions: node is not NULL.
+ *
+ * Postconditions: The index of that key, or the key count if there is
+ *		   none, was returned.
+ *
+ * @param node The node to search.
+ * @param target The item being searched for.
+ * @return The index of the first key not less than target.
+ */
+int BPlusTree::lowerIndex (const Node *node, const Object &target) const
+{
+	int low = 0, high = node->count, mid;
+
+	while (low < high) {
+		mid = (low + high) / 2;
+		if (node->keys [mid]->compareTo (target) < 0)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low;
+}
+
+
+//---------------------upperIndex-------------------------------------
+/**
+ * @brief Binary searches a node for the first key that is greater
+ *	  than the provided target.
+ *
+ * Preconditions: node is not NULL.
+ *
+ * Postconditions: The index of that key, or the key count if there is
+ *		   none, was returned.
+ *
+ * @param node The node to search.
+ * @param target The item being searched for.
+ * @return The index of the first key greater than target.
+ */
+int BPlusTree::upperIndex (const Node *node, const Object &target) const
+{
+	int low = 0, high = node->count, mid;
+
+	while (low < high) {
+		mid = (low + high) / 2;
+		if (target.compareTo (*node->keys [mid]) < 0)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+	return low;
+}
+
+
+//---------------------makeEmpty--------------------------------------
+/**
+ * @brief Empties this tree and deletes the stored items.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The tree is empty with a NULL root.
+ */
+void BPlusTree::makeEmpty ()
+{
+	makeEmptyHelper (my_root, true);
+	my_root  = NULL;
+	my_first = NULL;
+}
+
+
+//---------------------clear------------------------------------------
+/**
+ * @brief Empties this tree without deleting the stored items, which 
+ *	  are freed with the Region.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The tree is empty with a NULL root.
+ */
+void BPlusTree::clear ()
+{
+	makeEmptyHelper (my_root, false);
+	my_root  = NULL;
+	my_first = NULL;
+}
+
+
+//---------------------makeEmptyHelper--------------------------------
+/**
+ * @brief Recursively deletes the provided subtree, and the items
+ *	  owned by its leaves if asked.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The subtree was deleted.
+ *
+ * @param root The root of the subtree.
+ * @param items True to delete the items, false to leave them.
+ */
+void BPlusTree::makeEmptyHelper (Node *root, bool items)
+{
+	int index;
+
+	if (root == NULL) return;
+
+	if (root->leaf) {
+		for (index = 0; items && index < root->count; index++)
+			delete root->keys [index];
+		delete static_cast<Leaf *> (root);
+	}
+	else {
+		Inner *inner = static_cast<Inner *> (root);
+		// Inner keys are borrowed from the leaves.
+		for (index = 0; index <= inner->count; index++)
+			makeEmptyHelper (inner->children [index], items);
+		delete inner;
+	}
+}
+
+
+//---------------------operator(=)------------------------------------
+/**
+ * @brief Overloaded assignment operator.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: the_other is copied into this.
+ *
+ * @param the_other The other tree to copy into this.
+ * @return this is returned.
+ */
+const BPlusTree& BPlusTree::operator= (const BPlusTree &the_other)
+{
+	// Check for self assignment.
+	if (this != &the_other) {
+		// Delete our current memory.
+		makeEmpty ();
+		// Now clone the other's items in order.
+		Iterator it;
+		for (it = the_other.begin (); it != the_other.end (); ++it)
+			insertOccurrences (it->clone (), it.getOccurrence ());
+	}
+	return *this;
+}
+
+
+//---------------------print------------------------------------------
+/**
+ * @brief Prints the items of this tree to the output stream in order,
+ *	  one per line, by walking the leaves. A leaf keeps the lines
+ *	  it printed, so only the items inserted since the last print
+ *	  are formatted; the rest are copied out as they were.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The items have been displayed.
+ *
+ * @param output The output stream.
+ */
+void BPlusTree::print (ostream &output) const
+{
+	for (Leaf *leaf = my_first; leaf != NULL; leaf = leaf->next) {
+		if (leaf->stale) render (leaf);
+		output.write (leaf->lines.data (), leaf->lines.size ());
+	}
+}
+
+
+//---------------------collect----------------------------------------
+/**
+ * @brief Lists the items of the tree in ascending order, with their
+ *	  occurrence counts, walking the leaves like print.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: items and counts were appended to. The tree still 
+ *		   owns the items.
+ * 
+ * @param items Filled with the items.
+ * @param counts Filled with the occurrence count of each item.
+ */
+void BPlusTree::collect (vector<const Object *> &items, 
+					vector<int> &counts) const
+{
+	int index;
+
+	for (Leaf *leaf = my_first; leaf != NULL; leaf = leaf->next) {
+		for (index = 0; index < leaf->count; index++) {
+			items.push_back (leaf->keys [index]);
+			counts.push_back (leaf->occurences [index]);
+		}
+	}
+}
+
+
+//---------------------begin------------------------------------------
+/**
+ * @brief Returns an Iterator positioned at the smallest item in the
+ *	  tree.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: An Iterator at the first item, or end() if the tree
+ *		   is empty, was returned.
+ *
+ * @return An Iterator at the first item.
+ */
+BPlusTree::Iterator BPlusTree::begin () const
+{
+	return Iterator (my_first, 0);
+}
+
+
+//---------------------end--------------------------------------------
+/**
+ * @brief Returns an Iterator positioned past the last item in the
+ *	  tree.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The past-the-end Iterator was returned.
+ *
+ * @return The past-the-end Iterator.
+ */
+BPlusTree::Iterator BPlusTree::end () const
+{
+	return Iterator ();
+}
+
+
+//---------------------lowerBound-------------------------------------
+/**
+ * @brief Returns an Iterator positioned at the first item that is not
+ *	  less than the provided target.
+ *
+ * Preconditions: target is comparable with the items stored in the
+ *		  tree.
+ *
+ * Postconditions: An Iterator at the first item not less than target,
+ *		   or end() if there is none, was returned.
+ *
+ * @param target The low end of the range.
+ * @return An Iterator at the first item not less than target.
+ */
+BPlusTree::Iterator BPlusTree::lowerBound (const Object &target) const
+{
+	Leaf *leaf = findLeaf (target);
+	if (leaf == NULL) return Iterator ();
+	return Iterator (leaf, lowerIndex (leaf, target));
+}
+
+
+//---------------------upperBound-------------------------------------
+/**
+ * @brief Returns an Iterator positioned at the first item that is
+ *	  greater than the provided target.
+ *
+ * Preconditions: target is comparable with the items stored in the
+ *		  tree.
+ *
+ * Postconditions: An Iterator at the first item greater than target,
+ *		   or end() if there is none, was returned.
+ *
+ * @param target The high end of the range.
+ * @return An Iterator at the first item greater than target.
+ */
+BPlusTree::Iterator BPlusTree::upperBound (const Object &target) const
+{
+	Leaf *leaf = findLeaf (target);
+	if (leaf == NULL) return Iterator ();
+	return Iterator (leaf, upperIndex (leaf, target));
+}
+
+
+//---------------------getSize----------------------------------------
+/**
+ * @brief Returns the number of items stored in the tree. An item whose
+ *	  count was removed down to zero is still stored.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The number of items was returned.
+ *
+ * @return The number of items.
+ */
+int BPlusTree::getSize () const
+{
+	return my_root == NULL ? 0 : my_root->size;
+}
+
+
+//---------------------getTotal---------------------------------------
+/**
+ * @brief Returns the sum of the occurrence counts of the items stored
+ *	  in the tree.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The sum of the counts was returned.
+ *
+ * @return The sum of the occurrence counts.
+ */
+int BPlusTree::getTotal () const
+{
+	return my_root == NULL ? 0 : my_root->total;
+}
+
+
+//---------------------rank-------------------------------------------
+/**
+ * @brief Returns the number of items less than the provided target,
+ *	  which is the index target has, or would have, in order.
+ *
+ * Preconditions: target is comparable with the items stored in the
+ *		  tree.
+ *
+ * Postconditions: The number of items less than target was returned.
+ *
+ * @param target The item to rank.
+ * @return The number of items less than target.
+ */
+int BPlusTree::rank (const Object &target) const
+{
+	int items, occurrences;
+
+	countBelow (target, false, items, occurrences);
+	return items;
+}
+
+
+//---------------------select-----------------------------------------
+/**
+ * @brief Returns the item at the provided index in order, counting 
+ *	  from zero. Each inner node skips the children whose sizes 
+ *	  add up to no more than index.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: A pointer to the item was returned, or NULL if
+ *		   index is not less than getSize().
+ *
+ * @param index The index of the item.
+ * @return Pointer to the item, or NULL.
+ */
+const Object * BPlusTree::select (int index) const
+{
+	Node *node = my_root;
+	int   child;
+
+	if (node == NULL || index < 0 || index >= node->size) return NULL;
+
+	while (!node->leaf) {
+		Inner *inner = static_cast<Inner *> (node);
+		for (child = 0; index >= inner->children [child]->size; 
+								child++)
+			index -= inner->children [child]->size;
+		node = inner->children [child];
+	}
+	return node->keys [index];
+}
+
+
+//---------------------count------------------------------------------
+/**
+ * @brief Returns the number of items that are not less than low and
+ *	  not greater than high.
+ *
+ * Preconditions: low and high are comparable with the items stored 
+ *		  in the tree.
+ *
+ * Postconditions: The number of items in the range, or zero if high is
+ *		   less than low, was returned.
+ *
+ * @param low The low end of the range.
+ * @param high The high end of the range.
+ * @return The number of items in the range.
+ */
+int BPlusTree::count (const Object &low, const Object &high) const
+{
+	int below, upto, occurrences;
+
+	if (high.compareTo (low) < 0) return 0;
+	countBelow (low, false, below, occurrences);
+	countBelow (high, true, upto, occurrences);
+	return upto - below;
+}
+
+
+//---------------------countOccurrences-------------------------------
+/**
+ * @brief Returns the sum of the occurrence counts of the items that 
+ *	  are not less than low and not greater than high.
+ *
+ * Preconditions: low and high are comparable with the items stored 
+ *		  in the tree.
+ *
+ * Postconditions: The sum of the counts in the range, or zero if high
+ *		   is less than low, was returned.
+ *
+ * @param low The low end of the range.
+ * @param high The high end of the range.
+ * @return The sum of the occurrence counts in the range.
+ */
+int BPlusTree::countOccurrences (const Object &low, 
+					const Object &high) const
+{
+	int items, below, upto;
+
+	if (high.compareTo (low) < 0) return 0;
+	countBelow (low, false, items, below);
+	countBelow (high, true, items, upto);
+	return upto - below;
+}
+
+
+//---------------------countBelow-------------------------------------
+/**
+ * @brief Counts the items less than the provided target, or not 
+ *	  greater than it if inclusive. The search path to target's
+ *	  leaf is followed, adding up the sizes and totals of the
+ *	  children left of it, then the keys before target's slot.
+ *
+ * Preconditions: target is comparable with the items stored in the
+ *		  tree.
+ *
+ * Postconditions: items and occurrences were set.
+ *
+ * @param target The item to count below.
+ * @param inclusive True to also count an item equal to target.
+ * @param items Set to the number of items.
+ * @param occurrences Set to the sum of their counts.
+ */
+void BPlusTree::countBelow (const Object &target, bool inclusive,
+				int &items, int &occurrences) const
+{
+	Node *node = my_root;
+	int   index, pos;
+
+	items       = 0;
+	occurrences = 0;
+	if (node == NULL) return;
+
+	while (!node->leaf) {
+		Inner *inner = static_cast<Inner *> (node);
+		pos = upperIndex (inner, target);
+		for (index = 0; index < pos; index++) {
+			items       += inner->children [index]->size;
+			occurrences += inner->children [index]->total;
+		}
+		node = inner->children [pos];
+	}
+
+	Leaf *leaf = static_cast<Leaf *> (node);
+	pos = inclusive ? upperIndex (leaf, target) : lowerIndex (leaf, target);
+	items += pos;
+	for (index = 0; index < pos; index++)
+		occurrences += leaf->occurences [index];
+}
+
+
+//---------------------Iterator::Constructor--------------------------
+/**
+ * @brief Creates a past-the-end Iterator.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This Iterator is equal to BPlusTree::end().
+ */
+BPlusTree::Iterator::Iterator ()
+{
+	my_leaf  = NULL;
+	my_index = 0;
+}
+
+
+//---------------------Iterator::Constructor--------------------------
+/**
+ * @brief Creates an Iterator at the provided leaf slot. A slot past
+ *	  the end of the leaf moves on to the next leaf.
+ *
+ * Preconditions: index is at most the key count of leaf.
+ *
+ * Postconditions: This Iterator is at the first item at or after the
+ *		   slot.
+ *
+ * @param leaf The leaf.
+ * @param index The slot within the leaf.
+ */
+BPlusTree::Iterator::Iterator (const Leaf *leaf, int index)
+{
+	my_leaf  = leaf;
+	my_index = index;
+
+	if (my_leaf != NULL && my_index >= my_leaf->count) {
+		my_leaf  = my_leaf->next;
+		my_index = 0;
+	}
+}
+
+
+//---------------------Iterator::operator*----------------------------
+/**
+ * @brief Returns the current item.
+ *
+ * Preconditions: This Iterator is not past the end.
+ *
+ * Postconditions: The current item was returned.
+ *
+ * @return The current item.
+ */
+const Object & BPlusTree::Iterator::operator* () const
+{
+	return *my_leaf->keys [my_index];
+}
+
+
+//---------------------Iterator::operator->---------------------------
+/**
+ * @brief Returns a pointer to the current item.
+ *
+ * Preconditions: This Iterator is not past the end.
+ *
+ * Postconditions: A pointer to the current item was returned.
+ *
+ * @return A pointer to the current item.
+ */
+const Object * BPlusTree::Iterator::operator-> () const
+{
+	return my_leaf->keys [my_index];
+}
+
+
+//---------------------Iterator::operator++---------------------------
+/**
+ * @brief Moves to the next item in order.
+ *
+ * Preconditions: This Iterator is not past the end.
+ *
+ * Postconditions: This Iterator is at the next item, or past the end.
+ *
+ * @return This Iterator.
+ */
+BPlusTree::Iterator & BPlusTree::Iterator::operator++ ()
+{
+	// Step to the next leaf once this one is used up.
+	if (++my_index >= my_leaf->count) {
+		my_leaf  = my_leaf->next;
+		my_index = 0;
+	}
+	return *this;
+}
+
+
+//---------------------Iterator::operator==---------------------------
+/**
+ * @brief Compares this Iterator with the_other for equality.
+ *
+ * Preconditions: Both Iterators walk the same tree.
+ *
+ * Postconditions: Returned true if both are at the same item or both
+ *		   are past the end.
+ *
+ * @param the_other The other Iterator.
+ * @return True if equal, false otherwise.
+ */
+bool BPlusTree::Iterator::operator== (const Iterator &the_other) const
+{
+	return my_leaf == the_other.my_leaf && my_index == the_other.my_index;
+}
+
+
+//---------------------Iterator::operator!=---------------------------
+/**
+ * @brief Compares this Iterator with the_other for inequality.
+ *
+ * Preconditions: Both Iterators walk the same tree.
+ *
+ * Postconditions: Returned true if the Iterators are at different
+ *		   items.
+ *
+ * @param the_other The other Iterator.
+ * @return True if not equal, false otherwise.
+ */
+bool BPlusTree::Iterator::operator!= (const Iterator &the_other) const
+{
+	return !(*this == the_other);
+}
+
+
+//---------------------Iterator::getOccurrence------------------------
+/**
+ * @brief Returns the occurrence count of the current item.
+ *
+ * Preconditions: This Iterator is not past the end.
+ *
+ * Postconditions: The occurrence count was returned.
+ *
+ * @return The occurrence count of the current item.
+ */
+int BPlusTree::Iterator::getOccurrence () const
+{
+	return my_leaf->occurences [my_index];
+}
@@ -0,0 +1,864 @@
+/*
+ * @file bplus_tree.h
+ *
+ * @brief This class represents a B+tree, an ordered index whose
+ *	  nodes hold many keys each. Every item is stored in a leaf,
+ *	  and the leaves are linked together in order. Inner nodes
+ *	  only hold separator keys used to steer a search to the
+ *	  correct leaf. Wide nodes keep the tree shallow, so a lookup
+ *	  touches only a few nodes, and in-order scans walk the
+ *	  linked leaves sequentially.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date November 16, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ *	- Allows displaying the contents of a BPlusTree using <<.
+ * 	- Allows inserting an object into the tree.
+ *	- Allows retrieving a specified object from the tree.
+ *	- Allows removing an occurrence of an object from the tree.
+ *	- Allows making the tree empty.
+ *	- Allows walking the tree in order with an Iterator, and
+ *	  scanning a range of keys with lowerBound and upperBound.
+ *	- Allows bulk loading sorted items in linear time.
+ *	- Keeps the printed line of each item, so printing the tree
+ *	  again only formats the items inserted since.
+ *	- Keeps the key count and occurrence total of every subtree,
+ *	  so rank, select and range counts take logarithmic time.
+ * Assumptions:
+ * 	- Data objects are not NULL when stored in the tree.
+ *	- Data objects have overloaded operator<< for displaying.
+ *	- Data objects have overloaded comparison operators that
+ *	  form a strict weak ordering.
+ *	- One thread uses the tree at a time.
+ */
+//--------------------------------------------------------------------
+
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include "object.h"
+#include "ordered_index.h"
+
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class BPlusTree
+ */
+class BPlusTree : public OrderedIndex {
+
+/**
+ * @public
+ */
+public:
+
+	/**
+	 * @brief Walks the items of the tree in order along the
+	 *	  linked leaves.
+	 */
+	class Iterator;
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates an empty BPlusTree.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The BPlusTree was instantiated with a NULL
+	 *		   root.
+	 */
+	BPlusTree ();
+
+
+	//---------------------Copy-Constructor-----------------------
+	/**
+	 * @brief Copies the other tree into this tree.
+	 *
+	 * Preconditions: None.
+	 *
+ 	 * Postconditions: The other tree was copied into this tree.
+	 *
+	 * @param other The tree to copy.
+	 */
+	BPlusTree (const BPlusTree &other);
+
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Deletes all dynamically allocated objects within
+	 *	  the tree.
+	 *
+	 * Preconditions: makeEmpty is implemented.
+	 *
+	 * Postconditions: This BPlusTree is empty with a NULL root.
+	 */
+	virtual ~BPlusTree ();
+
+
+	//---------------------insert---------------------------------
+	/**
+	 * @brief Inserts an item into the tree. If an equal item is
+	 *	  already stored its occurrence count is incremented
+	 *	  and ownership of item stays with the client.
+	 *
+	 * Preconditions: The item is not NULL, and there must be
+	 * 		  enough memory for any new nodes.
+	 *
+ 	 * Postconditions: The item was inserted into the tree.
+	 *
+	 * @param item The item to insert into the tree.
+	 * @return True if successfully inserted, false otherwise.
+	 */
+	virtual bool insert (Object *item);
+
+
+	//---------------------retrieve-------------------------------
+	/**
+	 * @brief Searches the tree for the given target, if found
+	 *	  a pointer to the object is returned, NULL otherwise.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: A pointer to the object was returned if it
+	 *		   was found, NULL otherwise.
+	 *
+	 * @param target The item to search for.
+	 * @return Pointer to the object if found, NULL otherwise.
+	 */
+	virtual const Object * retrieve (const Object &target) const;
+
+
+	//---------------------remove---------------------------------
+	/**
+	 * @brief Removes one occurrence of the provided item from
+	 *	  the tree. The item stays in the tree once its count
+	 *	  reaches zero, as in BSTree.
+	 *
+	 * Preconditions: None.
+	 *
+ 	 * Postconditions: True was returned if an occurrence of the
+	 *		   item was found and removed, false otherwise.
+	 *
+	 * @param item The item to remove from the tree.
+	 * @return True if removed, false otherwise.
+	 */
+	virtual bool remove (const Object &item);
+
+
+	//---------------------makeEmpty------------------------------
+	/**
+	 * @brief Empties this tree and deletes the stored items.
+	 *
+ 	 * Preconditions: None.
+	 *
+	 * Postconditions: The tree is empty with a NULL root.
+	 */
+	virtual void makeEmpty ();
+
+
+	//---------------------clear----------------------------------
+	/**
+	 * @brief Empties this tree without deleting the stored items,
+	 *	  which are freed with the Region.
+	 *
+ 	 * Preconditions: None.
+	 *
+	 * Postconditions: The tree is empty with a NULL root.
+	 */
+	virtual void clear ();
+
+
+	//---------------------getOccurrence--------------------------
+	/**
+	 * @brief Returns the occurrence count of the item.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The occurrence count, or zero if the item is
+	 *		   not stored, was returned.
+	 *
+	 * @param item The item to get the count of.
+	 * @return Occurrence count of the item.
+	 */
+	virtual int getOccurrence (const Object &item) const;
+
+
+	//---------------------print----------------------------------
+	/**
+	 * @brief Prints the items of this tree to the output stream
+	 *	  in order, one per line, by walking the leaves. Only
+	 *	  the items not printed before are formatted.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The items have been displayed.
+	 *
+	 * @param output The output stream.
+ 	 */
+	virtual void print (ostream &output) const;
+
+
+	//---------------------build----------------------------------
+	/**
+	 * @brief Adds the provided items, with their occurrence 
+	 *	  counts, to the tree. An empty tree is bulk loaded
+	 *	  bottom up: the items are spread evenly over leaves
+	 *	  filled to FILL keys, then each level of inner nodes
+	 *	  is built over the one below it. A tree that already
+	 *	  holds items inserts them one at a time instead.
+	 * 
+	 * Preconditions: items is sorted in ascending order with no 
+	 *		  two items equal, and counts[i] is positive
+	 *		  for every items[i].
+	 * 
+	 * Postconditions: The tree took ownership of the items and
+	 *		   holds them with their counts.
+	 * 
+	 * @param items The sorted items.
+	 * @param counts The occurrence count of each item.
+	 */
+	virtual void build (const vector<Object *> &items, 
+					const vector<int> &counts);
+
+
+	//---------------------collect--------------------------------
+	/**
+	 * @brief Lists the items of the tree in ascending order,
+	 *	  with their occurrence counts, walking the leaves like
+	 *	  print.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: items and counts were appended to. The 
+	 *		   tree still owns the items.
+	 * 
+	 * @param items Filled with the items.
+	 * @param counts Filled with the occurrence count of each item.
+	 */
+	virtual void collect (vector<const Object *> &items, 
+					vector<int> &counts) const;
+
+
+	//---------------------operator(=)----------------------------
+	/**
+	 * @brief Overloaded assignment operator.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: the_other is copied into this.
+	 *
+	 * @param the_other The other tree to copy into this.
+	 * @return this is returned.
+	 */
+	const BPlusTree& operator= (const BPlusTree &the_other);
+
+
+	//---------------------begin----------------------------------
+	/**
+	 * @brief Returns an Iterator positioned at the smallest item
+	 *	  in the tree.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: An Iterator at the first item, or end() if
+	 *		   the tree is empty, was returned.
+	 *
+	 * @return An Iterator at the first item.
+	 */
+	Iterator begin () const;
+
+
+	//---------------------end------------------------------------
+	/**
+	 * @brief Returns an Iterator positioned past the last item in
+	 *	  the tree.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The past-the-end Iterator was returned.
+	 *
+	 * @return The past-the-end Iterator.
+	 */
+	Iterator end () const;
+
+
+	//---------------------lowerBound-----------------------------
+	/**
+	 * @brief Returns an Iterator positioned at the first item
+	 *	  that is not less than the provided target.
+	 *
+	 * Preconditions: target is comparable with the items stored
+	 *		  in the tree.
+	 *
+	 * Postconditions: An Iterator at the first item not less than
+	 *		   target, or end() if there is none, was
+	 *		   returned.
+	 *
+	 * @param target The low end of the range.
+	 * @return An Iterator at the first item not less than target.
+	 */
+	Iterator lowerBound (const Object &target) const;
+
+
+	//---------------------upperBound-----------------------------
+	/**
+	 * @brief Returns an Iterator positioned at the first item
+	 *	  that is greater than the provided target.
+	 *
+	 * Preconditions: target is comparable with the items stored
+	 *		  in the tree.
+	 *
+	 * Postconditions: An Iterator at the first item greater than
+	 *		   target, or end() if there is none, was
+	 *		   returned.
+	 *
+	 * @param target The high end of the range.
+	 * @return An Iterator at the first item greater than target.
+	 */
+	Iterator upperBound (const Object &target) const;
+
+
+	//---------------------getSize--------------------------------
+	/**
+	 * @brief Returns the number of items stored in the tree. An
+	 *	  item whose count was removed down to zero is still
+	 *	  stored.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number of items was returned.
+	 *
+	 * @return The number of items.
+	 */
+	int getSize () const;
+
+
+	//---------------------getTotal-------------------------------
+	/**
+	 * @brief Returns the sum of the occurrence counts of the items
+	 *	  stored in the tree.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The sum of the counts was returned.
+	 *
+	 * @return The sum of the occurrence counts.
+	 */
+	int getTotal () const;
+
+
+	//---------------------rank-----------------------------------
+	/**
+	 * @brief Returns the number of items less than the provided 
+	 *	  target, which is the index target has, or would have,
+	 *	  in order.
+	 *
+	 * Preconditions: target is comparable with the items stored
+	 *		  in the tree.
+	 *
+	 * Postconditions: The number of items less than target was
+	 *		   returned.
+	 *
+	 * @param target The item to rank.
+	 * @return The number of items less than target.
+	 */
+	int rank (const Object &target) const;
+
+
+	//---------------------select---------------------------------
+	/**
+	 * @brief Returns the item at the provided index in order, 
+	 *	  counting from zero.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: A pointer to the item was returned, or NULL
+	 *		   if index is not less than getSize().
+	 *
+	 * @param index The index of the item.
+	 * @return Pointer to the item, or NULL.
+	 */
+	const Object * select (int index) const;
+
+
+	//---------------------count----------------------------------
+	/**
+	 * @brief Returns the number of items that are not less than
+	 *	  low and not greater than high.
+	 *
+	 * Preconditions: low and high are comparable with the items
+	 *		  stored in the tree.
+	 *
+	 * Postconditions: The number of items in the range, or zero if
+	 *		   high is less than low, was returned.
+	 *
+	 * @param low The low end of the range.
+	 * @param high The high end of the range.
+	 * @return The number of items in the range.
+	 */
+	int count (const Object &low, const Object &high) const;
+
+
+	//---------------------countOccurrences-----------------------
+	/**
+	 * @brief Returns the sum of the occurrence counts of the items
+	 *	  that are not less than low and not greater than high.
+	 *
+	 * Preconditions: low and high are comparable with the items
+	 *		  stored in the tree.
+	 *
+	 * Postconditions: The sum of the counts in the range, or zero
+	 *		   if high is less than low, was returned.
+	 *
+	 * @param low The low end of the range.
+	 * @param high The high end of the range.
+	 * @return The sum of the occurrence counts in the range.
+	 */
+	int countOccurrences (const Object &low, const Object &high) const;
+
+/**
+ * @private
+ */
+private:
+
+	/**
+	 * @brief The most keys a node holds. A node may briefly hold
+	 *	  one more while it is being split.
+	 */
+	const static int ORDER = 32;
+
+	/**
+	 * @brief The keys per node when bulk loading, which leaves 
+	 *	  room for later inserts before a node splits.
+	 */
+	const static int FILL = 24;
+
+	/**
+	 * @brief The part shared by leaf and inner nodes.
+	 */
+	struct Node {
+		bool    leaf;			// True for a leaf.
+		int     count;			// Keys in use.
+		int     size;			// Items in the subtree.
+		int     total;			// Occurrences in the subtree.
+		Object *keys [ORDER + 1];	// Sorted keys.
+	};
+
+	/**
+	 * @brief A leaf node, which owns its keys.
+	 */
+	struct Leaf : public Node {
+		int   occurences [ORDER + 1];	// Count of each key.
+		Leaf *next;			// Leaf to the right.
+		int   lengths [ORDER + 1];	// Printed line of each key,
+						// or -1 if not printed yet.
+		string lines;			// Printed lines, in order.
+		bool  stale;			// True if a key's line is
+						// not in lines.
+	};
+
+	/**
+	 * @brief An inner node. Its keys point at items owned by
+	 *	  leaves. children[i] holds the keys that are not less
+	 *	  than keys[i - 1] and less than keys[i].
+	 */
+	struct Inner : public Node {
+		Node *children [ORDER + 2];	// Subtrees.
+	};
+
+	/**
+	 * @brief The root of this tree.
+	 */
+	Node *my_root;
+
+	/**
+	 * @brief The leftmost leaf, where in-order walks start.
+	 */
+	Leaf *my_first;
+
+
+	//---------------------init-----------------------------------
+	/**
+	 * @brief Sets up an empty tree. Shared by the constructors.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The tree is empty.
+	 */
+	void init ();
+
+
+	//---------------------newLeaf--------------------------------
+	/**
+	 * @brief Allocates an empty leaf.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: A pointer to the new leaf was returned.
+	 *
+	 * @return The new leaf.
+	 */
+	Leaf * newLeaf () const;
+
+
+	//---------------------render---------------------------------
+	/**
+	 * @brief Formats the lines of the keys of the leaf that are
+	 *	  not printed yet, and splices them into its lines.
+	 *
+	 * Preconditions: The leaf is stale.
+	 *
+	 * Postconditions: The leaf's lines hold every key's line.
+	 *
+	 * @param leaf The leaf.
+	 */
+	void render (Leaf *leaf) const;
+
+
+	//---------------------newInner-------------------------------
+	/**
+	 * @brief Allocates an empty inner node.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: A pointer to the new inner node was 
+	 *		   returned.
+	 *
+	 * @return The new inner node.
+	 */
+	Inner * newInner () const;
+
+
+	//---------------------insertOccurrences----------------------
+	/**
+	 * @brief Inserts an item with the provided number of
+	 *	  occurrences, growing a new root if the old one split.
+	 *
+	 * Preconditions: The item is not NULL and count is positive.
+	 *
+	 * Postconditions: The item was inserted, or its count was
+	 *		   raised by count if already stored.
+	 *
+	 * @param item The item to insert.
+	 * @param count The occurrences to add.
+	 * @return True if successfully inserted, false otherwise.
+	 */
+	bool insertOccurrences (Object *item, int count);
+
+
+	//---------------------insertHelper---------------------------
+	/**
+	 * @brief A helper method for recursively inserting an item
+	 *	  into the provided subtree. If the subtree root
+	 *	  overflows it is split in two, and the new right
+	 *	  sibling and its separator are handed back to the
+	 *	  caller.
+	 *
+	 * Preconditions: root is not NULL.
+	 *
+	 * Postconditions: The item was inserted, and the size and 
+	 *		   total of root and up_node are up to date. 
+	 *		   up_node is the new right sibling of root if
+	 *		   it split, NULL otherwise.
+	 *
+	 * @param root The root of the subtree.
+	 * @param item The item being inserted.
+	 * @param count The occurrences to add.
+	 * @param up_key The separator for up_node.
+	 * @param up_node The new right sibling of root, or NULL.
+	 * @return True if the item was new to the subtree, false if 
+	 *	   only its count was raised.
+	 */
+	bool insertHelper (Node *root, Object *item, int count,
+				Object *&up_key, Node *&up_node);
+
+
+	//---------------------growRoot-------------------------------
+	/**
+	 * @brief Grows the tree one level after the root split.
+	 *
+	 * Preconditions: up_node is the new right sibling of the 
+	 *		  root.
+	 *
+	 * Postconditions: A new root over the old root and up_node
+	 *		   was installed.
+	 *
+	 * @param up_key The separator for up_node.
+	 * @param up_node The new right sibling of the root.
+	 */
+	void growRoot (Object *up_key, Node *up_node);
+
+
+	//---------------------sum------------------------------------
+	/**
+	 * @brief Sets the size and total of the provided node from its
+	 *	  keys, or from its children if it is an inner node.
+	 *
+	 * Preconditions: node is not NULL, and the size and total of
+	 *		  its children are up to date.
+	 *
+	 * Postconditions: The size and total of node are up to date.
+	 *
+	 * @param node The node to sum.
+	 */
+	void sum (Node *node) const;
+
+
+	//---------------------countBelow-----------------------------
+	/**
+	 * @brief Counts the items less than the provided target, or
+	 *	  not greater than it if inclusive, adding up the sizes
+	 *	  and totals of the subtrees left of the search path.
+	 *
+	 * Preconditions: target is comparable with the items stored
+	 *		  in the tree.
+	 *
+	 * Postconditions: items and occurrences were set.
+	 *
+	 * @param target The item to count below.
+	 * @param inclusive True to also count an item equal to target.
+	 * @param items Set to the number of items.
+	 * @param occurrences Set to the sum of their counts.
+	 */
+	void countBelow (const Object &target, bool inclusive,
+				int &items, int &occurrences) const;
+
+
+	//---------------------lowerIndex-----------------------------
+	/**
+	 * @brief Binary searches a node for the first key that is
+	 *	  not less than the provided target.
+	 *
+	 * Preconditions: node is not NULL.
+	 *
+	 * Postconditions: The index of that key, or the key count if
+	 *		   there is none, was returned.
+	 *
+	 * @param node The node to search.
+	 * @param target The item being searched for.
+	 * @return The index of the first key not less than target.
+	 */
+	int lowerIndex (const Node *node, const Object &target) const;
+
+
+	//---------------------upperIndex-----------------------------
+	/**
+	 * @brief Binary searches a node for the first key that is
+	 *	  greater than the provided target.
+	 *
+	 * Preconditions: node is not NULL.
+	 *
+	 * Postconditions: The index of that key, or the key count if
+	 *		   there is none, was returned.
+	 *
+	 * @param node The node to search.
+	 * @param target The item being searched for.
+	 * @return The index of the first key greater than target.
+	 */
+	int upperIndex (const Node *node, const Object &target) const;
+
+
+	//---------------------findLeaf-------------------------------
+	/**
+	 * @brief Returns the leaf the provided target belongs in.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The leaf covering target was returned, or
+	 *		   NULL if the tree is empty.
+	 *
+	 * @param target The item being searched for.
+	 * @return The leaf covering target, or NULL.
+	 */
+	Leaf * findLeaf (const Object &target) const;
+
+
+	//---------------------find-----------------------------------
+	/**
+	 * @brief Finds the leaf slot holding the provided item.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The leaf holding the item was returned and
+	 *		   index was set to its slot, or NULL was 
+	 *		   returned if it is not stored.
+	 *
+	 * @param item The item being searched for.
+	 * @param index Set to the slot of the item in the leaf.
+	 * @return The leaf holding the item, or NULL.
+	 */
+	Leaf * find (const Object &item, int &index) const;
+
+
+	//---------------------makeEmptyHelper------------------------
+	/**
+	 * @brief Recursively deletes the provided subtree, and the
+	 *	  items owned by its leaves if asked.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The subtree was deleted.
+	 *
+	 * @param root The root of the subtree.
+	 * @param items True to delete the items, false to leave them.
+	 */
+	void makeEmptyHelper (Node *root, bool items);
+};
+
+
+/**
+ * @class BPlusTree::Iterator
+ *
+ * @brief Walks the items of a BPlusTree in order by stepping
+ *	  through each leaf and following its link to the next.
+ *	  Inserting into the tree invalidates its Iterators.
+ */
+class BPlusTree::Iterator {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a past-the-end Iterator.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This Iterator is equal to BPlusTree::end().
+	 */
+	Iterator ();
+
+
+	//---------------------operator*------------------------------
+	/**
+	 * @brief Returns the current item.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: The current item was returned.
+	 *
+	 * @return The current item.
+	 */
+	const Object & operator* () const;
+
+
+	//---------------------operator->-----------------------------
+	/**
+	 * @brief Returns a pointer to the current item.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: A pointer to the current item was returned.
+	 *
+	 * @return A pointer to the current item.
+	 */
+	const Object * operator-> () const;
+
+
+	//---------------------operator++-----------------------------
+	/**
+	 * @brief Moves to the next item in order.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: This Iterator is at the next item, or past
+	 *		   the end.
+	 *
+	 * @return This Iterator.
+	 */
+	Iterator & operator++ ();
+
+
+	//---------------------operator==-----------------------------
+	/**
+	 * @brief Compares this Iterator with the_other for equality.
+	 *
+	 * Preconditions: Both Iterators walk the same tree.
+	 *
+	 * Postconditions: Returned true if both are at the same item
+	 *		   or both are past the end.
+	 *
+	 * @param the_other The other Iterator.
+	 * @return True if equal, false otherwise.
+	 */
+	bool operator== (const Iterator &the_other) const;
+
+
+	//---------------------operator!=-----------------------------
+	/**
+	 * @brief Compares this Iterator with the_other for
+	 *	  inequality.
+	 *
+	 * Preconditions: Both Iterators walk the same tree.
+	 *
+	 * Postconditions: Returned true if the Iterators are at
+	 *		   different items.
+	 *
+	 * @param the_other The other Iterator.
+	 * @return True if not equal, false otherwise.
+	 */
+	bool operator!= (const Iterator &the_other) const;
+
+
+	//---------------------getOccurrence--------------------------
+	/**
+	 * @brief Returns the occurrence count of the current item.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: The occurrence count was returned.
+	 *
+	 * @return The occurrence count of the current item.
+	 */
+	int getOccurrence () const;
+
+/**
+ * @private
+ */
+private:
+
+	friend class BPlusTree;
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates an Iterator at the provided leaf slot. A
+	 *	  slot past the end of the leaf moves on to the next
+	 *	  leaf.
+	 *
+	 * Preconditions: index is at most the key count of leaf.
+	 *
+	 * Postconditions: This Iterator is at the first item at or
+	 *		   after the slot.
+	 *
+	 * @param leaf The leaf.
+	 * @param index The slot within the leaf.
+	 */
+	Iterator (const Leaf *leaf, int index);
+
+	/**
+	 * @brief The current leaf, or NULL past the end.
+	 */
+	const Leaf *my_leaf;
+
+	/**
+	 * @brief The current slot within my_leaf.
+	 */
+	int my_index;
+};
+#endif /* BPLUS_TREE_H */
@@ -23,6 +23,14 @@
  *	- Allows retrieving a specified object from the tree.
  *	- Allows removing an object from the tree.
  *	- Allows making the tree empty.
+ *	- Allows keeping the tree balanced as a left-leaning 
+ *	  red-black tree, so its depth stays O(log n) regardless
+ *	  of the order items are inserted.
+ *	- Allows walking the tree in order with an Iterator, and
+ *	  scanning a range of keys with lowerBound and upperBound.
+ *	- Nodes are carved out of contiguous slabs and recycled 
+ *	  through a free list, so emptying the tree releases whole
+ *	  slabs instead of freeing one node at a time.
  * Assumptions:
  * 	- Data objects are not NULL when stored in the tree.
  *	- Data objects have overloaded operator<< for displaying.
@@ -45,7 +53,26 @@
  */
 BSTree::BSTree () 
 {
-	my_root = NULL;
+	init (false);
+}
+
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a BSTree with a NULL root that is kept balanced if
+ *	  requested.
+ * 
+ * Preconditions: None.
+ *
+ * Postconditions: The BSTree was instantiated with its root set to 
+ *		   NULL. If balanced is true every insert rebalances
+ *		   the tree as a left-leaning red-black tree.
+ *
+ * @param balanced True to keep the tree balanced.
+ */
+BSTree::BSTree (bool balanced) 
+{
+	init (balanced);
 }
 
 
@@ -60,7 +87,7 @@ BSTree::BSTree ()
  */ 
 BSTree::BSTree (const BSTree &the_other)	
 {	
-	my_root = NULL;
+	init (the_other.my_balanced);
 	*this = the_other;
 }
 
@@ -79,6 +106,25 @@ BSTree::~BSTree()
 }
 
 
+//---------------------init-------------------------------------------
+/**
+ * @brief Sets up an empty tree. Shared by the constructors.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: The tree is empty.
+ * 
+ * @param balanced True to keep the tree balanced.
+ */
+void BSTree::init (bool balanced)
+{
+	my_root      = NULL;
+	my_balanced  = balanced;
+	my_slab_used = 0;
+	my_free_list = NULL;
+}
+
+
 
 //---------------------retrieve---------------------------------------
 /**
@@ -118,11 +164,13 @@ const Object * BSTree::retrieveHelper (const Node *root,
 					const Object &the_item) const  
 {
 	if (root == NULL) return NULL;
+
+	int result = the_item.compareTo (*root->item);
 	
-	else if (the_item == *root->item)	
+	if (result == 0)	
 		return root->item;
 	
-	else if (the_item < *root->item)
+	else if (result < 0)
 		return retrieveHelper (root->left, the_item);
 	
 	else 
@@ -144,14 +192,18 @@ const Object * BSTree::retrieveHelper (const Node *root,
  */
 bool BSTree::insert (Object *the_item)
 {
-	return insertHelper (my_root, the_item);
+	bool result = insertHelper (my_root, the_item);
+
+	// The root of a red-black tree is always black.
+	if (my_balanced) my_root->red = false;
+	return result;
 }
 
 
 //---------------------insertHelper-----------------------------------
 /**
  * @brief A helper method for recursively inserting an item into the 
- *	  tree. If the imem already exists in the tree the occurance
+ *	  tree. If the imem already exists in the tree the occurrence
  *	  will will incremented. 
  *
  * Preconditions: item is not NULL, and  my_root points to the root of
@@ -166,34 +218,45 @@ bool BSTree::insert (Object *the_item)
  */
 bool BSTree::insertHelper (Node *&the_root, Object *the_item)	
 {
+	bool result;
+	int  compare;
+
 	if (the_root == NULL) {
-		the_root        = new Node;
+		the_root        = allocNode ();
 		// We're taking ownership of the Object.	
 		the_root->item  = the_item;
 		the_root->left  = NULL;
 		the_root->right = NULL;
 		the_root->occurences = 1;
+		// New nodes join their parent with a red link.
+		the_root->red   = my_balanced;
 		return true;
 	}	
 
-	else if (*the_root->item == *the_item) {
+	compare = the_item->compareTo (*the_root->item);
+
+	if (compare == 0) {
 		// Ownership of Object goes back to client.
 		the_root->occurences++;
 		return true;	
 	} 
 	
-	else if (*the_item < *the_root->item)  
-		return insertHelper(the_root->left, the_item); 
+	else if (compare < 0)  
+		result = insertHelper(the_root->left, the_item); 
 
 	 else  
-		return insertHelper(the_root->right, the_item);
+		result = insertHelper(the_root->right, the_item);
+
+	// Rebalance on the way back up.
+	if (my_balanced) fixUp (the_root);
+	return result;
 }
 
 
 //---------------------remove-----------------------------------------
 /**
- * @brief Removes one occurance of the provided item from the tree. 
- *	  If it is the last occurance, the objet is removed. Calls a 
+ * @brief Removes one occurrence of the provided item from the tree. 
+ *	  If it is the last occurrence, the objet is removed. Calls a 
  *	  helper recursive method.
  *
  * Preconditions: item is a reference to a non NULL object.
@@ -212,8 +275,8 @@ bool BSTree::remove (const Object &the_item)
 
 //---------------------removeHelper-----------------------------------
 /**
- * @brief Removes an occurance of the provided item from the tree. 
- *	  If it is its last occurance the Object it is removed.
+ * @brief Removes an occurrence of the provided item from the tree. 
+ *	  If it is its last occurrence the Object it is removed.
  * 
  * Preconditions: item is a reference to a non-NULL Object.
  *	
@@ -228,8 +291,10 @@ bool BSTree::removeHelper (Node *&root, const Object &the_item)
 {
 	if (root == NULL) return false;
 
-	else if (the_item == *root->item) {
-		// More than one occurance, so decrment one.
+	int result = the_item.compareTo (*root->item);
+
+	if (result == 0) {
+		// More than one occurrence, so decrement one.
 		if (root->occurences > 0)  {
 			root->occurences--;
 			return true;
@@ -237,17 +302,17 @@ bool BSTree::removeHelper (Node *&root, const Object &the_item)
 //		if (root->occurences > 1) 
 //			root->occurences--;
 			
-		// Otherwise, there's one occurance, so delete it.
+		// Otherwise, there's one occurrence, so delete it.
 		else { 
 			return false;
 		}
 //			deleteRoot (root);
 
-		// We decremented the occurance or deleted the node.	
+		// We decremented the occurrence or deleted the node.	
 		return true; 
 	}
 
-	else if (the_item < *root->item) 
+	else if (result < 0) 
 		return removeHelper (root->left, the_item);
 	else 
 		return removeHelper (root->right, the_item);	
@@ -272,7 +337,7 @@ void BSTree::deleteRoot (Node *&root)
 	// Only node in the tree, or a leaf, so delete it.
 	if (root->left == NULL && root->right == NULL) {
 		delete root->item;
-		delete root;
+		freeNode (root);
 		root = NULL;	
 	}
 
@@ -280,14 +345,14 @@ void BSTree::deleteRoot (Node *&root)
 		Node *temp = root;
 		root = root->right;
 		delete temp->item;
-		delete temp; 
+		freeNode (temp); 
 	}
 
 	else if (root->right == NULL) {
 		Node *temp = root;
 		root = root->left;
 		delete temp->item;
-		delete temp;
+		freeNode (temp);
 	}
 
 	// We have a subtree on both sides, delete the root's item.
@@ -309,7 +374,7 @@ void BSTree::deleteRoot (Node *&root)
  * 
  * Postconditions: A pointer to the Object item of the most left node
  *		   is returned. That node that previously stored item 
- *		   is then deleted. The occurance cound is also 
+ *		   is then deleted. The occurrence cound is also 
  *		   handled.
  *
  * @param root The root of the subtree.
@@ -328,7 +393,7 @@ Object * BSTree::findAndDeleteMostLeft (Node *&root, Node *m_root)
 		Node *temp     = root; 
 		// Move the root pointer to the right child.
 		root           = root->right;
-		delete temp;
+		freeNode (temp);
 		return result;
 	}
 
@@ -348,34 +413,120 @@ Object * BSTree::findAndDeleteMostLeft (Node *&root, Node *m_root)
  */
 void BSTree::makeEmpty ()	
 {
-	makeEmptyHelper (my_root);
+	releaseSlabs (true);
+}
+
+
+//---------------------clear------------------------------------------
+/**
+ * @brief Empties this tree without deleting the stored items, which 
+ *	  are freed with the Region. Only the slabs are released.
+ * 	
+ * Preconditions: None.
+ *
+ * Postconditions: The tree is empty.
+ */
+void BSTree::clear ()
+{
+	releaseSlabs (false);
 }
 
 
-//---------------------makeEmptyHelper--------------------------------
+//---------------------allocNode--------------------------------------
 /**
- * @brief Recursively empties the provided subtree.
+ * @brief Returns an unused node, taken from the free list if possible
+ *	  and otherwise from the newest slab. A new slab, twice the 
+ *	  size of the last one, is allocated when the newest slab is
+ *	  used up.
  * 
- * Preconditions: root points to the first node in the tree, or NULL 
- *		  if the tree is empty.
+ * Preconditions: There is enough memory for a new slab if one is 
+ *		  needed.
  * 
- * Postconditions: The provided tree is empty with a NULL root.
+ * Postconditions: A pointer to an unused node was returned.
  * 
- * @param root The root of the subtree.
+ * @return A pointer to an unused node.
  */
-void BSTree::makeEmptyHelper (Node *&root) 
+BSTree::Node * BSTree::allocNode ()
 {
-	if (root != NULL) {
-		makeEmptyHelper (root->left);
-		makeEmptyHelper (root->right);
-		delete root->item;
-		root->item = NULL;
-		delete root; 
-	}	
-	root = NULL;
+	// Reuse a released node first.
+	if (my_free_list != NULL) {
+		Node *node   = my_free_list;
+		my_free_list = node->left;
+		return node;
+	}
+
+	// Start a new slab if the newest one is used up.
+	if (my_slabs.empty () || my_slab_used == my_slabs.back ().size) {
+		Slab slab;
+		slab.size = MIN_SLAB_SIZE;
+		if (!my_slabs.empty ()) 
+			slab.size = my_slabs.back ().size * 2;
+		if (slab.size > MAX_SLAB_SIZE) 
+			slab.size = MAX_SLAB_SIZE;
+		slab.nodes = new Node [slab.size];
+		my_slabs.push_back (slab);
+		my_slab_used = 0;
+	}
+	return &my_slabs.back ().nodes [my_slab_used++];
 }
 
 
+//---------------------freeNode---------------------------------------
+/**
+ * @brief Returns the provided node to the free list.
+ * 
+ * Preconditions: The node came from allocNode and its item has 
+ *		  already been released.
+ * 
+ * Postconditions: The node is on the free list.
+ * 
+ * @param node The node to release.
+ */
+void BSTree::freeNode (Node *node)
+{
+	// A NULL item marks the node as unused for releaseSlabs.
+	node->item   = NULL;
+	node->left   = my_free_list;
+	node->right  = NULL;
+	my_free_list = node;
+}
+
+
+//---------------------releaseSlabs-----------------------------------
+/**
+ * @brief Deletes the item of every node in use, then releases all 
+ *	  slabs at once. The slabs are walked in memory order rather
+ *	  than through the tree.
+ * 
+ * Preconditions: Nodes on the free list have a NULL item.
+ * 
+ * Postconditions: The slabs, and the items if asked, were released 
+ *		   and the tree is empty with a NULL root.
+ *
+ * @param items True to delete the items, false to leave them.
+ */
+void BSTree::releaseSlabs (bool items)
+{
+	int slab, index, used;
+
+	for (slab = 0; slab < (int)my_slabs.size (); slab++) {
+		// Only the newest slab can be partly handed out.
+		used = my_slabs [slab].size;
+		if (slab == (int)my_slabs.size () - 1) 
+			used = my_slab_used;
+
+		for (index = 0; items && index < used; index++) 
+			delete my_slabs [slab].nodes [index].item;
+
+		delete [] my_slabs [slab].nodes;
+	}
+	my_slabs.clear ();
+	my_slab_used = 0;
+	my_free_list = NULL;
+	my_root      = NULL;
+}
+	
+
 //---------------------operator(=)------------------------------------
 /**
  * @brief Overloaded assignment operator.	
@@ -394,7 +545,8 @@ const BSTree& BSTree::operator=  (const BSTree &the_other)
 	if (this != &the_other) {
 		// Delete our current memory.
 		makeEmpty();
-		// Now copy the other's tree.
+		// Now copy the other's tree and its balancing mode.
+		my_balanced = the_other.my_balanced;
 		clone (my_root, the_other.my_root);		
 	}
 	return *this;
@@ -422,12 +574,13 @@ void BSTree::clone (Node *&copy, const Node *originalTree)
 	
 	else { 
 		// Our new Node.
-		copy = new Node; 
+		copy = allocNode (); 
 		// Link the data into our new Node.
 		//copy->item       = new Object (*originalTree->item); 
 		// Clone the object.
 		copy->item = originalTree->item->clone();
 		copy->occurences = originalTree->occurences;
+		copy->red        = originalTree->red;
 		// Now clone left and right subtrees.	
 		clone(copy->left,  originalTree->left);	
 		clone(copy->right, originalTree->right); 
@@ -451,40 +604,62 @@ void BSTree::clone (Node *&copy, const Node *originalTree)
  */
 ostream& operator<< (ostream &output, const BSTree &the_other) 
 {
-	the_other.printHelper(output, the_other.my_root);	
+	the_other.print (output);
 	return output;
 }
 
 
-//---------------------printHelper------------------------------------
-/**
- * A helper method that recursively prints the given tree in order.
+//---------------------print------------------------------------------
+/** 
+ * @brief Prints the items of this tree to the output stream in order,
+ *	  one per line.
  * 
- * Preconditions: root is not NULL.
+ * Preconditions: None.
+ *
+ * Postconditions: The items have been displayed.
  *
- * Postconditions: The tree is sent to the output. 
+ * @param output The output stream. 
+ */
+void BSTree::print (ostream &output) const
+{
+	Iterator it;
+	for (it = begin (); it != end (); ++it)
+		output << *it << endl;
+}
+
+
+//---------------------collect----------------------------------------
+/** 
+ * @brief Lists the items of this tree in order, with their occurrence
+ *	  counts.
  * 
- * @param output The output stream to to send the data.
- * @param root The root of the subtree.
+ * Preconditions: None.
+ *
+ * Postconditions: items and counts were appended to. The tree still 
+ *		   owns the items.
+ *
+ * @param items Filled with the items.
+ * @param counts Filled with the occurrence count of each item.
  */
-void BSTree::printHelper (ostream &output, const Node *root) const
+void BSTree::collect (vector<const Object *> &items, 
+					vector<int> &counts) const
 {
-	if (root != NULL) {
-		printHelper (output, root->left);
-		output << *root->item << endl;
-		printHelper (output, root->right);
+	Iterator it;
+	for (it = begin (); it != end (); ++it) {
+		items.push_back (&*it);
+		counts.push_back (it.getOccurrence ());
 	}
 }
 
 
 //---------------------getOccurrence----------------------------------
-/* @brief Returns the occurence of the item.
+/* @brief Returns the occurrence of the item.
  * 
  * Preconditions: item is not NULL.
  * 
  * Postconditions: occurrnce was returned. 
  * 
- * @return occurence count of the item.
+ * @return occurrence count of the item.
  */
 int BSTree::getOccurrence (const Object &item) const
 {
@@ -506,14 +681,382 @@ int BSTree::getOccurrence (const Object &item) const
 int BSTree::occurrenceHelper (const Object &item, const Node *root) const
 {
 	if (root == NULL) return 0;
+
+	int result = item.compareTo (*root->item);
 	
-	else if (item == *root->item)	
+	if (result == 0)	
 		return root->occurences;
 	
-	else if (item < *root->item)
+	else if (result < 0)
 		return occurrenceHelper (item, root->left);
 	
 	else 
 		return occurrenceHelper (item, root->right);
 }
 
+
+//---------------------isBalanced-------------------------------------
+/**
+ * @brief Returns whether this tree keeps itself balanced.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: The balancing mode was returned.
+ * 
+ * @return True if this is a red-black tree, false otherwise.
+ */
+bool BSTree::isBalanced () const
+{
+	return my_balanced;
+}
+
+
+//---------------------isRed------------------------------------------
+/**
+ * @brief Returns whether the link to the provided node is red. NULL 
+ *	  links are black.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: The color of the node was returned.
+ * 
+ * @param root The node to check.
+ * @return True if the node is red, false otherwise.
+ */
+bool BSTree::isRed (const Node *root) const
+{
+	return root != NULL && root->red;
+}
+
+
+//---------------------rotateLeft-------------------------------------
+/**
+ * @brief Rotates the right-leaning red link of the provided subtree 
+ *	  to lean left.
+ * 
+ * Preconditions: root and its right child are not NULL.
+ * 
+ * Postconditions: root points to the old right child, which now has 
+ *		   the old root as its left child.
+ * 
+ * @param root The root of the subtree.
+ */
+void BSTree::rotateLeft (Node *&root)
+{
+	Node *temp  = root->right;
+	root->right = temp->left;
+	temp->left  = root;
+	temp->red   = root->red;
+	root->red   = true;
+	root        = temp;
+}
+
+
+//---------------------rotateRight------------------------------------
+/**
+ * @brief Rotates the left-leaning red link of the provided subtree to
+ *	  lean right.
+ * 
+ * Preconditions: root and its left child are not NULL.
+ * 
+ * Postconditions: root points to the old left child, which now has 
+ *		   the old root as its right child.
+ * 
+ * @param root The root of the subtree.
+ */
+void BSTree::rotateRight (Node *&root)
+{
+	Node *temp  = root->left;
+	root->left  = temp->right;
+	temp->right = root;
+	temp->red   = root->red;
+	root->red   = true;
+	root        = temp;
+}
+
+
+//---------------------flipColors-------------------------------------
+/**
+ * @brief Splits a temporary 4-node by flipping the colors of the 
+ *	  provided node and its children.
+ * 
+ * Preconditions: root and both of its children are not NULL.
+ * 
+ * Postconditions: The colors of root and its children were flipped.
+ * 
+ * @param root The root of the subtree.
+ */
+void BSTree::flipColors (Node *root)
+{
+	root->red        = !root->red;
+	root->left->red  = !root->left->red;
+	root->right->red = !root->right->red;
+}
+
+
+//---------------------fixUp------------------------------------------
+/**
+ * @brief Restores the left-leaning red-black invariants at the 
+ *	  provided subtree on the way back up an insert.
+ * 
+ * Preconditions: root is not NULL and its subtrees are valid 
+ *		  left-leaning red-black trees.
+ * 
+ * Postconditions: No right-leaning red links or consecutive red links
+ *		   remain at root.
+ * 
+ * @param root The root of the subtree.
+ */
+void BSTree::fixUp (Node *&root)
+{
+	if (isRed (root->right) && !isRed (root->left)) 
+		rotateLeft (root);
+
+	if (isRed (root->left) && isRed (root->left->left)) 
+		rotateRight (root);
+
+	if (isRed (root->left) && isRed (root->right)) 
+		flipColors (root);
+}
+
+
+//---------------------begin------------------------------------------
+/**
+ * @brief Returns an Iterator positioned at the smallest item in the 
+ *	  tree.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: An Iterator at the first item, or end() if the tree
+ *		   is empty, was returned.
+ * 
+ * @return An Iterator at the first item.
+ */
+BSTree::Iterator BSTree::begin () const
+{
+	Iterator it;
+	it.pushLeft (my_root);
+	return it;
+}
+
+
+//---------------------end--------------------------------------------
+/**
+ * @brief Returns an Iterator positioned past the last item in the 
+ *	  tree.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: The past-the-end Iterator was returned.
+ * 
+ * @return The past-the-end Iterator.
+ */
+BSTree::Iterator BSTree::end () const
+{
+	return Iterator ();
+}
+
+
+//---------------------lowerBound-------------------------------------
+/**
+ * @brief Returns an Iterator positioned at the first item that is not
+ *	  less than the provided target.
+ * 
+ * Preconditions: target is comparable with the items stored in the 
+ *		  tree.
+ * 
+ * Postconditions: An Iterator at the first item not less than target,
+ *		   or end() if there is none, was returned.
+ * 
+ * @param target The low end of the range.
+ * @return An Iterator at the first item not less than target.
+ */
+BSTree::Iterator BSTree::lowerBound (const Object &target) const
+{
+	Iterator it;
+	const Node *root = my_root;
+
+	// Only nodes we pass on their left side are still to come.
+	while (root != NULL) {
+		if (root->item->compareTo (target) < 0) 
+			root = root->right;
+		else {
+			it.my_path.push_back (root);
+			root = root->left;
+		}
+	}
+	return it;
+}
+
+
+//---------------------upperBound-------------------------------------
+/**
+ * @brief Returns an Iterator positioned at the first item that is 
+ *	  greater than the provided target.
+ * 
+ * Preconditions: target is comparable with the items stored in the 
+ *		  tree.
+ * 
+ * Postconditions: An Iterator at the first item greater than target, 
+ *		   or end() if there is none, was returned.
+ * 
+ * @param target The high end of the range.
+ * @return An Iterator at the first item greater than target.
+ */
+BSTree::Iterator BSTree::upperBound (const Object &target) const
+{
+	Iterator it;
+	const Node *root = my_root;
+
+	// Only nodes we pass on their left side are still to come.
+	while (root != NULL) {
+		if (target.compareTo (*root->item) < 0) {
+			it.my_path.push_back (root);
+			root = root->left;
+		}
+		else 
+			root = root->right;
+	}
+	return it;
+}
+
+
+//---------------------Iterator::Constructor--------------------------
+/**
+ * @brief Creates a past-the-end Iterator.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: This Iterator is equal to BSTree::end().
+ */
+BSTree::Iterator::Iterator () {}
+
+
+//---------------------Iterator::operator*----------------------------
+/**
+ * @brief Returns the current item.
+ * 
+ * Preconditions: This Iterator is not past the end.
+ * 
+ * Postconditions: The current item was returned.
+ * 
+ * @return The current item.
+ */
+const Object & BSTree::Iterator::operator* () const
+{
+	return *my_path.back ()->item;
+}
+
+
+//---------------------Iterator::operator->---------------------------
+/**
+ * @brief Returns a pointer to the current item.
+ * 
+ * Preconditions: This Iterator is not past the end.
+ * 
+ * Postconditions: A pointer to the current item was returned.
+ * 
+ * @return A pointer to the current item.
+ */
+const Object * BSTree::Iterator::operator-> () const
+{
+	return my_path.back ()->item;
+}
+
+
+//---------------------Iterator::operator++---------------------------
+/**
+ * @brief Moves to the next item in order.
+ * 
+ * Preconditions: This Iterator is not past the end.
+ * 
+ * Postconditions: This Iterator is at the in-order successor of the 
+ *		   previous item, or past the end.
+ * 
+ * @return This Iterator.
+ */
+BSTree::Iterator & BSTree::Iterator::operator++ ()
+{
+	const Node *current = my_path.back ();
+	my_path.pop_back ();
+	// The successor is the smallest node of the right subtree,
+	// or else the nearest ancestor still on the path.
+	pushLeft (current->right);
+	return *this;
+}
+
+
+//---------------------Iterator::operator==---------------------------
+/**
+ * @brief Compares this Iterator with the_other for equality.
+ * 
+ * Preconditions: Both Iterators walk the same tree.
+ * 
+ * Postconditions: Returned true if both are at the same item or both
+ *		   are past the end.
+ * 
+ * @param the_other The other Iterator.
+ * @return True if equal, false otherwise.
+ */
+bool BSTree::Iterator::operator== (const Iterator &the_other) const
+{
+	if (my_path.empty () || the_other.my_path.empty ())
+		return my_path.empty () && the_other.my_path.empty ();
+
+	return my_path.back () == the_other.my_path.back ();
+}
+
+
+//---------------------Iterator::operator!=---------------------------
+/**
+ * @brief Compares this Iterator with the_other for inequality.
+ * 
+ * Preconditions: Both Iterators walk the same tree.
+ * 
+ * Postconditions: Returned true if the Iterators are at different 
+ *		   items.
+ * 
+ * @param the_other The other Iterator.
+ * @return True if not equal, false otherwise.
+ */
+bool BSTree::Iterator::operator!= (const Iterator &the_other) const
+{
+	return !(*this == the_other);
+}
+
+
+//---------------------Iterator::getOccurrence------------------------
+/**
+ * @brief Returns the occurrence count of the current item.
+ * 
+ * Preconditions: This Iterator is not past the end.
+ * 
+ * Postconditions: The occurrence count was returned.
+ * 
+ * @return The occurrence count of the current item.
+ */
+int BSTree::Iterator::getOccurrence () const
+{
+	return my_path.back ()->occurences;
+}
+
+
+//---------------------Iterator::pushLeft-----------------------------
+/**
+ * @brief Pushes the provided node and its chain of left children onto
+ *	  the path.
+ * 
+ * Preconditions: None.
+ * 
+ * Postconditions: The smallest node of the subtree is on top of the 
+ *		   path.
+ * 
+ * @param root The root of the subtree.
+ */
+void BSTree::Iterator::pushLeft (const Node *root)
+{
+	while (root != NULL) {
+		my_path.push_back (root);
+		root = root->left;
+	}
+}
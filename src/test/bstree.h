@@ -23,6 +23,14 @@
  *	- Allows retrieving a specified object from the tree.
  *	- Allows removing an object from the tree.
  *	- Allows making the tree empty.
+ *	- Allows keeping the tree balanced as a left-leaning 
+ *	  red-black tree, so its depth stays O(log n) regardless
+ *	  of the order items are inserted.
+ *	- Allows walking the tree in order with an Iterator, and
+ *	  scanning a range of keys with lowerBound and upperBound.
+ *	- Nodes are carved out of contiguous slabs and recycled 
+ *	  through a free list, so emptying the tree releases whole
+ *	  slabs instead of freeing one node at a time.
  * Assumptions:
  * 	- Data objects are not NULL when stored in the tree.
  *	- Data objects have overloaded operator<< for displaying.
@@ -32,9 +40,11 @@
 
 
 #ifndef BSTREE_H
-#define BSTREE_H_
+#define BSTREE_H
 #include <iostream>
+#include <vector>
 #include "object.h"
+#include "ordered_index.h"
 
 /**
  * @namespace std
@@ -45,7 +55,7 @@ using namespace std;
 /**
  * @class BSTree 
  */
-class BSTree {
+class BSTree : public OrderedIndex {
 
 	//---------------------operator<<-----------------------------
 	/**
@@ -69,6 +79,12 @@ class BSTree {
  */
 public:
 
+	/**
+	 * @brief Walks the items of the tree in order without 
+	 *	  recursion.
+	 */
+	class Iterator;
+
 	//---------------------Constructor----------------------------
 	/**
 	 * @brief Creates a BSTree with a NULL root.
@@ -80,6 +96,23 @@ public:
 	 */
 	BSTree ();
 
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a BSTree with a NULL root that is kept
+	 *	  balanced if requested.
+	 * 
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The BSTree was instantiated with its root 
+	 *		   set to NULL. If balanced is true every
+	 *		   insert rebalances the tree as a left-leaning
+	 *		   red-black tree.
+	 *
+	 * @param balanced True to keep the tree balanced.
+	 */
+	explicit BSTree (bool balanced);
+
 	
 	//---------------------Copy-Constructor-----------------------
 	/**
@@ -102,7 +135,7 @@ public:
 	 * 
 	 * Postconditions: This BSTree is empty with a NULL root.	
 	 */
-	~BSTree ();
+	virtual ~BSTree ();
 
 	
 	//---------------------insert---------------------------------
@@ -117,7 +150,7 @@ public:
 	 * @param item The item to insert into the tree.
 	 * @return True if successfully inserted, false otherwise.
 	 */
-	bool insert (Object *item);
+	virtual bool insert (Object *item);
 	
 	
 	//---------------------retrieve-------------------------------
@@ -133,13 +166,13 @@ public:
 	 * @param target The item to search for.
 	 * @return Pointer to the object if found, NULL otherwise.
 	 */
-	const Object * retrieve (const Object &target) const;
+	virtual const Object * retrieve (const Object &target) const;
 	
 
 	//---------------------remove---------------------------------
 	/**
-	 * @brief Removes one occurance of the provided item from 
-	 *	  the tree. If it is the last occurance, the objet
+	 * @brief Removes one occurrence of the provided item from 
+	 *	  the tree. If it is the last occurrence, the objet
 	 *	  is removed. Calls a helper recursive method.
 	 *
 	 * Preconditions: item is a reference to a non NULL object.
@@ -150,7 +183,7 @@ public:
 	 * @param item The item to remove from the tree.
 	 * @return True if removed, false otherwise.
 	 */
-	bool remove (const Object &item);
+	virtual bool remove (const Object &item);
 
 
 	//---------------------makeEmpty------------------------------
@@ -162,20 +195,64 @@ public:
 	 *
 	 * Postconditions: The tree is empty.
 	 */
-	void makeEmpty ();
+	virtual void makeEmpty ();
+
+
+	//---------------------clear----------------------------------
+	/**
+	 * @brief Empties this tree without deleting the stored items,
+	 *	  which are freed with the Region. Only the slabs are
+	 *	  released.
+	 * 	
+ 	 * Preconditions: None.
+	 *
+	 * Postconditions: The tree is empty.
+	 */
+	virtual void clear ();
 
 	
 	//---------------------getOccurrence---------------------------
-	/* @brief Returns the occurence of the item.
+	/* @brief Returns the occurrence of the item.
 	 * 
 	 * Preconditions: item is not NULL.
 	 * 
 	 * Postconditions: occurrnce was returned. 
 	 * 
 	 * @param item The item to get the count of. 
-	 * @return occurence count of the item.
+	 * @return occurrence count of the item.
+	 */
+	virtual int getOccurrence (const Object &item) const;
+
+
+	//---------------------print----------------------------------
+	/** 
+	 * @brief Prints the items of this tree to the output stream
+	 *	  in order, one per line.
+	 * 
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The items have been displayed.
+	 *
+	 * @param output The output stream. 
+ 	 */
+	virtual void print (ostream &output) const;
+
+
+	//---------------------collect--------------------------------
+	/**
+	 * @brief Lists the items of this tree in order, with their
+	 *	  occurrence counts.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: items and counts were appended to. The 
+	 *		   tree still owns the items.
+	 * 
+	 * @param items Filled with the items.
+	 * @param counts Filled with the occurrence count of each item.
 	 */
-	int getOccurrence (const Object &item) const;
+	virtual void collect (vector<const Object *> &items, 
+					vector<int> &counts) const;
 
 	
 	//---------------------operator(=)----------------------------
@@ -192,6 +269,84 @@ public:
 	 */
 	const BSTree& operator=  (const BSTree &the_other);
 
+
+	//---------------------isBalanced-----------------------------
+	/**
+	 * @brief Returns whether this tree keeps itself balanced.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The balancing mode was returned.
+	 * 
+	 * @return True if this is a red-black tree, false otherwise.
+	 */
+	bool isBalanced () const;
+
+
+	//---------------------begin----------------------------------
+	/**
+	 * @brief Returns an Iterator positioned at the smallest item
+	 *	  in the tree.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: An Iterator at the first item, or end() if
+	 *		   the tree is empty, was returned.
+	 * 
+	 * @return An Iterator at the first item.
+	 */
+	Iterator begin () const;
+
+
+	//---------------------end------------------------------------
+	/**
+	 * @brief Returns an Iterator positioned past the last item in
+	 *	  the tree.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The past-the-end Iterator was returned.
+	 * 
+	 * @return The past-the-end Iterator.
+	 */
+	Iterator end () const;
+
+
+	//---------------------lowerBound-----------------------------
+	/**
+	 * @brief Returns an Iterator positioned at the first item 
+	 *	  that is not less than the provided target.
+	 * 
+	 * Preconditions: target is comparable with the items stored
+	 *		  in the tree.
+	 * 
+	 * Postconditions: An Iterator at the first item not less than
+	 *		   target, or end() if there is none, was
+	 *		   returned.
+	 * 
+	 * @param target The low end of the range.
+	 * @return An Iterator at the first item not less than target.
+	 */
+	Iterator lowerBound (const Object &target) const;
+
+
+	//---------------------upperBound-----------------------------
+	/**
+	 * @brief Returns an Iterator positioned at the first item 
+	 *	  that is greater than the provided target.
+	 * 
+	 * Preconditions: target is comparable with the items stored
+	 *		  in the tree.
+	 * 
+	 * Postconditions: An Iterator at the first item greater than
+	 *		   target, or end() if there is none, was
+	 *		   returned.
+	 * 
+	 * @param target The high end of the range.
+	 * @return An Iterator at the first item greater than target.
+	 */
+	Iterator upperBound (const Object &target) const;
+
 /**
  * @private
  */
@@ -204,15 +359,72 @@ private:
 		Object *item;	// Object data being stored.
 		Node   *left;	// Left child subtree.	
 	 	Node   *right;	// Right child subtree.
-		int occurences;	// Occurances of the character. 
+		int occurences;	// Occurrences of the character. 
+		bool red;	// Color of the link from the parent.
+	};
+
+
+	/**
+	 * @brief A contiguous block of nodes.
+	 */
+	struct Slab {
+		Node *nodes;	// The block of nodes.
+		int   size;	// Number of nodes in the block.
 	};
 
+
 	
 	/**
 	 * @brief The root of this tree.
 	 */
 	Node *my_root;
 
+	/**
+	 * @brief True if this tree is kept balanced as a left-leaning
+	 *	  red-black tree.
+	 */
+	bool my_balanced;
+
+	/**
+	 * @brief The slabs nodes are carved out of, oldest first.
+	 */
+	vector<Slab> my_slabs;
+
+	/**
+	 * @brief The number of nodes handed out from the newest slab.
+	 */
+	int my_slab_used;
+
+	/**
+	 * @brief Released nodes waiting to be reused, linked through
+	 *	  their left pointers.
+	 */
+	Node *my_free_list;
+
+	/**
+	 * @brief The number of nodes in the first slab.
+	 */
+	const static int MIN_SLAB_SIZE = 16;
+
+	/**
+	 * @brief The largest number of nodes in a single slab.
+	 */
+	const static int MAX_SLAB_SIZE = 4096;
+
+
+
+	//---------------------init-----------------------------------
+	/**
+	 * @brief Sets up an empty tree. Shared by the constructors.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The tree is empty and its lock is ready.
+	 * 
+	 * @param balanced True to keep the tree balanced.
+	 */
+	void init (bool balanced);
+
 
 	//---------------------clone----------------------------------
 	/**
@@ -231,26 +443,59 @@ private:
 	void clone (Node *&copy, const Node *originalTree);
 
 	
-	//---------------------makeEmptyHelper------------------------
+	//---------------------allocNode----------------------------
 	/**
-	 * @brief Recursively empties the provided subtree.
+	 * @brief Returns an unused node, taken from the free list if
+	 *	  possible and otherwise from the newest slab. A new 
+	 *	  slab, twice the size of the last one, is allocated
+	 *	  when the newest slab is used up.
 	 * 
-	 * Preconditions: root points to the first node in the
-	 *		  tree, or NULL if the tree is empty.
+	 * Preconditions: There is enough memory for a new slab if 
+	 *		  one is needed.
 	 * 
-	 * Postconditions: The provided tree is empty with a NULL 
-	 * 		   root.
+	 * Postconditions: A pointer to an unused node was returned.
 	 * 
-	 * @param root The root of the subtree.
+	 * @return A pointer to an unused node.
+	 */
+	Node * allocNode ();
+
+
+	//---------------------freeNode-------------------------------
+	/**
+	 * @brief Returns the provided node to the free list.
+	 * 
+	 * Preconditions: The node came from allocNode and its item 
+	 *		  has already been released.
+	 * 
+	 * Postconditions: The node is on the free list.
+	 * 
+	 * @param node The node to release.
 	 */
-	void makeEmptyHelper (Node *&root);
+	void freeNode (Node *node);
+
+
+	//---------------------releaseSlabs---------------------------
+	/**
+	 * @brief Deletes the item of every node in use, then releases
+	 *	  all slabs at once. The slabs are walked in memory 
+	 *	  order rather than through the tree.
+	 * 
+	 * Preconditions: Nodes on the free list have a NULL item.
+	 * 
+	 * Postconditions: The slabs, and the items if asked, were
+	 *		   released and the tree is empty with a NULL
+	 *		   root.
+	 *
+	 * @param items True to delete the items, false to leave them.
+	 */
+	void releaseSlabs (bool items);
 
 	
 	//---------------------insertHelper---------------------------
 	/**
 	 * @brief A helper method for recursively inserting an 
 	 * 	  item into the tree. If the imem already exists in 
-	 *	  the tree the occurance will will incremented. 
+	 *	  the tree the occurrence will will incremented. 
 	 *
 	 * Preconditions: item is not NULL, and  my_root points to the
 	 *		  root of the tree, or NULL if the tree is 
@@ -289,8 +534,8 @@ private:
 		
 	//---------------------removeHelper---------------------------
 	/**
-	 * @brief Removes an occurance of the provided item from the
-	 *	  tree. If it is its last occurance the Object it is
+	 * @brief Removes an occurrence of the provided item from the
+	 *	  tree. If it is its last occurrence the Object it is
 	 *	  removed.
 	 * 
 	 * Preconditions: item is a reference to a non-NULL Object.
@@ -331,7 +576,7 @@ private:
 	 * Postconditions: A pointer to the Object item of the most
 	 *		   left node is returned. That node that
 	 *		   previously stored item is then deleted. The
-	 *		   occurance cound is also handled.
+	 *		   occurrence cound is also handled.
 	 *
 	 * @param root The root of the subtree.
 	 * @param m_root The root of the tree being replaced.  
@@ -340,21 +585,6 @@ private:
 	Object * findAndDeleteMostLeft (Node *&root, Node *m_root);
 
 	
-	//---------------------printHelper----------------------------
-	/**
-	 * A helper method that recursively prints the given tree 
-	 * in order.
-	 * 
-	 * Preconditions: root is not NULL.
-	 *
-	 * Postconditions: The tree is sent to the output. 
-	 * 
-	 * @param output The output stream to to send the data.
-	 * @param root The root of the subtree.
-	 */
-	void printHelper (ostream &output, const Node *root) const;
-
-	
 	//---------------------occurrenceHelper-----------------------
 	/**
 	 * @brief Returns the Node of the provided object.
@@ -367,6 +597,220 @@ private:
 	 * @param root The root of the subtree. 
 	 */
 	int occurrenceHelper (const Object &item, const Node *root) const;
+
+
+	//---------------------isRed----------------------------------
+	/**
+	 * @brief Returns whether the link to the provided node is
+	 *	  red. NULL links are black.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The color of the node was returned.
+	 * 
+	 * @param root The node to check.
+	 * @return True if the node is red, false otherwise.
+	 */
+	bool isRed (const Node *root) const;
+
+
+	//---------------------rotateLeft-----------------------------
+	/**
+	 * @brief Rotates the right-leaning red link of the provided
+	 *	  subtree to lean left.
+	 * 
+	 * Preconditions: root and its right child are not NULL.
+	 * 
+	 * Postconditions: root points to the old right child, which
+	 *		   now has the old root as its left child.
+	 * 
+	 * @param root The root of the subtree.
+	 */
+	void rotateLeft (Node *&root);
+
+
+	//---------------------rotateRight----------------------------
+	/**
+	 * @brief Rotates the left-leaning red link of the provided
+	 *	  subtree to lean right.
+	 * 
+	 * Preconditions: root and its left child are not NULL.
+	 * 
+	 * Postconditions: root points to the old left child, which
+	 *		   now has the old root as its right child.
+	 * 
+	 * @param root The root of the subtree.
+	 */
+	void rotateRight (Node *&root);
+
+
+	//---------------------flipColors-----------------------------
+	/**
+	 * @brief Splits a temporary 4-node by flipping the colors of 
+	 *	  the provided node and its children.
+	 * 
+	 * Preconditions: root and both of its children are not NULL.
+	 * 
+	 * Postconditions: The colors of root and its children were
+	 *		   flipped.
+	 * 
+	 * @param root The root of the subtree.
+	 */
+	void flipColors (Node *root);
+
+
+	//---------------------fixUp----------------------------------
+	/**
+	 * @brief Restores the left-leaning red-black invariants at 
+	 *	  the provided subtree on the way back up an insert.
+	 * 
+	 * Preconditions: root is not NULL and its subtrees are valid
+	 *		  left-leaning red-black trees.
+	 * 
+	 * Postconditions: No right-leaning red links or consecutive
+	 *		   red links remain at root.
+	 * 
+	 * @param root The root of the subtree.
+	 */
+	void fixUp (Node *&root);
+};
+
+
+/**
+ * @class BSTree::Iterator
+ *
+ * @brief Walks the items of a BSTree in order. The path from the 
+ *	  root to the current item is kept on an explicit stack, so
+ *	  the walk never recurses. Inserting into the tree 
+ *	  invalidates its Iterators.
+ */
+class BSTree::Iterator {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a past-the-end Iterator.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: This Iterator is equal to BSTree::end().
+	 */
+	Iterator ();
+
+
+	//---------------------operator*------------------------------
+	/**
+	 * @brief Returns the current item.
+	 * 
+	 * Preconditions: This Iterator is not past the end.
+	 * 
+	 * Postconditions: The current item was returned.
+	 * 
+	 * @return The current item.
+	 */
+	const Object & operator* () const;
+
+
+	//---------------------operator->-----------------------------
+	/**
+	 * @brief Returns a pointer to the current item.
+	 * 
+	 * Preconditions: This Iterator is not past the end.
+	 * 
+	 * Postconditions: A pointer to the current item was returned.
+	 * 
+	 * @return A pointer to the current item.
+	 */
+	const Object * operator-> () const;
+
+
+	//---------------------operator++-----------------------------
+	/**
+	 * @brief Moves to the next item in order.
+	 * 
+	 * Preconditions: This Iterator is not past the end.
+	 * 
+	 * Postconditions: This Iterator is at the in-order successor
+	 *		   of the previous item, or past the end.
+	 * 
+	 * @return This Iterator.
+	 */
+	Iterator & operator++ ();
+
+
+	//---------------------operator==-----------------------------
+	/**
+	 * @brief Compares this Iterator with the_other for equality.
+	 * 
+	 * Preconditions: Both Iterators walk the same tree.
+	 * 
+	 * Postconditions: Returned true if both are at the same item
+	 *		   or both are past the end.
+	 * 
+	 * @param the_other The other Iterator.
+	 * @return True if equal, false otherwise.
+	 */
+	bool operator== (const Iterator &the_other) const;
+
+
+	//---------------------operator!=-----------------------------
+	/**
+	 * @brief Compares this Iterator with the_other for 
+	 *	  inequality.
+	 * 
+	 * Preconditions: Both Iterators walk the same tree.
+	 * 
+	 * Postconditions: Returned true if the Iterators are at 
+	 *		   different items.
+	 * 
+	 * @param the_other The other Iterator.
+	 * @return True if not equal, false otherwise.
+	 */
+	bool operator!= (const Iterator &the_other) const;
+
+
+	//---------------------getOccurrence--------------------------
+	/**
+	 * @brief Returns the occurrence count of the current item.
+	 * 
+	 * Preconditions: This Iterator is not past the end.
+	 * 
+	 * Postconditions: The occurrence count was returned.
+	 * 
+	 * @return The occurrence count of the current item.
+	 */
+	int getOccurrence () const;
+
+/**
+ * @private
+ */
+private:
+
+	friend class BSTree;
+
+	//---------------------pushLeft-------------------------------
+	/**
+	 * @brief Pushes the provided node and its chain of left 
+	 *	  children onto the path.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The smallest node of the subtree is on top
+	 *		   of the path.
+	 * 
+	 * @param root The root of the subtree.
+	 */
+	void pushLeft (const Node *root);
+
+	/**
+	 * @brief The nodes whose items are still to be visited, with
+	 *	  the current node on top.
+	 */
+	vector<const Node *> my_path;
 };
 #endif /* BSTREE_H */
 
@@ -22,7 +22,7 @@
  *	- Allows clients to print the Classical.
  *      - Allos clients to clone Classical.
  * Assumptions:
- * 	- The file stream is open and correctly formatted according
+ * 	- The line is correctly formatted according
  *	  to Lab 4 specifications. 
  */
 //--------------------------------------------------------------------
@@ -40,7 +40,7 @@
  */
 Classical::Classical () : Item () 
 {
-	my_composer = ""; 
+	buildKey ();
 }
 
 
@@ -58,14 +58,16 @@ Classical::Classical () : Item ()
  * @param name  The name of the Classical.
  * @param title The title of the Classical. 
  * @param year  The year of the Classical.
- * @param count The occurence count of the Classical. 
+ * @param count The occurrence count of the Classical. 
  * @param composer The composer of the Classical. 
  */
-Classical::Classical (char type, string name, 
-		string title, int year, int count, string composer) 
+Classical::Classical (char type, const InternedString &name, 
+		const InternedString &title, int year, int count, 
+		const InternedString &composer) 
 		: Item (type, name, title, year, count) 
 { 
 	my_composer = composer;
+	buildKey ();
 }
 
 
@@ -83,40 +85,87 @@ Classical::~Classical () {}
 //---------------------getNewInstance---------------------------------
 /**
  * @brief Retuns a pointer to a new Classical object. The objects' 
- *	  data will be set using the provided file stream.
+ *	  data will be set using the provided line.
  *	
- * Preconditions: The file stream is open and correctly formatted
+ * Preconditions: The line is correctly formatted
  *		  according to Lab 4 specs.
  *	
  * Postconditions: A new Classical object was created using the 
  *	 	   provided file stream, and a pointer to it is
  *		   returned. 
  *
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return Returns a pointer to a new instance of a Classical.
  */
-Classical * Classical::getNewInstance (ifstream &input) const
+Classical * Classical::getNewInstance (FieldReader &input) const
 {
 	char type, test;
 	int count, year;
-	string name, title, composer;
+	Field name, title, composer;
 
-	input >> type;     
-	input.ignore (); input.ignore ();
+	type = input.readChar ();     
+	input.skip (2);
 
 	// See if there's a quantity.
 	test = input.peek ();	
 	if (isdigit (test)) {
-		input >> count; input.ignore ();
-		input.ignore ();
+		input.readInt (count);
+		input.skip (2);
 	} else { count = 0; } 
 	
-	getline (input, name,  ','); 
-	input.ignore ();
-	getline (input, title, ',');
-	input >> year;     input.ignore ();
-	getline (input, composer); 
-	return new Classical (type,name,title,year,count,composer);
+	name = input.readField (','); 
+	input.skip (1);
+	title = input.readField (',');
+	input.readInt (year);     input.skip (1);
+	composer = input.readRest (); 
+	return new Classical (type, name, title, year, count, composer);
+}
+
+
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new Classical, read from a snapshot 
+ *	  written by save.
+ *	
+ * Preconditions: The snapshot is at a Classical saved by save.
+ *
+ * Postconditions: A new Classical was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+Classical * Classical::getNewInstance (SnapshotReader &input) const
+{
+	char type;
+	int count, year;
+	string name, title, composer;
+
+	type     = input.getByte ();
+	name     = input.getString ();
+	title    = input.getString ();
+	year     = input.getInt ();
+	count    = input.getInt ();
+	composer = input.getString ();
+	return new Classical (type, name, title, year, count, composer);
+}
+
+
+//---------------------save-------------------------------------------
+/**
+ * @brief Writes this Classical to a snapshot: the fields of an Item, then 
+ *	  the composer.
+ *	
+ * Preconditions: A section of the snapshot is being written.
+ *
+ * Postconditions: This Classical was written.
+ *
+ * @param output The snapshot to write to.
+ */
+void Classical::save (SnapshotWriter &output) const
+{
+	Item::save (output);
+	output.putString (my_composer.toString ());
 }
 
 
@@ -132,9 +181,8 @@ Classical * Classical::getNewInstance (ifstream &input) const
  */
 Classical * Classical::clone () const
 {
-	return new Classical (getType(), getName(), 		
-				getTitle(), getYear(), getCount(),
-					my_composer);
+	// The copy shares the pooled strings, sort key included.
+	return new Classical (*this);
 }
 
 
@@ -157,22 +205,9 @@ Classical * Classical::clone () const
  *	   false otherwise. 
  */
 bool Classical::operator< (const Object &the_other) const
-{ 
-	try {	
-		const Classical &c =
-			 dynamic_cast<const Classical &> (the_other);
-		
-		if ((my_composer < c.my_composer) && 
-		    (getName()   < c.getName())   &&
-		    (getYear()   < c.getYear())   && 
-		    (getTitle()  < c.getTitle())) {
-			return true;
-		}		
-
-	} catch (exception &e) {
-		cout << "Exception: " << e.what () << endl;
-	}
- 	return false;
+{
+	// The sort key orders by the same fields, without RTTI.
+	return getSortKey () < the_other.getSortKey ();
 }
 
 
@@ -194,21 +229,8 @@ bool Classical::operator< (const Object &the_other) const
  */
 bool Classical::operator== (const Object &the_other) const
 {
-	try {	
-		const Classical &c =
-			 dynamic_cast<const Classical &> (the_other);
-		
-		if ((my_composer == c.my_composer) && 
-		    (getName()   == c.getName())   && 
-		    (getYear()   == c.getYear())   && 
-		    (getTitle()  == c.getTitle())) {
- 		    return true;	
-		} 
-
-	} catch (exception &e) {
-		cout << "Exception: " << e.what () << endl;
-	}
-	return false; 
+	// Equal sort keys mean equal fields, without RTTI.
+	return sameKey (the_other);
 }
 
 
@@ -228,6 +250,25 @@ void Classical::print (ostream &output) const
 {
 	output << "Classical CD: ";
 	Item::print (output);
-	output << ", " << my_composer;
+	output << ", " << my_composer.toString ();
 }
 
+
+//---------------------buildKey---------------------------------------
+/**
+ * @brief Builds the sort key of this Classical from its type followed
+ *	  by the composer, artist name, year and title.
+ *
+ * Preconditions: The data members have been initialized.
+ *
+ * Postconditions: The sort key of this Classical was set.
+ */
+void Classical::buildKey ()
+{
+	string key (1, getType ());
+	appendKey (key, my_composer.toString ());
+	appendKey (key, getName ());
+	appendKey (key, getYear ());
+	appendKey (key, getTitle ());
+	setSortKey (key);
+}
@@ -22,7 +22,7 @@
  *	- Allows clients to print the Classical.
  *      - Allos clients to clone Classical.
  * Assumptions:
- * 	- The file stream is open and correctly formatted according
+ * 	- The line is correctly formatted according
  *	  to Lab 4 specifications. 
  */
 //--------------------------------------------------------------------
@@ -69,12 +69,12 @@ public:
 	 * @param name  The name of the Classical.
 	 * @param title The title of the Classical. 
 	 * @param year  The year of the Classical.
-	 * @param count The occurence count of the Classical.
+	 * @param count The occurrence count of the Classical.
 	 * @param composer The composer of the Classical. 
 	 */
-	Classical (char type, string name, 
-				string title, int year, 
-					int count, string composer);		
+	Classical (char type, const InternedString &name, 
+				const InternedString &title, int year, 
+				int count, const InternedString &composer);		
 
 	//---------------------Destructor-----------------------------
 	/**
@@ -93,17 +93,47 @@ public:
 	 *	  The objects' data will be set using the provided
  	 *	  file stream.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *	 	  formatted according to Lab 4 specs.
 	 *	
 	 * Postconditions: A new Classical object was created using
-	 *		   the provided file stream, and a pointer
+	 *		   the provided line, and a pointer
 	 *		   to it is returned. 
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return Returns a pointer to a new instance of a Classical.
 	 */
-	virtual Classical * getNewInstance (ifstream &input) const;
+	virtual Classical * getNewInstance (FieldReader &input) const;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new Classical, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a Classical saved by save.
+	 *
+	 * Postconditions: A new Classical was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Classical * getNewInstance (SnapshotReader &input) const;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes this Classical to a snapshot: the 
+	 *	  fields of an Item, then the composer.
+	 *	
+ 	 * Preconditions: A section of the snapshot is being written.
+	 *
+	 * Postconditions: This Classical was written.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	virtual void save (SnapshotWriter &output) const;
 
 
 	//---------------------clone----------------------------------
@@ -181,6 +211,19 @@ public:
  * @private
  */
 private:
-	string my_composer;
+
+	//---------------------buildKey-------------------------------
+	/**
+	 * @brief Builds the sort key of this Classical from its type 
+	 *	  followed by the composer, artist name, year and 
+	 *	  title.
+	 *
+	 * Preconditions: The data members have been initialized.
+	 *
+	 * Postconditions: The sort key of this Classical was set.
+	 */
+	void buildKey ();
+
+	InternedString my_composer;
 };
 #endif /* CLASSICAL_H */
@@ -0,0 +1,199 @@
+/**
+ * @file command.cpp
+ *
+ * @brief A class to represent a Command. A Command is a transaction
+ *	  held by value: its type, the customer ID and the Item, if it
+ *	  has them. The types are a closed set, so the StoreManager
+ *	  executes a Command with a switch on its type, without a cast
+ *	  or a virtual call. A Transaction is only made when a Command
+ *	  succeeds and has to be kept in a customer's history.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows reading a Command from a line of the transactions
+ *	  file, or from a Transaction saved to a snapshot or journal.
+ *	- Allows getting its type, customer ID and Item.
+ *	- Allows deleting its Item, when it is not kept.
+ *
+ * Assumptions:
+ *	- A Command is copied freely, and the copies share the Item.
+ *	  Whoever executes the Command owns the Item, and either hands
+ *	  it to a Transaction or deletes it.
+ */
+//--------------------------------------------------------------------
+
+#include "command.h"
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates an empty Command, of no type.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This Command has type '\0', and no Item.
+ */
+Command::Command ()
+{
+	my_type    = '\0';
+	my_cust_id = 0;
+	my_item    = NULL;
+}
+
+
+//---------------------read-------------------------------------------
+/**
+ * @brief Reads a Command from a line of the transactions file. The
+ *	  fields are laid out as the Transactions' getNewInstance
+ *	  reads them. A purchase or trade is followed by its Item.
+ *
+ * Preconditions: The line is correctly formatted according to Lab 4
+ *		  specs.
+ *
+ * Postconditions: True was returned if the line holds a transaction,
+ *		   false otherwise.
+ *
+ * @param line The line to read from.
+ * @param items The factory of the Items.
+ * @return True if read, false otherwise.
+ */
+bool Command::read (FieldReader &line, const ObjectFactory &items)
+{
+	my_type    = line.peek ();
+	my_cust_id = 0;
+	my_item    = NULL;
+
+	switch (my_type) {
+	case PURCHASE_ID:
+	case TRADE_ID:
+		line.readChar (); line.skip (1);
+		line.readLong (my_cust_id); line.skip (2);
+		my_item = static_cast<Item *> (items.getNewObject (line));
+		return true;
+	case HISTORY_ID:
+		line.readChar (); line.skip (1);
+		line.readLong (my_cust_id);
+		return true;
+	case INVENTORY_ID:
+	case ALL_ID:
+		line.readChar ();
+		return true;
+	}
+
+	// Bad type, so the line is skipped.
+	return false;
+}
+
+
+//---------------------read-------------------------------------------
+/**
+ * @brief Reads a Command from a Transaction written by its save
+ *	  method, with its Item if it has one.
+ *
+ * Preconditions: input is at a saved Transaction.
+ *
+ * Postconditions: True was returned if a transaction was read, false
+ *		   if input failed.
+ *
+ * @param input The snapshot or record to read from.
+ * @param items The factory of the Items.
+ * @return True if read, false otherwise.
+ */
+bool Command::read (SnapshotReader &input, const ObjectFactory &items)
+{
+	my_type    = input.getByte ();
+	my_cust_id = 0;
+	my_item    = NULL;
+
+	switch (my_type) {
+	case PURCHASE_ID:
+	case TRADE_ID:
+		my_cust_id = input.getLong ();
+		my_item = static_cast<Item *> (items.getNewObject (input));
+		break;
+	case HISTORY_ID:
+		my_cust_id = input.getLong ();
+		break;
+	case INVENTORY_ID:
+	case ALL_ID:
+		break;
+	default:
+		input.fail ();
+	}
+
+	if (input.failed ()) {
+		discard ();
+		return false;
+	}
+	return true;
+}
+
+
+//---------------------getType----------------------------------------
+/**
+ * @brief Returns the type of this Command.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The type was returned.
+ *
+ * @return The type.
+ */
+char Command::getType () const
+{
+	return my_type;
+}
+
+
+//---------------------getCustomerId----------------------------------
+/**
+ * @brief Returns the customer ID of this Command.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The customer ID, or 0 if it has none, was returned.
+ *
+ * @return The customer ID.
+ */
+long long Command::getCustomerId () const
+{
+	return my_cust_id;
+}
+
+
+//---------------------getItem----------------------------------------
+/**
+ * @brief Returns the Item of this Command.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The Item, or NULL if it has none, was returned.
+ *
+ * @return The Item, or NULL.
+ */
+Item * Command::getItem () const
+{
+	return my_item;
+}
+
+
+//---------------------discard----------------------------------------
+/**
+ * @brief Deletes the Item of this Command.
+ *
+ * Preconditions: The Item was not handed to a Transaction.
+ *
+ * Postconditions: The Item was deleted, and this Command has none.
+ */
+void Command::discard ()
+{
+	delete my_item;
+	my_item = NULL;
+}
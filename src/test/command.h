@@ -0,0 +1,195 @@
+/**
+ * @file command.h
+ *
+ * @brief A class to represent a Command. A Command is a transaction
+ *	  held by value: its type, the customer ID and the Item, if it
+ *	  has them. The types are a closed set, so the StoreManager
+ *	  executes a Command with a switch on its type, without a cast
+ *	  or a virtual call. A Transaction is only made when a Command
+ *	  succeeds and has to be kept in a customer's history.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows reading a Command from a line of the transactions
+ *	  file, or from a Transaction saved to a snapshot or journal.
+ *	- Allows getting its type, customer ID and Item.
+ *	- Allows deleting its Item, when it is not kept.
+ *
+ * Assumptions:
+ *	- A Command is copied freely, and the copies share the Item.
+ *	  Whoever executes the Command owns the Item, and either hands
+ *	  it to a Transaction or deletes it.
+ */
+//--------------------------------------------------------------------
+
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include "item.h"
+#include "field_reader.h"
+#include "snapshot_file.h"
+#include "object_factory.h"
+/**
+ * @namespace std
+ */
+using namespace std;
+
+/**
+ * @bief The Purchase Transaction identifier.
+ */
+char const PURCHASE_ID = 'P';
+/**
+ * @brief The Trade Transaction identifier.
+ */
+char const TRADE_ID = 'T';
+/**
+ * @brief The History Transaction identifier. 
+ */
+char const HISTORY_ID = 'H';
+/**
+ * @brief The All History Transaction identifier.  
+ */
+char const ALL_ID = 'A';
+/**
+ * @brief The Inventory Transaction identifier.
+ */
+char const INVENTORY_ID = 'I';
+
+
+/**
+ * @class Command
+ */
+class Command {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates an empty Command, of no type.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This Command has type '\0', and no Item.
+	 */
+	Command ();
+
+
+	//---------------------read-----------------------------------
+	/**
+	 * @brief Reads a Command from a line of the transactions
+	 *	  file. A purchase or trade is followed by its Item.
+	 *
+	 * Preconditions: The line is correctly formatted according to
+	 *		  Lab 4 specs.
+	 *
+	 * Postconditions: True was returned if the line holds a
+	 *		   transaction, false otherwise.
+	 *
+	 * @param line The line to read from.
+	 * @param items The factory of the Items.
+	 * @return True if read, false otherwise.
+	 */
+	bool read (FieldReader &line, const ObjectFactory &items);
+
+
+	//---------------------read-----------------------------------
+	/**
+	 * @brief Reads a Command from a Transaction written by its
+	 *	  save method, with its Item if it has one.
+	 *
+	 * Preconditions: input is at a saved Transaction.
+	 *
+	 * Postconditions: True was returned if a transaction was read,
+	 *		   false if input failed.
+	 *
+	 * @param input The snapshot or record to read from.
+	 * @param items The factory of the Items.
+	 * @return True if read, false otherwise.
+	 */
+	bool read (SnapshotReader &input, const ObjectFactory &items);
+
+
+	//---------------------getType--------------------------------
+	/**
+	 * @brief Returns the type of this Command.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The type was returned.
+	 *
+	 * @return The type.
+	 */
+	char getType () const;
+
+
+	//---------------------getCustomerId--------------------------
+	/**
+	 * @brief Returns the customer ID of this Command.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The customer ID, or 0 if it has none, was
+	 *		   returned.
+	 *
+	 * @return The customer ID.
+	 */
+	long long getCustomerId () const;
+
+
+	//---------------------getItem--------------------------------
+	/**
+	 * @brief Returns the Item of this Command.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The Item, or NULL if it has none, was
+	 *		   returned.
+	 *
+	 * @return The Item, or NULL.
+	 */
+	Item * getItem () const;
+
+
+	//---------------------discard--------------------------------
+	/**
+	 * @brief Deletes the Item of this Command.
+	 *
+	 * Preconditions: The Item was not handed to a Transaction.
+	 *
+	 * Postconditions: The Item was deleted, and this Command has
+	 *		   none.
+	 */
+	void discard ();
+
+/**
+ * @private
+ */
+private:
+
+	/**
+	 * @brief The type of transaction.
+	 */
+	char my_type;
+
+	/**
+	 * @brief The customer ID, or 0.
+	 */
+	long long my_cust_id;
+
+	/**
+	 * @brief The Item, or NULL.
+	 */
+	Item *my_item;
+};
+#endif /* COMMAND_H */
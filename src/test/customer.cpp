@@ -2,7 +2,8 @@
  * @file customer.cpp 
  * 
  * @brief This class represents a Customer. A Customer has an ID,
- * 	  name, and a list of Transaction objects. 
+ * 	  name, and a transaction history, kept as a chain of entries
+ *	  in the store's TransactionLog. 
  *
  * @brief CSS 343 - Lab 4
  *
@@ -15,7 +16,7 @@
 /**
  * Includes following features:
  * 	- Allows creating a customer and specifying their ID and name.
- *	- Allows adding a Transaction object to the customers' 
+ *	- Allows adding a purchase or trade to the customers' 
  *	  transaction history. 
  *	- Allows clients to << a Customer.
  *      - Allows clients to clone a Customer.
@@ -24,10 +25,8 @@
  * 	- The file stream that is passed when creating the customers
  *        is open, and it contains a valid format according to the
  *	  Lab 4 specifications.  
- *	- The Transaction object has print method which is used by 
- *	  this class when displaying the transaction history.
- *	- When adding a Transaction to a customers' transaction list
- *	  the customer takes ownership of the object.
+ *	- Every transaction of a history is appended to the same
+ *	  TransactionLog, which outlives the Customer.
  */
 //--------------------------------------------------------------------
 
@@ -46,9 +45,12 @@
  */
 Customer::Customer () : Object ()
 {
-	my_name    = ""; 
 	my_id      = 0;
-	my_history = new vector<Transaction *>();
+	my_log     = NULL;
+	my_first   = -1;
+	my_last    = -1;
+	my_count   = 0;
+	setSortKey (my_name);
 }
 
 
@@ -64,74 +66,56 @@ Customer::Customer () : Object ()
  * @param the_id The customer ID.
  * @param the_name The customer name.
  */
-Customer::Customer (int the_id, string the_name) : Object ()
+Customer::Customer (long long the_id, const InternedString &the_name) 
+				: Object ()
 {
 	my_id      = the_id;
 	my_name    = the_name;
-	my_history = new vector<Transaction *>();
+	my_log     = NULL;
+	my_first   = -1;
+	my_last    = -1;
+	my_count   = 0;
+	setSortKey (my_name);
 }
 
 //---------------------Constructor------------------------------------
 /**
- * @brief Creates a Customer object using the specified file.
+ * @brief Creates a Customer object using the specified line.
  *
  * Preconditions:  None.
  * 
- * Postconditions: my_name and my_id have been set using the file.
+ * Postconditions: my_name and my_id have been set using the line.
  */
-Customer::Customer (ifstream &input)
+Customer::Customer (FieldReader &input)
 {
-	input >> my_id;
-	input.ignore (2);
-	getline (input, my_name);	
-	my_history = new vector<Transaction *>(); 
-}
-
-
-//---------------------Constructor----------------------------
-/**
- * @brief Creates a Customer object with the specified values.
- * 
- * Preconditions: None. 
- * 
- * Postconditions: my_name, my_id, and my_history have been 
- *		   set to the provided values. 
- * 
- * @param the_id   The customer ID.
- * @param the_name The customer name.
- * @param the_hist The history transactions.
- */
-Customer::Customer (int the_id, string the_name, 
-				vector<Transaction *> *the_hist)
-				: Object ()
-{
-	my_id = the_id;
-	my_name = the_name;
-	my_history = the_hist;
+	input.readLong (my_id);
+	input.skip (2);
+	my_name  = input.readRest ();	
+	my_log   = NULL;
+	my_first = -1;
+	my_last  = -1;
+	my_count = 0;
+	setSortKey (my_name);
 }
 
 
 //---------------------Destructor-------------------------------------
 /**
- * @brief Deallocates the transaction list and my_name. 
+ * @brief Does nothing; the history stays in the TransactionLog.
  *
- * Preconditions:  my_transactions points to the list of transactions 
- *		   or NULL. my_id points to a dynamically allocated 
- *		   array. my_name points to a string object. 
+ * Preconditions:  None.
  * 
- * Postconditions: my_transactions and my_name were deleted.
+ * Postconditions: None.
  */
 Customer::~Customer ()
 {
-	delete my_history;
-	my_history = NULL;
 }
 
 	
 //---------------------getNewInstance---------------------------------
 /**
  * @brief Returns a pointer to a Customer object with its ID and name
- *	  set to the values within the provided file stream.
+ *	  set to the values within the provided line.
  *
  * Preconditions:  input is open, and contains a valid format 
  *		   according to the Lab 4 specs. The characters 
@@ -146,20 +130,69 @@ Customer::~Customer ()
  * @param input The stream to extract my_id and my_name.
  * @return A pointer to a new instance of a Customer.
  */
-Customer * Customer::getNewInstance (ifstream &input) const
+Customer * Customer::getNewInstance (FieldReader &input) const
 {
-	int id;
-	string name;
-	input >> id;
-	input.ignore (2);
-	getline (input, name); 
+	long long id;
+	Field name;
+	input.readLong (id);
+	input.skip (2);
+	name = input.readRest (); 
 	return new Customer (id, name);	
 }
 
 
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new Customer, read from a snapshot 
+ *	  written by save.
+ *	  Only the ID and name are read; the history saved after them
+ *	  is left for the caller, which has the factories to read it 
+ *	  with.
+ *	
+ * Preconditions: The snapshot is at a Customer saved by save.
+ *
+ * Postconditions: A new Customer was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+Customer * Customer::getNewInstance (SnapshotReader &input) const
+{
+	long long id;
+	string name;
+	id   = input.getLong ();
+	name = input.getString ();
+	return new Customer (id, name);
+}
+
+
+//---------------------save-------------------------------------------
+/**
+ * @brief Writes this Customer to a snapshot: its ID, name, the length of
+ *	  its history and then each transaction of the history, as its
+ *	  Transaction would be saved.
+ *	
+ * Preconditions: A section of the snapshot is being written.
+ *
+ * Postconditions: This Customer was written.
+ *
+ * @param output The snapshot to write to.
+ */
+void Customer::save (SnapshotWriter &output) const
+{
+	output.putLong   (my_id);
+	output.putString (my_name.toString ());
+	output.putInt    (my_count);
+	for (int i = my_first; i >= 0; i = my_log->getNext (i))
+		my_log->save (i, output);
+}
+
+
 //---------------------clone------------------------------------------
 /**
- * @brief Returns a pointer to a clone of this Customer. 
+ * @brief Returns a pointer to a clone of this Customer. The entries of
+ *	  its history are copied to the end of the TransactionLog.
  * 
  * Preconditions: None.
  * 
@@ -169,15 +202,13 @@ Customer * Customer::getNewInstance (ifstream &input) const
  */
 Customer * Customer::clone () const
 {
-	int i;
-	Transaction *t;
-	vector<Transaction *> *hist = new vector<Transaction *>();
+	Customer *copy = new Customer (my_id, my_name);
 
-	// First copy the transactions.
-	for (i = 0; i < (long)my_history->size(); i++) {
-		hist->push_back (my_history->at(i)->clone());
-	}
-	return new Customer (my_id, my_name, hist);
+	// Then copy the transactions.
+	for (int i = my_first; i >= 0; i = my_log->getNext (i)) 
+		copy->addTransaction (*my_log, my_log->getType (i),
+					my_log->getItem (i));
+	return copy;
 }
 
 
@@ -188,20 +219,21 @@ Customer * Customer::clone () const
  * 
  * Preconditions: None.
  *
- * Postconditions: my_id, my_name, and my_history have been sent to 
+ * Postconditions: my_id, my_name, and the history have been sent to 
  *	 	   the output stream. 
  * 
  * @param output The output stream. 
  */
 void Customer::print (ostream &output) const
 {
-	int i;
-	output << "Customer Name       :" << my_name << endl;
+	int i, number = 1;
+	output << "Customer Name       :" << my_name.toString () << endl;
 	output << "Customer ID         :" << my_id << endl;
 	output << "Transaction History :" << endl;
-	for (i = 0; i < (long)my_history->size(); i++) {
-		output << i + 1 << ".) ";	
-		output << *my_history->at(i) << endl;
+	for (i = my_first; i >= 0; i = my_log->getNext (i)) {
+		output << number++ << ".) ";	
+		my_log->print (i, output);
+		output << endl;
 	}
 }
 
@@ -216,7 +248,7 @@ void Customer::print (ostream &output) const
  *
  * @return This customer ID.
  */
-int Customer::getId () const
+long long Customer::getId () const
 {
 	return my_id;
 }
@@ -224,20 +256,25 @@ int Customer::getId () const
 
 //---------------------addTransaction---------------------------------
 /**
- * @brief Adds a the provided Transaction object to this Customer.
+ * @brief Appends a purchase or trade to the log, at the end of this 
+ *	  Customer's history.
  *
- * Preconditions: None.
+ * Preconditions: item is not NULL. Every transaction of this Customer 
+ *		  is added to the same log.
  *
- * Postconditions: The Transaction object is added to the end of the 
- *		   Transaction list.
+ * Postconditions: The transaction is added to the end of the history.
  *	
- * @param transaction The Transaction to add.
+ * @param log The TransactionLog.
+ * @param type The type of transaction.
+ * @param item The Item listed in the inventory.
  */
-void Customer::addTransaction (Transaction *transaction)
+void Customer::addTransaction (TransactionLog &log, char type, 
+						const Item *item)
 {
-	if (transaction != NULL) {
-		my_history->push_back (transaction);
-	}
+	my_log  = &log;
+	my_last = log.append (my_id, type, item, my_last);
+	if (my_first < 0) my_first = my_last;
+	my_count++;
 }
 
 	
@@ -257,16 +294,8 @@ void Customer::addTransaction (Transaction *transaction)
  */
 bool Customer::operator< (const Object &the_other) const
 {
-	try {
-		const Customer &c = 
-			dynamic_cast<const Customer&>(the_other);
-		
-		return (my_name.compare (c.my_name)<0?true:false);
-
-	} catch (exception &e) {
-		cout << "Exception: " << e.what() << endl;
-	} 
-	return false;
+	// The sort key is the name, so no RTTI is needed.
+	return getSortKey () < the_other.getSortKey ();
 }
 	
 
@@ -285,16 +314,8 @@ bool Customer::operator< (const Object &the_other) const
  */
 bool Customer::operator== (const Object &the_other) const 
 {
-	try {
-		const Customer &c = 
-			dynamic_cast<const Customer&>(the_other);
-		
-		return (my_name.compare (c.my_name)==0?true:false);
-
-	} catch (exception &e) {
-		cout << "Exception: " << e.what() << endl;
-	}
-	return false; 
+	// The sort key is the name, so no RTTI is needed.
+	return sameKey (the_other);
 }
 
 
@@ -2,7 +2,8 @@
  * @file customer.h 
  * 
  * @brief This class represents a Customer. A Customer has an ID,
- * 	  name, and a list of Transaction objects. 
+ * 	  name, and a transaction history, kept as a chain of entries
+ *	  in the store's TransactionLog. 
  *
  * @brief CSS 343 - Lab 4
  *
@@ -15,7 +16,7 @@
 /**
  * Includes following features:
  * 	- Allows creating a customer and specifying their ID and name.
- *	- Allows adding a Transaction object to the customers' 
+ *	- Allows adding a purchase or trade to the customers' 
  *	  transaction history. 
  *	- Allows displaying a customer using print.
  *	- Allows getting a new instance of a customer.
@@ -27,10 +28,8 @@
  * 	- The file stream that is passed when creating the customers
  *        is open, and it contains a valid format according to the
  *	  Lab 4 specifications.  
- *	- The Transaction object has print method which is used by 
- *	  this class when displaying the transaction history.
- *	- When adding a Transaction to a customers' transaction list
- *	  the customer takes ownership of the object.
+ *	- Every transaction of a history is appended to the same
+ *	  TransactionLog, which outlives the Customer.
  */
 //--------------------------------------------------------------------
  
@@ -42,10 +41,9 @@
 #include <vector>
 #include <exception>
 #include <iomanip>
-#include "transaction.h"
+#include "transaction_log.h"
 #include "object.h"
 
-
 /**
  * @class Customer
  */
@@ -87,14 +85,14 @@ public:
 
 	//---------------------Constructor----------------------------
 	/**
- 	 * @brief Creates a Customer object using the specified file.
+ 	 * @brief Creates a Customer object using the specified line.
 	 *
  	 * Preconditions:  None.
 	 * 
  	 * Postconditions: my_name and my_id have been set using the 
-	 *		   file.
+	 *		   line.
  	 */
-	Customer (ifstream &input);
+	Customer (FieldReader &input);
 
 
 	//---------------------Constructor----------------------------
@@ -109,36 +107,17 @@ public:
 	 * @param the_id The customer ID.
 	 * @param the_name The customer name.
 	 */
-	Customer (int the_id, string the_name);
-
-
-	//---------------------Constructor----------------------------
-	/**
-	 * @brief Creates a Customer object with the specified values.
-	 * 
-	 * Preconditions: None. 
-	 * 
-	 * Postconditions: my_name, my_id, my_history have been set to 
- 	 *		   the provided values. 
-	 * 
-	 * @param the_id The customer ID.
-	 * @param the_name The customer name.
-	 * @param the_hist The transaction history.
-	 */
-	Customer (int the_id, string the_name,
-				vector<Transaction *> *the_hist);
+	Customer (long long the_id, const InternedString &the_name);
 
 
 	//---------------------Destructor-----------------------------
 	/**
- 	 * @brief Deallocates the transaction list and name. 
+ 	 * @brief Does nothing; the history stays in the 
+	 *	  TransactionLog.
 	 *
- 	 * Preconditions:  my_transactions points to the list of 
-	 *		   transactions or NULL. my_id points to a 
-	 *		   dynamically allocated array. 	
-	 *		   my_name points to a string object. 
+ 	 * Preconditions:  None.
 	 * 
- 	 * Postconditions: my_transactions and my_name were deleted.
+ 	 * Postconditions: None.
  	 */
 	virtual ~Customer (); 
 
@@ -164,12 +143,49 @@ public:
  	 * @param input The stream to extract my_id and my_name.
 	 * @return A pointer to a new instance of a Customer.
  	 */
-	 virtual Customer * getNewInstance (ifstream &input) const; 
+	 virtual Customer * getNewInstance (FieldReader &input) const; 
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new Customer, read from a 
+	 *	  snapshot written by save.
+	 *	  Only the ID and name are read; the history saved
+	 *	  after them is left for the caller, which has the
+	 *	  factories to read it with.
+	 *	
+ 	 * Preconditions: The snapshot is at a Customer saved by save.
+	 *
+	 * Postconditions: A new Customer was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Customer * getNewInstance (SnapshotReader &input) const;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes this Customer to a snapshot: its 
+	 *	  ID, name, the length of its history and then each
+	 *	  transaction of the history, as its Transaction would
+	 *	  be saved.
+	 *	
+ 	 * Preconditions: A section of the snapshot is being written.
+	 *
+	 * Postconditions: This Customer was written.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	virtual void save (SnapshotWriter &output) const;
 	
 
 	//---------------------clone----------------------------------
 	/**
-	 * @brief Returns a pointer to a clone of this Customer. 
+	 * @brief Returns a pointer to a clone of this Customer. The
+	 *	  entries of its history are copied to the end of the
+	 *	  TransactionLog.
 	 * 
 	 * Preconditions: None.
 	 * 
@@ -182,17 +198,21 @@ public:
 
 	//---------------------addTransaction-------------------------
 	/**
-	 * @brief Adds a the provided Transaction object to this 
-	 * 	  Customer.
+	 * @brief Appends a purchase or trade to the log, at the end
+	 * 	  of this Customer's history.
 	 *
-	 * Preconditions: None.
+	 * Preconditions: item is not NULL. Every transaction of this
+	 *		  Customer is added to the same log.
 	 *
-	 * Postconditions: The Transaction object is added to the end
-	 *		   of the Transaction list.
+	 * Postconditions: The transaction is added to the end of the
+	 *		   history.
 	 *	
- 	 * @param transaction The Transaction to add.
+	 * @param log The TransactionLog.
+	 * @param type The type of transaction.
+ 	 * @param item The Item listed in the inventory.
 	 */
-	void addTransaction (Transaction *transaction);
+	void addTransaction (TransactionLog &log, char type, 
+						const Item *item);
 
 
 	//---------------------print----------------------------------
@@ -202,7 +222,7 @@ public:
 	 * 
 	 * Preconditions: None.
 	 *
-	 * Postconditions: my_id, my_name, and my_history have
+	 * Postconditions: my_id, my_name, and the history have
 	 *		   been sent to the output stream. 
  	 */
 	virtual void print (ostream &output) const;
@@ -218,7 +238,7 @@ public:
  	 *
 	 * @return This customer ID.
 	 */
-	int getId () const;
+	long long getId () const;
 
 
 	//---------------------operator<------------------------------
@@ -262,17 +282,30 @@ private:
 	/**
 	 * @brief The customer ID.
 	 */	
-	int my_id;	
+	long long my_id;	
+
+	/**
+ 	 * @brief The customer name, interned.
+	 */
+	InternedString my_name;
+
+	/**
+ 	 * @brief The log the history is kept in, or NULL while it is
+	 *	  empty.
+	 */
+	TransactionLog *my_log;
 
 	/**
- 	 * @brief The customer name.
+ 	 * @brief The first and last entry of the history in the log, 
+	 *	  or -1 while it is empty.
 	 */
-	string my_name;
+	int my_first;
+	int my_last;
 
 	/**
- 	 * @brief The Transaction history vector. 
+ 	 * @brief The number of transactions in the history.
 	 */
-	vector<Transaction *> *my_history; 
+	int my_count;
 };
 #endif /* CUSTOMER_H */
 
@@ -40,7 +40,10 @@
  *	
  * Postconditions: This Dvd was instantiated with default values.  
  */
-Dvd::Dvd () : Item () {} 
+Dvd::Dvd () : Item () 
+{
+	buildKey ();
+}
 
 
 //---------------------Constructor------------------------------------
@@ -56,10 +59,14 @@ Dvd::Dvd () : Item () {}
  * @param name  The name of the Dvd.	
  * @param title The title of the Dvd.
  * @param year  The year of the Dvd.
- * @param count The occurence count of this Dvd.
+ * @param count The occurrence count of this Dvd.
  */
-Dvd::Dvd (char type, string name, string title, int year, int count) 
-		: Item (type, name, title, year, count) {}
+Dvd::Dvd (char type, const InternedString &name, 
+		const InternedString &title, int year, int count) 
+		: Item (type, name, title, year, count) 
+{
+	buildKey ();
+}
 
 
 
@@ -99,43 +106,70 @@ void Dvd::print (ostream &output) const
  *	  data of the object will be set using the provided file
  *	  stream.
  *
- * Preconditions: The file stream is open and correctly formatted 
+ * Preconditions: The line is correctly formatted 
  *		  according to Lab 4 specifications.
  *
  * Postconditions: A pointer to a new Dvd obect is returned. The data
  *		   of the object is set using the provided file
  *		   stream.
  *
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return Returns a pointer to a new Dvd object.
  */
-Dvd * Dvd::getNewInstance (ifstream &input) const
+Dvd * Dvd::getNewInstance (FieldReader &input) const
 {
 	
 	char type, test;
 	int year, count;
-	string title, name;	
+	Field title, name;	
 
-	input >> type;  
-	input.ignore (); input.ignore ();
+	type = input.readChar ();  
+	input.skip (2);
 	
 	// See if there's a quantity.
 	test = input.peek ();	
 	if (isdigit (test)) {
-		input >> count; input.ignore ();
-		input.ignore ();	
+		input.readInt (count);
+		input.skip (2);	
 	} 
 	else { count = 0; }	
 	
-	getline (input, name,  ',');
-	input.ignore ();
-	getline (input, title, ','); 
-	input >> year; 
-	input.ignore (INT_MAX, '\n'); 
+	name = input.readField (',');
+	input.skip (1);
+	title = input.readField (','); 
+	input.readInt (year); 
 	return new Dvd (type, name, title, year, count); 
 }
 
 
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new Dvd, read from a snapshot 
+ *	  written by save.
+ *	
+ * Preconditions: The snapshot is at a Dvd saved by save.
+ *
+ * Postconditions: A new Dvd was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+Dvd * Dvd::getNewInstance (SnapshotReader &input) const
+{
+	char type;
+	int year, count;
+	string title, name;
+
+	type  = input.getByte ();
+	name  = input.getString ();
+	title = input.getString ();
+	year  = input.getInt ();
+	count = input.getInt ();
+	return new Dvd (type, name, title, year, count);
+}
+
+
 //---------------------clone------------------------------------------
 /**
  * @brief Clones this Dvd.
@@ -148,8 +182,8 @@ Dvd * Dvd::getNewInstance (ifstream &input) const
  */
 Dvd * Dvd::clone () const
 {
-	return new Dvd (getType(), getName(), getTitle(), 
-				getYear(), getCount());
+	// The copy shares the pooled strings, sort key included.
+	return new Dvd (*this);
 }
 
 
@@ -172,20 +206,8 @@ Dvd * Dvd::clone () const
  */
 bool Dvd::operator< (const Object &the_other) const
 {
-	try {
-		const Dvd &d = dynamic_cast<const Dvd &> (the_other);
-
-		if ((getTitle() < d.getTitle()) &&
-		    (getYear()  < d.getYear())  &&
-		    (getName()  < d.getName())) {
-			return true;	
-		}  
-
-	} catch (exception &e) {
-		cout << "Dvd ";
-		cout << "Exception: " << e.what() << endl;
-	}
-	return false;
+	// The sort key orders by the same fields, without RTTI.
+	return getSortKey () < the_other.getSortKey ();
 }
 
 
@@ -204,18 +226,25 @@ bool Dvd::operator< (const Object &the_other) const
  */
 bool Dvd::operator== (const Object &the_other) const
 {
-	try {
-		const Dvd &d = dynamic_cast<const Dvd &> (the_other);
-
-		if ((getTitle() == d.getTitle()) &&
-		    (getYear()  == d.getYear())  &&
-		    (getName()  == d.getName())) {
-			return true;	
-		}  
-
-	} catch (exception &e) {
-		cout << "Exception: " << e.what() << endl;
-	}
-	return false;
+	// Equal sort keys mean equal fields, without RTTI.
+	return sameKey (the_other);
 }
 
+
+//---------------------buildKey---------------------------------------
+/**
+ * @brief Builds the sort key of this Dvd from its type followed by 
+ *	  the title, year and director.
+ *
+ * Preconditions: The data members have been initialized.
+ *
+ * Postconditions: The sort key of this Dvd was set.
+ */
+void Dvd::buildKey ()
+{
+	string key (1, getType ());
+	appendKey (key, getTitle ());
+	appendKey (key, getYear ());
+	appendKey (key, getName ());
+	setSortKey (key);
+}
@@ -69,10 +69,10 @@ public:
 	 * @param name  The name of the Dvd.	
  	 * @param title The title of the Dvd.
 	 * @param year  The year of the Dvd.
-	 * @param count The occurence count of this Dvd.
+	 * @param count The occurrence count of this Dvd.
 	 */
-	Dvd (char type, string name, string title, 
-					int year, int count);
+	Dvd (char type, const InternedString &name, 
+			const InternedString &title, int year, int count);
 
 	
 	//---------------------Destructor-----------------------------
@@ -107,19 +107,35 @@ public:
 	/**
 	 * @brief Returns a pointer to a new instance of a Dvd object.
 	 *	  The data of the object will be set using the 
-	 *	  provided file stream.
+	 *	  provided line.
 	 *
-	 * Preconditions: The file stream is open and correctly
+	 * Preconditions: The line is correctly
  	 *		  formatted according to Lab 4 specifications.
 	 *
 	 * Postconditions: A pointer to a new Dvd obect is returned.
 	 *		   The data of the object is set using the
- 	 *		   provided file stream.
+ 	 *		   provided line.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return Returns a pointer to a new Dvd object.
 	 */
-	virtual Dvd * getNewInstance (ifstream &input) const; 
+	virtual Dvd * getNewInstance (FieldReader &input) const; 
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new Dvd, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a Dvd saved by save.
+	 *
+	 * Postconditions: A new Dvd was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Dvd * getNewInstance (SnapshotReader &input) const;
 
 
 	//---------------------clone----------------------------------
@@ -171,6 +187,22 @@ public:
 	 *	   false otherwise.
  	 */
 	virtual bool operator== (const Object &the_other) const; 
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------buildKey-------------------------------
+	/**
+	 * @brief Builds the sort key of this Dvd from its type 
+	 *	  followed by the title, year and director.
+	 *
+	 * Preconditions: The data members have been initialized.
+	 *
+	 * Postconditions: The sort key of this Dvd was set.
+	 */
+	void buildKey ();
 };
 #endif /* _Dvd_H */
 
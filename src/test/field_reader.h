@@ -0,0 +1,355 @@
+/**
+ * @file field_reader.h
+ *
+ * @brief A class to represent a FieldReader. A FieldReader walks the
+ *	  fields of one line of an input file, in place. The line
+ *	  is not copied: fields are returned as Fields, which point
+ *	  into the bytes of the line, and numbers are read straight
+ *	  from those bytes.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows reading a character, a number, a field up to a
+ *	  delimiter, or the rest of the line.
+ *	- Allows walking a run of several lines a line at a time.
+ *	- Allows skipping characters and looking at the next one.
+ *
+ * Assumptions:
+ *	- The bytes of the line stay valid and unchanged while the
+ *	  FieldReader, or any Field it returned, is in use.
+ *	- Reading past the end of the line is harmless. The reader
+ *	  then returns empty fields, zeros and '\0'.
+ */
+//--------------------------------------------------------------------
+
+#ifndef FIELD_READER_H
+#define FIELD_READER_H
+
+#include <string>
+#include <cctype>
+#include <cstring>
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class Field
+ *
+ * @brief A run of bytes inside a line. Copied into a string only
+ *	  when an object needs to keep it.
+ */
+struct Field {
+
+	/**
+	 * @brief The first byte of the field.
+	 */
+	const char *data;
+
+	/**
+	 * @brief The number of bytes in the field.
+	 */
+	int length;
+
+	//---------------------toString-------------------------------
+	/**
+	 * @brief Returns a copy of the field.
+	 *
+	 * Preconditions: The line of the field is still valid.
+	 *
+	 * Postconditions: The bytes of the field were returned.
+	 *
+	 * @return The field as a string.
+	 */
+	string toString () const
+	{
+		return string (data, length);
+	}
+
+
+	//---------------------operator==-----------------------------
+	/**
+	 * @brief Compares the bytes of two fields.
+	 *
+	 * Preconditions: The lines of both fields are still valid.
+	 *
+	 * Postconditions: True was returned if the bytes are equal.
+	 *
+	 * @param the_other The other field.
+	 * @return True if equal, false otherwise.
+	 */
+	bool operator== (const Field &the_other) const
+	{
+		return length == the_other.length &&
+		       memcmp (data, the_other.data, length) == 0;
+	}
+};
+
+
+/**
+ * @class FieldReader
+ */
+class FieldReader {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a FieldReader over an empty line.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This FieldReader is at the end of the line.
+	 */
+	FieldReader ()
+	{
+		my_position = my_end = "";
+	}
+
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a FieldReader over the provided bytes.
+	 *
+	 * Preconditions: begin <= end, and the bytes stay valid while
+	 *		  this FieldReader is used.
+	 *
+	 * Postconditions: This FieldReader is at the start of the line.
+	 *
+	 * @param begin The first byte of the line.
+	 * @param end One past the last byte of the line.
+	 */
+	FieldReader (const char *begin, const char *end)
+	{
+		my_position = begin;
+		my_end      = end;
+	}
+
+
+	//---------------------peek-----------------------------------
+	/**
+	 * @brief Returns the next character without reading it.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The next character, or '\0' at the end of
+	 *		   the line, was returned.
+	 *
+	 * @return The next character.
+	 */
+	char peek () const
+	{
+		return (my_position < my_end) ? *my_position : '\0';
+	}
+
+
+	//---------------------skip-----------------------------------
+	/**
+	 * @brief Skips the provided number of characters.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: Up to count characters have been skipped.
+	 *
+	 * @param count The number of characters to skip.
+	 */
+	void skip (int count)
+	{
+		my_position = (my_end - my_position > count) ?
+			      my_position + count : my_end;
+	}
+
+
+	//---------------------readChar-------------------------------
+	/**
+	 * @brief Skips white space and reads one character.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The character, or '\0' at the end of the
+	 *		   line, was returned.
+	 *
+	 * @return The character read.
+	 */
+	char readChar ()
+	{
+		skipSpace ();
+		return (my_position < my_end) ? *my_position++ : '\0';
+	}
+
+
+	//---------------------readInt--------------------------------
+	/**
+	 * @brief Skips white space and reads a decimal number.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number was read into value and true was
+	 *		   returned. If there is no number, value is 0
+	 *		   and false was returned.
+	 *
+	 * @param value The number read.
+	 * @return True if a number was read, false otherwise.
+	 */
+	bool readInt (int &value)
+	{
+		long long number;
+		bool read = readLong (number);
+
+		value = (int)number;
+		return read;
+	}
+
+
+	//---------------------readLong-------------------------------
+	/**
+	 * @brief Skips white space and reads a decimal number.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number was read into value and true was
+	 *		   returned. If there is no number, value is 0
+	 *		   and false was returned.
+	 *
+	 * @param value The number read.
+	 * @return True if a number was read, false otherwise.
+	 */
+	bool readLong (long long &value)
+	{
+		bool negative = false;
+		const char *start;
+
+		skipSpace ();
+		if (my_position < my_end &&
+		    (*my_position == '-' || *my_position == '+'))
+			negative = (*my_position++ == '-');
+
+		value = 0;
+		start = my_position;
+		while (my_position < my_end &&
+		       isdigit ((unsigned char)*my_position))
+			value = value * 10 + (*my_position++ - '0');
+		if (negative) value = -value;
+		return my_position != start;
+	}
+
+
+	//---------------------readField------------------------------
+	/**
+	 * @brief Reads up to the provided delimiter, which is read
+	 *	  too but is not part of the field.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The field, or the rest of the line if there
+	 *		   is no delimiter, was returned.
+	 *
+	 * @param delimiter The character that ends the field.
+	 * @return The field read.
+	 */
+	Field readField (char delimiter)
+	{
+		Field field;
+
+		field.data = my_position;
+		while (my_position < my_end && *my_position != delimiter)
+			my_position++;
+		field.length = (int)(my_position - field.data);
+		if (my_position < my_end) my_position++;
+		return field;
+	}
+
+
+	//---------------------readLine-------------------------------
+	/**
+	 * @brief Reads up to the next end of line, which is read too
+	 *	  but is not part of the line.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: If anything was left, line walks the next
+	 *		   line and true was returned. Otherwise false
+	 *		   was returned.
+	 *
+	 * @param line Set to walk the line read.
+	 * @return True if a line was read, false at the end.
+	 */
+	bool readLine (FieldReader &line)
+	{
+		const char *end;
+
+		if (my_position >= my_end) return false;
+		end = (const char *)memchr (my_position, '\n',
+					    my_end - my_position);
+		if (end == NULL) end = my_end;
+		line = FieldReader (my_position, end);
+		my_position = (end < my_end) ? end + 1 : end;
+		return true;
+	}
+
+
+	//---------------------readRest-------------------------------
+	/**
+	 * @brief Reads the rest of the line.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The rest of the line was returned, and this
+	 *		   FieldReader is at its end.
+	 *
+	 * @return The rest of the line.
+	 */
+	Field readRest ()
+	{
+		Field field;
+
+		field.data   = my_position;
+		field.length = (int)(my_end - my_position);
+		my_position  = my_end;
+		return field;
+	}
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------skipSpace------------------------------
+	/**
+	 * @brief Skips white space.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This FieldReader is at the end of the line
+	 *		   or at a character that is not white space.
+	 */
+	void skipSpace ()
+	{
+		while (my_position < my_end &&
+		       isspace ((unsigned char)*my_position))
+			my_position++;
+	}
+
+	/**
+	 * @brief The next byte to read.
+	 */
+	const char *my_position;
+
+	/**
+	 * @brief One past the last byte of the line.
+	 */
+	const char *my_end;
+};
+#endif /* FIELD_READER_H */
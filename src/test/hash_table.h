@@ -1,150 +1,1087 @@
 /*
- * @file hash_table.cpp
- * 
- * @brief This class implements a hashtable, which maps char keys to 
- *	  values. Any non NULL Objects can be used as a value.
+ * @file hash_table.h
+ *
+ * @brief This class implements a hashtable, which maps keys of any
+ *	  type to values of any type. The table is laid out as a
+ *	  Swiss table: next to the slots is an array of control
+ *	  bytes, one per slot, that says whether the slot is empty,
+ *	  deleted, or full, and holds 7 bits of the hash of a full
+ *	  slot's key. Slots are probed in groups of 16, and all 16
+ *	  control bytes of a group are compared with one SSE2
+ *	  instruction, so most lookups compare a single key.
  *
  * @brief CSS 343 - Lab 4
  *
- * @author John Steele  \<steelejr@u.washington.edu\> 
- *  
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
  * @version 1.0.0
  * @date December 5, 2010
- */ 
+ */
 //--------------------------------------------------------------------
 /**
  * Includes following features:
- * 	- Allows creating a HashTable with a specified size.
- * 	- Allows adding an key / value pair.
- *	- Allows getting the value of associated with a specific key.
+ * 	- Allows adding a key / value pair.
+ *	- Allows getting the value associated with a specific key.
+ *	- Allows removing a key. A removed slot is marked empty
+ *	  whenever its group still has an empty slot, and tables
+ *	  whose deleted slots pile up are rebuilt at the same size,
+ *	  so removals do not slow down later lookups.
  *	- Allows making the hashtable empty.
- * 
+ *	- Allows walking the entries with an Iterator.
+ *	- Allows growing incrementally. In that mode a resize keeps
+ *	  the old arrays beside the new ones and every add and
+ *	  remove moves one group of old slots over, so no single
+ *	  call pays for copying the whole table.
+ *	- Hashes integral keys and strings out of the box. Composite
+ *	  keys can be flattened into a string, such as the sort key
+ *	  of an Item, or hashed by a custom Hasher.
+ *
  * Assumptions:
- * 	- The objects stored in the hashtable are non-NULL.
+ * 	- Keys are comparable with ==, and Keys and Values have a
+ *	  default constructor and can be copied.
  */
 //--------------------------------------------------------------------
 #ifndef HASH_TABLE_H
 #define HASH_TABLE_H
 
 #include <iostream>
-#include <vector>
-#include "purchase_transaction.h"
+#include <string>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 /**
  * @namespace std
  */
 using namespace std;
 
+
+/**
+ * @class HashCode
+ *
+ * @brief Hashes integral keys, and anything that converts to one.
+ */
+template <class Key>
+struct HashCode {
+
+	//---------------------operator()-----------------------------
+	/**
+	 * @brief Returns the hash code for the provided key.
+	 *
+	 * Preonditions: None.
+	 *
+	 * Postconditions: A hash code was returned.
+	 *
+	 * @param key The key to hash.
+	 * @return The hash code for the key.
+	 */
+	unsigned long long operator() (const Key &key) const
+	{
+		return mix ((unsigned long long)key);
+	}
+
+
+	//---------------------mix------------------------------------
+	/**
+	 * @brief Spreads every bit of the provided value over the
+	 *	  whole hash code, so close keys get unrelated codes.
+	 *
+	 * Preonditions: None.
+	 *
+	 * Postconditions: The mixed value was returned.
+	 *
+	 * @param value The value to mix.
+	 * @return The mixed value.
+	 */
+	static unsigned long long mix (unsigned long long value)
+	{
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdULL;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ULL;
+		value ^= value >> 33;
+		return value;
+	}
+};
+
+
+/**
+ * @class HashCode<string>
+ *
+ * @brief Hashes strings, including the byte sort keys of Items.
+ */
+template <>
+struct HashCode<string> {
+
+	//---------------------operator()-----------------------------
+	/**
+	 * @brief Returns the hash code for the provided key.
+	 *
+	 * Preonditions: None.
+	 *
+	 * Postconditions: A hash code was returned.
+	 *
+	 * @param key The key to hash.
+	 * @return The hash code for the key.
+	 */
+	unsigned long long operator() (const string &key) const
+	{
+		unsigned long long hash = 14695981039346656037ULL;
+
+		// FNV-1a over the bytes, then mixed for the low bits.
+		for (string::size_type i = 0; i < key.size (); i++) {
+			hash ^= (unsigned char)key [i];
+			hash *= 1099511628211ULL;
+		}
+		return HashCode<unsigned long long>::mix (hash);
+	}
+};
+
+
 /**
  * @class HashTable
  */
+template <class Key, class Value, class Hasher = HashCode<Key> >
 class HashTable {
 
 /**
- * @public 
+ * @public
  */
 public:
 
+	/**
+	 * @brief Walks the entries of the table in slot order.
+	 */
+	class Iterator;
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates an empty hashtable with a default capacity.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This hashtable was created empty.
+	 */
+	HashTable ()
+	{
+		my_incremental = false;
+		init (MIN_CAPACITY);
+	}
+
+
 	//---------------------Constructor----------------------------
 	/**
-	 * @brief Creates a hashtable with a default capacity.
+	 * @brief Creates an empty hashtable with a default capacity
+	 *	  that, if incremental is true, moves its entries
+	 *	  over a few at a time when it is resized.
 	 *
 	 * Preconditions: None.
-	 * 
-	 * Postconditions: This hashtable was created with the default
-	 *		   size.
+	 *
+	 * Postconditions: This hashtable was created empty.
+	 *
+	 * @param incremental True to resize incrementally.
 	 */
-	HashTable ();
+	explicit HashTable (bool incremental)
+	{
+		my_incremental = incremental;
+		init (MIN_CAPACITY);
+	}
 
 
-	//---------------------put------------------------------------
+	//---------------------Copy-Constructor-----------------------
 	/**
-	 * @brief Maps the specified key to the specified value in 	
- 	 *	  this hashtable. Neither the key or the value can be
-	 *	  NULL.
+	 * @brief Copies the other hashtable into this one.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This holds the other's entries.
+	 *
+	 * @param the_other The hashtable to copy.
+	 */
+	HashTable (const HashTable &the_other)
+	{
+		my_incremental = the_other.my_incremental;
+		init (MIN_CAPACITY);
+		*this = the_other;
+	}
+
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Deallocates all dynamic memory obtained by this
+	 * 	  hashtable. Values that are pointers are not deleted.
+	 *
+ 	 * Preconditions: None.
+	 *
+	 * Postconditions: All dynamic memory has been released.
+	 */
+	~HashTable ()
+	{
+		delete [] my_control;
+		delete [] my_slots;
+		delete [] my_old_control;
+		delete [] my_old_slots;
+	}
+
+
+	//---------------------operator(=)----------------------------
+	/**
+	 * @brief Overloaded assignment operator.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: the_other is copied into this.
+	 *
+	 * @param the_other The other hashtable to copy into this.
+	 * @return this is returned.
+	 */
+	const HashTable & operator= (const HashTable &the_other)
+	{
+		if (this != &the_other) {
+			delete [] my_control;
+			delete [] my_slots;
+			delete [] my_old_control;
+			delete [] my_old_slots;
+			init (the_other.my_capacity);
+
+			// Entries still in the other's old arrays land in
+			// the new ones here, so the copy is not resizing.
+			for (Iterator it = the_other.begin ();
+			     it != the_other.end (); ++it)
+				place (my_hasher (it.getKey ()), it.getKey (),
+				       it.getValue ());
+			my_size = the_other.my_size;
+		}
+		return *this;
+	}
+
+
+	//---------------------add------------------------------------
+	/**
+	 * @brief Maps the specified key to the specified value in
+ 	 *	  this hashtable, replacing the value it was mapped
+	 *	  to if any.
+	 *
+	 * Preconditions: None.
+	 *
+ 	 * Postconditions: The key is mapped to the value. True was
+	 *		   returned if the key is new, false otherwise.
 	 *
-	 * Preconditions: The key is valid.
-	 * 	
- 	 * Postconditions: The value was added to this hashtable.
-	 * 	
  	 * @param key The hashtable key.
 	 * @param value The value to insert.
+	 * @return True if the key was added, false if replaced.
+	 */
+	bool add (const Key &key, const Value &value)
+	{
+		unsigned long long hash = my_hasher (key);
+		int slot;
+
+		if (my_old_control != NULL) migrate (GROUP_SIZE);
+		slot = find (key, hash);
+		if (slot >= 0) {
+			my_slots [slot].value = value;
+			return false;
+		}
+		slot = findOld (key, hash);
+		if (slot >= 0) {
+			my_old_slots [slot].value = value;
+			return false;
+		}
+
+		// Keep at least one slot in eight empty.
+		if ((my_size + my_deleted + 1) * 8 > my_capacity * 7) {
+			// Mostly deleted slots, so rebuild at this size.
+			if ((my_size + 1) * 16 <= my_capacity * 7)
+				rehash (my_capacity);
+			else
+				rehash (my_capacity * 2);
+		}
+
+		place (hash, key, value);
+		my_size++;
+		return true;
+	}
+
+
+	//---------------------get------------------------------------
+	/**
+	 * @brief Retuns a pointer to the value which the specified
+	 *	  key is mapped in this hashtable.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: A pointer to the value was returned. It is
+	 *		   valid until the table is next changed.
+	 *
+	 * @param key A key in the hashtable.
+	 * @return The value to which the key is mapped in this
+	 *	   hashtable; NULL if the key is not mapped to any
+	 *	   value in this hashtable.
 	 */
-	void add (char key, Object *value);
+	Value * get (const Key &key)
+	{
+		unsigned long long hash = my_hasher (key);
+		int slot = find (key, hash);
+
+		if (slot >= 0) return &my_slots [slot].value;
+		slot = findOld (key, hash);
+		return (slot >= 0) ? &my_old_slots [slot].value : NULL;
+	}
+
 
-	
 	//---------------------get------------------------------------
 	/**
 	 * @brief Retuns a pointer to the value which the specified
 	 *	  key is mapped in this hashtable.
 	 *
-	 * Preconditions: The key is valid.
+	 * Preconditions: None.
 	 *
-	 * Postconditions: A pointer to the value was returned.
+	 * Postconditions: A pointer to the value was returned. It is
+	 *		   valid until the table is next changed.
 	 *
 	 * @param key A key in the hashtable.
-	 * @return The value to which the key is mapped in this 
-	 *	   hashtable; NULL if the key is not mapped to any 
+	 * @return The value to which the key is mapped in this
+	 *	   hashtable; NULL if the key is not mapped to any
 	 *	   value in this hashtable.
 	 */
-	Object * get (char key) const; 
+	const Value * get (const Key &key) const
+	{
+		unsigned long long hash = my_hasher (key);
+		int slot = find (key, hash);
+
+		if (slot >= 0) return &my_slots [slot].value;
+		slot = findOld (key, hash);
+		return (slot >= 0) ? &my_old_slots [slot].value : NULL;
+	}
+
+
+	//---------------------remove---------------------------------
+	/**
+	 * @brief Removes the specified key from this hashtable. The
+	 *	  slot is marked empty if its group has an empty slot,
+	 *	  since no search goes past such a group. Otherwise it
+	 *	  is marked deleted so searches keep going. Slots in
+	 *	  the old arrays are always marked deleted.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the key was mapped and
+	 *		   has been removed, false otherwise.
+	 *
+	 * @param key The key to remove.
+	 * @return True if removed, false otherwise.
+	 */
+	bool remove (const Key &key)
+	{
+		unsigned long long hash = my_hasher (key);
+		int slot;
+
+		if (my_old_control != NULL) migrate (GROUP_SIZE);
+		slot = find (key, hash);
+		if (slot < 0) {
+			slot = findOld (key, hash);
+			if (slot < 0) return false;
+			my_old_control [slot] = DELETED;
+			my_old_slots [slot]   = Slot ();
+			my_size--;
+			return true;
+		}
+
+		if (matchEmpty (my_control, slot / GROUP_SIZE) != 0)
+			my_control [slot] = EMPTY;
+		else {
+			my_control [slot] = DELETED;
+			my_deleted++;
+		}
+		// Let go of whatever the key and value hold on to.
+		my_slots [slot] = Slot ();
+		my_size--;
+		return true;
+	}
+
+
+	//---------------------makeEmpty------------------------------
+	/**
+	 * @brief Empties this hashtable and shrinks it back to the
+	 *	  default capacity. Values that are pointers are not
+	 *	  deleted.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The hashtable is empty.
+	 */
+	void makeEmpty ()
+	{
+		delete [] my_control;
+		delete [] my_slots;
+		delete [] my_old_control;
+		delete [] my_old_slots;
+		init (MIN_CAPACITY);
+	}
+
+
+	//---------------------getSize--------------------------------
+	/**
+	 * @brief Returns the number of keys in this hashtable.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number of keys was returned.
+	 *
+	 * @return The number of keys.
+	 */
+	int getSize () const
+	{
+		return my_size;
+	}
+
+
+	//---------------------begin----------------------------------
+	/**
+	 * @brief Returns an Iterator at the first entry.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: An Iterator at the first entry, or end() if
+	 *		   the table is empty, was returned. Entries still
+	 *		   in the old arrays come after the others.
+	 *
+	 * @return An Iterator at the first entry.
+	 */
+	Iterator begin () const
+	{
+		return Iterator (this, 0);
+	}
+
+
+	//---------------------end------------------------------------
+	/**
+	 * @brief Returns the past-the-end Iterator.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The past-the-end Iterator was returned.
+	 *
+	 * @return The past-the-end Iterator.
+	 */
+	Iterator end () const
+	{
+		return Iterator (this, my_capacity + my_old_capacity);
+	}
 
 /**
  * @private
  */
 private:
 
-	//---------------------hashCode-------------------------------
+	friend class Iterator;
+
 	/**
-	 * @brief Returns the hash code for the provided key.
-	 * 
-	 * Preonditions: None.
-	 * 
-	 * Postconditions: A hash code was returned.
-	 * 
-	 * @param key The key to hash.
-	 * @return The hash code for the key.
-	 */	
-	int hashCode (char key) const;
+	 * @brief Control byte values, and the slots in a group. Full
+	 *	  slots hold the low 7 bits of their hash, which are
+	 *	  never negative.
+	 */
+	enum {
+		EMPTY        = -128,
+		DELETED      = -2,
+		H2_MASK      = 0x7f,
+		GROUP_SIZE   = 16,
+		MIN_CAPACITY = 16
+	};
+
+	/**
+	 * @brief A hashtable entry.
+	 */
+	struct Slot {
+		Key   key;
+		Value value;
+	};
+
+
+	//---------------------init-----------------------------------
+	/**
+	 * @brief Allocates empty arrays of the provided capacity.
+	 *
+	 * Preconditions: capacity is a power of two and at least
+	 *		  GROUP_SIZE.
+	 *
+	 * Postconditions: The table is empty with that capacity and
+	 *		   has no old arrays.
+	 *
+	 * @param capacity The number of slots.
+	 */
+	void init (int capacity)
+	{
+		my_capacity     = capacity;
+		my_size         = 0;
+		my_deleted      = 0;
+		my_control      = new signed char [capacity];
+		my_slots        = new Slot [capacity];
+		my_old_control  = NULL;
+		my_old_slots    = NULL;
+		my_old_capacity = 0;
+		my_migrated     = 0;
+		for (int i = 0; i < capacity; i++)
+			my_control [i] = EMPTY;
+	}
+
+
+	//---------------------find-----------------------------------
+	/**
+	 * @brief Returns the slot of the specified key in the current
+	 *	  arrays.
+	 *
+	 * Preconditions: hash is the hash code of key.
+	 *
+	 * Postconditions: The slot of the key, or -1 if it is not
+	 *		   there, was returned.
+	 *
+	 * @param key The key to find.
+	 * @param hash The hash code of the key.
+	 * @return The slot of the key, or -1.
+	 */
+	int find (const Key &key, unsigned long long hash) const
+	{
+		return probe (my_control, my_slots, my_capacity, key, hash);
+	}
+
+
+	//---------------------findOld--------------------------------
+	/**
+	 * @brief Returns the slot of the specified key in the old
+	 *	  arrays, if a resize is under way.
+	 *
+	 * Preconditions: hash is the hash code of key.
+	 *
+	 * Postconditions: The slot of the key, or -1 if it is not
+	 *		   there, was returned.
+	 *
+	 * @param key The key to find.
+	 * @param hash The hash code of the key.
+	 * @return The slot of the key, or -1.
+	 */
+	int findOld (const Key &key, unsigned long long hash) const
+	{
+		if (my_old_control == NULL) return -1;
+		return probe (my_old_control, my_old_slots, my_old_capacity,
+			      key, hash);
+	}
+
+
+	//---------------------probe----------------------------------
+	/**
+	 * @brief Returns the slot of the specified key in the provided
+	 *	  arrays. Groups are visited in triangular order from
+	 *	  the group picked by the hash, which reaches every
+	 *	  group, until one with an empty slot has been checked.
+	 *
+	 * Preconditions: hash is the hash code of key, and the arrays
+	 *		  have capacity slots.
+	 *
+	 * Postconditions: The slot of the key, or -1 if it is not
+	 *		   there, was returned.
+	 *
+	 * @param control The control bytes.
+	 * @param slots The slots.
+	 * @param capacity The number of slots.
+	 * @param key The key to find.
+	 * @param hash The hash code of the key.
+	 * @return The slot of the key, or -1.
+	 */
+	static int probe (const signed char *control, const Slot *slots,
+			  int capacity, const Key &key,
+			  unsigned long long hash)
+	{
+		int mask  = capacity / GROUP_SIZE - 1;
+		int group = (int)(hash >> 7) & mask;
+		unsigned int bits;
+		int slot;
+
+		for (int step = 1; ; step++) {
+			// Only compare keys whose hash bits match.
+			bits = matchByte (control, group,
+					  (signed char)(hash & H2_MASK));
+			while (bits != 0) {
+				slot = group * GROUP_SIZE + lowestBit (bits);
+				if (slots [slot].key == key) return slot;
+				bits &= bits - 1;
+			}
+			if (matchEmpty (control, group) != 0) return -1;
+			group = (group + step) & mask;
+		}
+	}
+
+
+	//---------------------findFree-------------------------------
+	/**
+	 * @brief Returns the first empty or deleted slot along the
+	 *	  probe sequence of the provided hash.
+	 *
+	 * Preconditions: The table has an empty slot.
+	 *
+	 * Postconditions: A free slot was returned.
+	 *
+	 * @param hash The hash code of the key being placed.
+	 * @return A free slot.
+	 */
+	int findFree (unsigned long long hash) const
+	{
+		int mask  = my_capacity / GROUP_SIZE - 1;
+		int group = (int)(hash >> 7) & mask;
+		unsigned int bits;
+
+		for (int step = 1; ; step++) {
+			bits = matchFree (my_control, group);
+			if (bits != 0)
+				return group * GROUP_SIZE + lowestBit (bits);
+			group = (group + step) & mask;
+		}
+	}
 
 
-	//---------------------resize---------------------------------
+	//---------------------place--------------------------------
 	/**
-	 * @brief Creates a bigger array and copies over the data.
+	 * @brief Stores the key and value in a free slot of the
+	 *	  current arrays. Does not count the entry.
 	 *
- 	 * Preconditions: size is bigger than my_size.
-	 * 
-	 * Postconditions: my_array has been increased to size, and
- 	 * 		   the data has been copied over. 
+	 * Preconditions: hash is the hash code of key, the key is not
+	 *		  in the table, and the current arrays have an
+	 *		  empty slot.
+	 *
+	 * Postconditions: The key and value are in the current arrays.
+	 *
+	 * @param hash The hash code of the key.
+	 * @param key The key to store.
+	 * @param value The value to store.
 	 */
-	void makeBigger (int size);
+	void place (unsigned long long hash, const Key &key,
+		    const Value &value)
+	{
+		int slot = findFree (hash);
+
+		if (my_control [slot] == DELETED) my_deleted--;
+		my_control [slot]     = (signed char)(hash & H2_MASK);
+		my_slots [slot].key   = key;
+		my_slots [slot].value = value;
+	}
+
+
+	//---------------------rehash---------------------------------
+	/**
+	 * @brief Moves the entries into new arrays of the provided
+	 *	  capacity, which drops all deleted markers. An
+	 *	  incremental table only sets the current arrays aside
+	 *	  as the old ones, and migrate moves the entries later.
+	 *
+	 * Preconditions: capacity is a power of two that can hold
+	 *		  every entry.
+	 *
+	 * Postconditions: The table has the new capacity and no
+	 *		   deleted slots.
+	 *
+	 * @param capacity The new number of slots.
+	 */
+	void rehash (int capacity)
+	{
+		int size = my_size;
+
+		// Rarely, the last resize has not finished yet.
+		if (my_old_control != NULL) migrate (my_old_capacity);
 
+		signed char *old_control  = my_control;
+		Slot        *old_slots    = my_slots;
+		int          old_capacity = my_capacity;
 
-	//---------------------init_table-----------------------------
+		init (capacity);
+		my_size         = size;
+		my_old_control  = old_control;
+		my_old_slots    = old_slots;
+		my_old_capacity = old_capacity;
+		if (!my_incremental) migrate (my_old_capacity);
+	}
+
+
+	//---------------------migrate--------------------------------
 	/**
-	 * @brief Initializes the values of the table. 
+	 * @brief Moves the entries of up to the provided number of
+	 *	  old slots into the current arrays, in slot order.
+	 *	  Moved slots are marked deleted so that searches of
+	 *	  the old arrays go on past them. Once every old slot
+	 *	  is moved the old arrays are released.
+	 *
+	 * Preconditions: A resize is under way.
 	 *
-	 * Preconditions: my_size is the size of the table array.
+	 * Postconditions: Up to count more old slots have been moved.
 	 *
-	 * Postconditions: The values of each index have been 
- 	 *		   initialized.
+	 * @param count The number of old slots to move.
 	 */
-	void init_table();
+	void migrate (int count)
+	{
+		int last = my_migrated + count;
+
+		if (last > my_old_capacity) last = my_old_capacity;
+		for (; my_migrated < last; my_migrated++) {
+			if (my_old_control [my_migrated] < 0) continue;
+			Slot &old = my_old_slots [my_migrated];
+			place (my_hasher (old.key), old.key, old.value);
+			my_old_control [my_migrated] = DELETED;
+			old = Slot ();
+		}
+
+		if (my_migrated == my_old_capacity) {
+			delete [] my_old_control;
+			delete [] my_old_slots;
+			my_old_control  = NULL;
+			my_old_slots    = NULL;
+			my_old_capacity = 0;
+			my_migrated     = 0;
+		}
+	}
+
 
+	//---------------------matchByte------------------------------
 	/**
-	 * @brief The size of the array. 
+	 * @brief Returns a bit mask of the slots in a group whose
+	 *	  control byte equals the provided byte.
+	 *
+	 * Preconditions: group is a valid group index.
+	 *
+	 * Postconditions: Bit i is set if slot i of the group matches.
+	 *
+	 * @param control The control bytes of the table.
+	 * @param group The group index.
+	 * @param byte The control byte to look for.
+	 * @return The bit mask of matching slots.
+	 */
+	static unsigned int matchByte (const signed char *control,
+				       int group, signed char byte)
+	{
+		control += group * GROUP_SIZE;
+#ifdef __SSE2__
+		__m128i bytes = _mm_loadu_si128 ((const __m128i *)control);
+		return _mm_movemask_epi8 (_mm_cmpeq_epi8 (bytes,
+						_mm_set1_epi8 (byte)));
+#else
+		unsigned int bits = 0;
+		for (int i = 0; i < GROUP_SIZE; i++)
+			if (control [i] == byte) bits |= 1u << i;
+		return bits;
+#endif
+	}
+
+
+	//---------------------matchEmpty-----------------------------
+	/**
+	 * @brief Returns a bit mask of the empty slots in a group.
+	 *
+	 * Preconditions: group is a valid group index.
+	 *
+	 * Postconditions: Bit i is set if slot i of the group is
+	 *		   empty.
+	 *
+	 * @param control The control bytes of the table.
+	 * @param group The group index.
+	 * @return The bit mask of empty slots.
+	 */
+	static unsigned int matchEmpty (const signed char *control,
+					int group)
+	{
+		return matchByte (control, group, (signed char)EMPTY);
+	}
+
+
+	//---------------------matchFree------------------------------
+	/**
+	 * @brief Returns a bit mask of the empty or deleted slots in
+	 *	  a group, which are exactly those with a negative
+	 *	  control byte.
+	 *
+	 * Preconditions: group is a valid group index.
+	 *
+	 * Postconditions: Bit i is set if slot i of the group is free.
+	 *
+	 * @param control The control bytes of the table.
+	 * @param group The group index.
+	 * @return The bit mask of free slots.
+	 */
+	static unsigned int matchFree (const signed char *control,
+				       int group)
+	{
+		control += group * GROUP_SIZE;
+#ifdef __SSE2__
+		return _mm_movemask_epi8 (_mm_loadu_si128
+						((const __m128i *)control));
+#else
+		unsigned int bits = 0;
+		for (int i = 0; i < GROUP_SIZE; i++)
+			if (control [i] < 0) bits |= 1u << i;
+		return bits;
+#endif
+	}
+
+
+	//---------------------lowestBit------------------------------
+	/**
+	 * @brief Returns the index of the lowest set bit.
+	 *
+	 * Preconditions: bits is not zero.
+	 *
+	 * Postconditions: The index of the lowest set bit was returned.
+	 *
+	 * @param bits The bit mask.
+	 * @return The index of its lowest set bit.
+	 */
+	static int lowestBit (unsigned int bits)
+	{
+#ifdef __GNUC__
+		return __builtin_ctz (bits);
+#else
+		int index = 0;
+		while ((bits & 1u) == 0) {
+			bits >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+
+
+	/**
+	 * @brief One control byte per slot.
+	 */
+	signed char *my_control;
+
+	/**
+	 * @brief The hashtable array.
+	 */
+	Slot *my_slots;
+
+	/**
+	 * @brief The number of slots, a power of two that is at least
+	 *	  one group.
+	 */
+	int my_capacity;
+
+	/**
+	 * @brief The number of entries, including any still in the
+	 *	  old arrays.
 	 */
 	int my_size;
-	
+
+	/**
+	 * @brief The number of deleted slots in the current arrays.
+	 */
+	int my_deleted;
+
+	/**
+	 * @brief The control bytes being moved out of during an
+	 *	  incremental resize, otherwise NULL.
+	 */
+	signed char *my_old_control;
+
+	/**
+	 * @brief The slots being moved out of, otherwise NULL.
+	 */
+	Slot *my_old_slots;
+
+	/**
+	 * @brief The number of old slots, 0 if there are none.
+	 */
+	int my_old_capacity;
+
 	/**
-	 * @brief The array of stored objects.
-	 */	
-	Object **my_array;
+	 * @brief The number of old slots already moved.
+	 */
+	int my_migrated;
 
 	/**
-  	 * @brief Default size of table array.
+	 * @brief True if resizes move the entries a group at a time.
 	 */
-	const static int DEFAULT_SIZE = 10;
+	bool my_incremental;
+
+	/**
+	 * @brief Hashes the keys.
+	 */
+	Hasher my_hasher;
 };
-#endif
 
+
+/**
+ * @class HashTable::Iterator
+ *
+ * @brief Walks the entries of a HashTable in slot order. Adding to or
+ *	  removing from the table invalidates its Iterators.
+ */
+template <class Key, class Value, class Hasher>
+class HashTable<Key, Value, Hasher>::Iterator {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------getKey---------------------------------
+	/**
+	 * @brief Returns the key of the current entry.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: The key was returned.
+	 *
+	 * @return The current key.
+	 */
+	const Key & getKey () const
+	{
+		return slot ().key;
+	}
+
+
+	//---------------------getValue-------------------------------
+	/**
+	 * @brief Returns the value of the current entry.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: The value was returned.
+	 *
+	 * @return The current value.
+	 */
+	const Value & getValue () const
+	{
+		return slot ().value;
+	}
+
+
+	//---------------------operator++-----------------------------
+	/**
+	 * @brief Moves to the next entry.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: This Iterator is at the next entry, or past
+	 *		   the end.
+	 *
+	 * @return This Iterator.
+	 */
+	Iterator & operator++ ()
+	{
+		my_slot++;
+		skipFree ();
+		return *this;
+	}
+
+
+	//---------------------operator==-----------------------------
+	/**
+	 * @brief Compares this Iterator with the_other for equality.
+	 *
+	 * Preconditions: Both Iterators walk the same table.
+	 *
+	 * Postconditions: Returned true if both are at the same entry.
+	 *
+	 * @param the_other The other Iterator.
+	 * @return True if equal, false otherwise.
+	 */
+	bool operator== (const Iterator &the_other) const
+	{
+		return my_slot == the_other.my_slot;
+	}
+
+
+	//---------------------operator!=-----------------------------
+	/**
+	 * @brief Compares this Iterator with the_other for inequality.
+	 *
+	 * Preconditions: Both Iterators walk the same table.
+	 *
+	 * Postconditions: Returned true if they are at different
+	 *		   entries.
+	 *
+	 * @param the_other The other Iterator.
+	 * @return True if not equal, false otherwise.
+	 */
+	bool operator!= (const Iterator &the_other) const
+	{
+		return my_slot != the_other.my_slot;
+	}
+
+/**
+ * @private
+ */
+private:
+
+	friend class HashTable;
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates an Iterator at the first entry at or after
+	 *	  the provided slot. Slots past the current capacity
+	 *	  are those of the old arrays.
+	 *
+	 * Preconditions: slot is at most the current and old
+	 *		  capacities together.
+	 *
+	 * Postconditions: This Iterator is at an entry, or past the
+	 *		   end.
+	 *
+	 * @param table The table to walk.
+	 * @param slot The slot to start at.
+	 */
+	Iterator (const HashTable *table, int slot)
+	{
+		my_table = table;
+		my_slot  = slot;
+		skipFree ();
+	}
+
+
+	//---------------------skipFree-------------------------------
+	/**
+	 * @brief Moves past empty and deleted slots.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This Iterator is at a full slot, or past
+	 *		   the end.
+	 */
+	void skipFree ()
+	{
+		int capacity = my_table->my_capacity;
+		int total    = capacity + my_table->my_old_capacity;
+
+		while (my_slot < capacity && my_table->my_control [my_slot] < 0)
+			my_slot++;
+		while (my_slot >= capacity && my_slot < total &&
+		       my_table->my_old_control [my_slot - capacity] < 0)
+			my_slot++;
+	}
+
+
+	//---------------------slot-----------------------------------
+	/**
+	 * @brief Returns the current entry.
+	 *
+	 * Preconditions: This Iterator is not past the end.
+	 *
+	 * Postconditions: The current entry was returned.
+	 *
+	 * @return The current entry.
+	 */
+	const Slot & slot () const
+	{
+		if (my_slot < my_table->my_capacity)
+			return my_table->my_slots [my_slot];
+		return my_table->my_old_slots [my_slot - my_table->my_capacity];
+	}
+
+	/**
+	 * @brief The table being walked.
+	 */
+	const HashTable *my_table;
+
+	/**
+	 * @brief The current slot.
+	 */
+	int my_slot;
+};
+#endif /* HASH_TABLE_H */
@@ -26,7 +26,6 @@
 //--------------------------------------------------------------------
 
 #include "history_transaction.h"
-#include "store_manager.h"
 
 //---------------------Default-Constructor----------------------------
 /**
@@ -57,7 +56,7 @@ HistoryTransaction::HistoryTransaction () : Transaction ()
  * @param cust_id The customer ID. 
  * @param type The type of transaction. 
  */
-HistoryTransaction::HistoryTransaction (int cust_id, char type)
+HistoryTransaction::HistoryTransaction (long long cust_id, char type)
  			 : Transaction(type)
 { 
 	my_cust_id = cust_id;
@@ -81,27 +80,68 @@ HistoryTransaction::~HistoryTransaction () {}
  *	  The data of the new object will be set using the provided 
  *	  file stream.
  *	
- * Preconditions: The file stream is open and correctly formatted
+ * Preconditions: The line is correctly formatted
  *		  according to Lab 4 specs.  	
  *
  * Postconditions: A new HistoryTransaction object was created using 
  *	 	   the provided file to set its data. A pointer to 
  *		   the object was then returned.
  *
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return A pointer to the new instance. 
  */
 HistoryTransaction * HistoryTransaction::getNewInstance
-					 (ifstream &input) const
+					 (FieldReader &input) const
 {
-	int id;
+	long long id;
 	char type;	
-	input >> type; input.ignore ();
-	input >> id;   
+	type = input.readChar (); input.skip (1);
+	input.readLong (id);   
 	return new HistoryTransaction (id, type);
 }
 
 
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new HistoryTransaction, read from a snapshot 
+ *	  written by save.
+ *	
+ * Preconditions: The snapshot is at a HistoryTransaction saved by save.
+ *
+ * Postconditions: A new HistoryTransaction was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+HistoryTransaction * HistoryTransaction::getNewInstance (SnapshotReader &input) const
+{
+	long long id;
+	char type;	
+	type = input.getByte ();
+	id   = input.getLong ();
+	return new HistoryTransaction (id, type);
+}
+
+
+//---------------------save-------------------------------------------
+/**
+ * @brief Writes this HistoryTransaction to a snapshot: its type and
+ *	  customer ID.
+ *	
+ * Preconditions: A section of the snapshot is being written.
+ *
+ * Postconditions: This HistoryTransaction was written.
+ *
+ * @param output The snapshot to write to.
+ */
+void HistoryTransaction::save (SnapshotWriter &output) const
+{
+	Transaction::save (output);
+	output.putLong (my_cust_id);
+}
+
+
 //---------------------clone------------------------------------------
 /**
  * @brief Clones this Transaction.
@@ -128,23 +168,7 @@ HistoryTransaction * HistoryTransaction::clone () const
  * 
  * @return The customer ID. 
  */
-int HistoryTransaction::getCustomerId () const 
+long long HistoryTransaction::getCustomerId () const 
 {
 	return my_cust_id;
 } 
-
-
-//---------------------execute----------------------------------------
-/**
- * @brief Calls the appropriate method on the store manager.
- * 
- * Preconditions: The storemanager is not NULL.
- *
- * Postconditions: The storemanager's method has been called.
- *
- * @param mgr The store manager.
- */
-void HistoryTransaction::execute (StoreManager *mgr) const
-{
-	mgr->printHistory (my_cust_id);	
-}
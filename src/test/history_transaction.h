@@ -68,7 +68,7 @@ public:
 	 * @param cust_id The customer ID. 
 	 * @param type The type of transaction. 
 	 */
-	HistoryTransaction (int cust_id, char type);
+	HistoryTransaction (long long cust_id, char type);
 
 	
 	//---------------------Destructor-----------------------------
@@ -87,20 +87,50 @@ public:
 	/**
 	 * @brief Retuns a pointer to a new instance of a History
 	 *	  Transaction. The data of the new object will be set
-  	 *	  using the provided file stream.
+  	 *	  using the provided line.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *		  formatted according to Lab 4 specs.  	
 	 *
 	 * Postconditions: A new HistoryTransaction object was created
  	 *		   using the provided file to set its data. A
  	 *		   pointer to the object was then returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return A pointer to the new instance. 
 	 */
 	virtual HistoryTransaction * getNewInstance 
-					(ifstream &input) const;
+					(FieldReader &input) const;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new HistoryTransaction, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a HistoryTransaction saved by save.
+	 *
+	 * Postconditions: A new HistoryTransaction was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual HistoryTransaction * getNewInstance (SnapshotReader &input) const;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes this HistoryTransaction to a snapshot: 
+	 *	  its type and customer ID.
+	 *	
+ 	 * Preconditions: A section of the snapshot is being written.
+	 *
+	 * Postconditions: This HistoryTransaction was written.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	virtual void save (SnapshotWriter &output) const;
 
 
 	//---------------------clone----------------------------------
@@ -126,20 +156,8 @@ public:
 	 * 
 	 * @return The customer ID. 
 	 */
-	int getCustomerId () const; 
-
+	long long getCustomerId () const; 
 
-	//---------------------execute--------------------------------
-	/**
-	 * @brief Calls the appropriate method on the store manager.
-	 * 
-	 * Preconditions: The storemanager is not NULL.
-	 *
-	 * Postconditions: The storemanager's method has been called.
-	 *
-	 * @param mgr The store manager.
-	 */
-	virtual void execute (StoreManager *mgr) const;	
 
 /**
  * @private
@@ -148,7 +166,7 @@ private:
 	/**
 	 * @brief The customer's ID associated with this transaction.
 	 */
-	int my_cust_id;
+	long long my_cust_id;
 }; 
 #endif
 
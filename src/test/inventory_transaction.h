@@ -78,20 +78,36 @@ public:
 	/**
 	 * @brief Retuns a pointer to a new instance of a Inventory 
 	 *	  Transaction. The data of the new object will be set
-  	 *	  using the provided file stream.
+  	 *	  using the provided line.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *		  formatted according to Lab 4 specs.  	
 	 *
 	 * Postconditions: A new object was created using the provided
  	 *		   file to set its data. A pointer to the 
 	 *	 	   object was then returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return A pointer to a new instance.
 	 */
 	virtual InventoryTransaction * getNewInstance 
-					(ifstream &input) const;
+					(FieldReader &input) const;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new InventoryTransaction, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a InventoryTransaction saved by save.
+	 *
+	 * Postconditions: A new InventoryTransaction was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual InventoryTransaction * getNewInstance (SnapshotReader &input) const;
 
 
 	//---------------------clone----------------------------------
@@ -107,17 +123,6 @@ public:
 	virtual InventoryTransaction * clone () const; 
 
 	
-	//---------------------execute--------------------------------
-	/**
-	 * @brief Calls the appropriate method on the store manager.
-	 * 
-	 * Preconditions: The storemanager is not NULL.
-	 *
-	 * Postconditions: The storemanager's method has been called.
-	 *
-	 * @param mgr The store manager.
-	 */
-	virtual void execute (StoreManager *mgr) const;
 
 };
 #endif /* INVENTORY_TRANSACTION */
@@ -22,7 +22,11 @@
  * 	- Allows clients to compare Items for less than value.
  *	- Allows clients to print the Item.
  *	- Allows cloning an Item.
- * 	- Allows getting the occurence count of an Item.
+ * 	- Allows getting the occurrence count of an Item.
+ *	- Allows derived classes to build a byte-comparable sort key
+ *	  from their fields.
+ *	- Keeps the name and title as handles into the StringPool, 
+ *	  so Items and their clones share one copy of each string.
  * Assumptions:
  * 	- All derived classes of Item implement getNewInstance, and 
  *	  within the method return a dynamically allocated object of
@@ -46,8 +50,6 @@
 Item::Item () : Object ()
 {
 	my_type  = 0;
-	my_name  = "";
-	my_title = "";
 	my_year  = 0;
 	my_count = 0;
 }
@@ -66,9 +68,10 @@ Item::Item () : Object ()
  * @param name  The name of this Item.
  * @param title The title of this Item.
  * @param year  The year of this Item.
- * @param count The occurence count of Item.
+ * @param count The occurrence count of Item.
  */
-Item::Item (char type, string name, string title, int year, int count)
+Item::Item (char type, const InternedString &name, 
+			const InternedString &title, int year, int count)
 	: Object ()
 {
 	my_type  = type;
@@ -104,12 +107,33 @@ Item::~Item () {}
  */
 void Item::print (ostream &output) const
 {
-	output << my_name  << ", ";
-	output << my_title << ", ";
+	output << my_name.toString ()  << ", ";
+	output << my_title.toString () << ", ";
 	output << my_year; 
 }
 
 
+//---------------------save-------------------------------------------
+/**
+ * @brief Writes this Item to a snapshot: its type, name, title, year and
+ *	  count.
+ *	
+ * Preconditions: A section of the snapshot is being written.
+ *
+ * Postconditions: This Item was written.
+ *
+ * @param output The snapshot to write to.
+ */
+void Item::save (SnapshotWriter &output) const
+{
+	output.putByte   (my_type);
+	output.putString (my_name.toString ());
+	output.putString (my_title.toString ());
+	output.putInt    (my_year);
+	output.putInt    (my_count);
+}
+
+
 
 //---------------------getName----------------------------------------
 /**
@@ -122,9 +146,9 @@ void Item::print (ostream &output) const
  *
  * @return The name of this Item.	
  */
-const string Item::getName () const
+const string & Item::getName () const
 {
-	return my_name;
+	return my_name.toString ();
 }
 
 
@@ -139,9 +163,9 @@ const string Item::getName () const
  * 
  * @return The title of this Item.
  */	
-const string Item::getTitle () const
+const string & Item::getTitle () const
 {
-	return my_title;
+	return my_title.toString ();
 }
 
 
@@ -164,13 +188,13 @@ int Item::getYear () const
 
 //---------------------getCount---------------------------------------
 /**
- * @brief Returns the number of occurences of this Item.
+ * @brief Returns the number of occurrences of this Item.
  * 
  * Preconditions: None. 
  * 
- * Postconditions: Occurence count was returned. 
+ * Postconditions: Occurrence count was returned. 
  * 
- * @return Occurence count of this Item.
+ * @return Occurrence count of this Item.
  */
 int Item::getCount () const
 {
@@ -193,3 +217,45 @@ char Item::getType () const
 	return my_type;
 }
 
+
+//---------------------appendKey--------------------------------------
+/**
+ * @brief Appends a string field to a sort key. The field is 
+ *	  terminated by a zero byte, so a shorter field sorts before a
+ *	  longer one that it prefixes.
+ *
+ * Preconditions: field contains no zero bytes.
+ *
+ * Postconditions: The field was appended to key.
+ * 
+ * @param key The sort key being built.
+ * @param field The field to append.
+ */	
+void Item::appendKey (string &key, const string &field)
+{
+	key.append (field);
+	key.push_back ('\0');
+}
+
+
+//---------------------appendKey--------------------------------------
+/**
+ * @brief Appends an integer field to a sort key as four big-endian 
+ *	  bytes with the sign bit flipped, so the bytes compare in 
+ *	  numeric order.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The field was appended to key.
+ * 
+ * @param key The sort key being built.
+ * @param field The field to append.
+ */	
+void Item::appendKey (string &key, int field)
+{
+	unsigned int bits = (unsigned int)field ^ 0x80000000u;
+	key.push_back ((char)(bits >> 24));
+	key.push_back ((char)(bits >> 16));
+	key.push_back ((char)(bits >> 8));
+	key.push_back ((char)bits);
+}
@@ -23,6 +23,10 @@
  *	- Allows clients to print the Item.
  *	- Allows cloning an Item.
  *	- Allows getting the count of an Item.
+ *	- Allows derived classes to build a byte-comparable sort key
+ *	  from their fields.
+ *	- Keeps the name and title as handles into the StringPool, 
+ *	  so Items and their clones share one copy of each string.
  * 
  * Assumptions:
  * 	- All derived classes of Item implement getNewInstance, and 
@@ -77,10 +81,10 @@ public:
 	 * @param name  The name of this Item.
 	 * @param title The title of this Item.
 	 * @param year  The year of this Item.
-	 * @param count The occurence count of Item.
+	 * @param count The occurrence count of Item.
  	 */
-	Item (char type, string name, string title, 
-					int year, int count);
+	Item (char type, const InternedString &name, 
+			const InternedString &title, int year, int count);
 
 
 	//---------------------Destructor-----------------------------
@@ -98,9 +102,9 @@ public:
 	/**
 	 * @brief Retuns a pointer to a new instance of the derived
  	 *	  Item. The data of the new object will be set using
- 	 *	  the provided file stream.
+ 	 *	  the provided line.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *		  formatted according to Lab 4 specs.  
 	 *	
 	 * Postconditions: A new object of the derived type was 
@@ -108,11 +112,41 @@ public:
 	 *		   its data. A pointer to the object was then
 	 *		   returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return A pointer to a  new instance of the derived
 	 *	   Item.
 	 */
-	virtual Item * getNewInstance (ifstream &input) const = 0;
+	virtual Item * getNewInstance (FieldReader &input) const = 0;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new Item, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a Item saved by save.
+	 *
+	 * Postconditions: A new Item was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Item * getNewInstance (SnapshotReader &input) const = 0;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes this Item to a snapshot: its type,
+	 *	  name, title, year and count.
+	 *	
+ 	 * Preconditions: A section of the snapshot is being written.
+	 *
+	 * Postconditions: This Item was written.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	virtual void save (SnapshotWriter &output) const;
 
 
 	//---------------------clone----------------------------------
@@ -182,13 +216,13 @@ public:
 
 	//---------------------getCount-------------------------------
 	/**
-	 * @brief Returns the number of occurences of this Item.
+	 * @brief Returns the number of occurrences of this Item.
 	 * 
 	 * Preconditions: None. 
 	 * 
- 	 * Postconditions: Occurence count was returned. 
+ 	 * Postconditions: Occurrence count was returned. 
 	 * 
-	 * @return Occurence count of this Item.
+	 * @return Occurrence count of this Item.
 	 */
 	int getCount () const;
 
@@ -221,7 +255,7 @@ protected:
 	 *
 	 * @return The name of this Item.	
 	 */
-	const string getName () const;
+	const string & getName () const;
 
 	
 	//---------------------getTitle-------------------------------
@@ -235,7 +269,7 @@ protected:
 	 * 
 	 * @return The title of this Item.
 	 */	
-	const string getTitle () const;
+	const string & getTitle () const;
 
 
 	//---------------------getYear--------------------------------
@@ -251,6 +285,38 @@ protected:
 	 */	
 	int getYear () const; 
 
+
+	//---------------------appendKey------------------------------
+	/**
+	 * @brief Appends a string field to a sort key. The field is
+	 *	  terminated by a zero byte, so a shorter field sorts
+	 *	  before a longer one that it prefixes.
+	 *
+	 * Preconditions: field contains no zero bytes.
+ 	 *
+ 	 * Postconditions: The field was appended to key.
+	 * 
+	 * @param key The sort key being built.
+	 * @param field The field to append.
+	 */	
+	static void appendKey (string &key, const string &field);
+
+
+	//---------------------appendKey------------------------------
+	/**
+	 * @brief Appends an integer field to a sort key as four 
+	 *	  big-endian bytes with the sign bit flipped, so the
+	 *	  bytes compare in numeric order.
+	 *
+	 * Preconditions: None.
+ 	 *
+ 	 * Postconditions: The field was appended to key.
+	 * 
+	 * @param key The sort key being built.
+	 * @param field The field to append.
+	 */	
+	static void appendKey (string &key, int field);
+
 /**
  * @private
  */
@@ -262,14 +328,14 @@ private:
 	char my_type;
 
 	/**
- 	 * @brief The artist name or director of this Item.
+ 	 * @brief The artist name or director of this Item, interned.
 	 */
-	string my_name;	
+	InternedString my_name;	
 
 	/**
-	 * @brief The title of this Item.
+	 * @brief The title of this Item, interned.
 	 */
-	string my_title;
+	InternedString my_title;
 
 	/**
 	 * @brief The year of this Item.
@@ -277,7 +343,7 @@ private:
 	int my_year;
 	
 	/**
-	 * @brief The number of occurences of this Item.
+	 * @brief The number of occurrences of this Item.
 	 */
 	int my_count;  
 };
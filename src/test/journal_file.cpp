@@ -0,0 +1,585 @@
+/**
+ * @file journal_file.cpp
+ *
+ * @brief The JournalWriter and JournalReader classes keep an append
+ *	  only journal of the transactions that changed the store, so
+ *	  that they can be replayed after a crash.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows appending a record, which is durable once its group
+ *	  was synced.
+ *	- Allows waiting until every record appended is durable.
+ *	- Allows emptying the journal, once a snapshot holds all it
+ *	  recorded. Its generation is raised, so a snapshot tells
+ *	  whether the records of a journal are already part of it.
+ *	- Allows reading the records back in order, up to the first
+ *	  torn or damaged one.
+ *
+ * Assumptions:
+ *	- One thread appends to a JournalWriter.
+ *	- A group is written when it holds the group size of records,
+ *	  when its oldest record has waited the delay, or on sync.
+ */
+//--------------------------------------------------------------------
+
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include "journal_file.h"
+
+/**
+ * @brief The first bytes of every journal.
+ */
+static char const MAGIC[] = "STOREJNL";
+
+/**
+ * @brief The bytes of the header: the magic bytes, the version, the
+ *	  generation and the checksum of the first 16 bytes.
+ */
+static int const HEADER_SIZE = 24;
+
+/**
+ * @brief The bytes before each payload: length and checksum.
+ */
+static int const RECORD_HEADER_SIZE = 12;
+
+
+//---------------------putNumber--------------------------------------
+/**
+ * @brief Appends the low bytes of a number, least significant first.
+ *
+ * Preconditions: size is at most 8.
+ *
+ * Postconditions: size bytes were appended to output.
+ *
+ * @param output The bytes to append to.
+ * @param value The number.
+ * @param size The number of low bytes to append.
+ */
+static void putNumber (string &output, unsigned long long value, int size)
+{
+	for (int i = 0; i < size; i++)
+		output += (char)(value >> (8 * i));
+}
+
+
+//---------------------getNumber--------------------------------------
+/**
+ * @brief Returns the number whose low bytes start at data, least
+ *	  significant first.
+ *
+ * Preconditions: size bytes can be read at data.
+ *
+ * Postconditions: The number was returned.
+ *
+ * @param data The first byte.
+ * @param size The number of bytes.
+ * @return The number.
+ */
+static unsigned long long getNumber (const char *data, int size)
+{
+	unsigned long long value = 0;
+
+	for (int i = 0; i < size; i++)
+		value |= (unsigned long long)(unsigned char)data [i] << (8 * i);
+	return value;
+}
+
+
+//---------------------makeHeader-------------------------------------
+/**
+ * @brief Returns the header of a journal of the provided generation.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The HEADER_SIZE bytes of the header were returned.
+ *
+ * @param generation The journal generation.
+ * @return The header.
+ */
+static string makeHeader (unsigned int generation)
+{
+	string header (MAGIC, 8);
+
+	putNumber (header, JOURNAL_VERSION, 4);
+	putNumber (header, generation, 4);
+	putNumber (header, snapshotChecksum (header.data (), 
+					     header.size ()), 8);
+	return header;
+}
+
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a JournalWriter with no file open.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This JournalWriter was created closed.
+ */
+JournalWriter::JournalWriter ()
+{
+	my_descriptor = -1;
+	my_waiting    = 0;
+	my_appended   = 0;
+	my_durable    = 0;
+	my_group      = 1;
+	my_delay      = 0;
+	my_force      = false;
+	my_closing    = false;
+	my_failed     = false;
+	my_threaded   = false;
+	pthread_mutex_init (&my_lock, NULL);
+	pthread_cond_init  (&my_wake, NULL);
+	pthread_cond_init  (&my_synced, NULL);
+}
+
+
+//---------------------Destructor-------------------------------------
+/**
+ * @brief Syncs and closes the journal.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The journal has been closed.
+ */
+JournalWriter::~JournalWriter ()
+{
+	close ();
+	pthread_cond_destroy  (&my_synced);
+	pthread_cond_destroy  (&my_wake);
+	pthread_mutex_destroy (&my_lock);
+}
+
+
+//---------------------open-------------------------------------------
+/**
+ * @brief Opens the journal for appending, keeping its first length
+ *	  bytes, and starts the flusher thread. Whatever follows them,
+ *	  such as a record torn by a crash, is cut off. A journal too
+ *	  short to have a header is started over.
+ *
+ * Preconditions: length is 0, or the length of the records a
+ *		  JournalReader read from the file.
+ *
+ * Postconditions: True was returned if the journal was opened, false
+ *		   otherwise.
+ *
+ * @param file The journal file.
+ * @param length The bytes to keep; 0 starts a new journal.
+ * @param generation The generation of a new journal.
+ * @param group The most records in a group.
+ * @param delay The longest a record waits for its group to fill, in
+ *		milliseconds.
+ * @return True if opened, false otherwise.
+ */
+bool JournalWriter::open (const char *file, long length, 
+			  unsigned int generation, int group, int delay)
+{
+	close ();
+	my_descriptor = ::open (file, O_WRONLY | O_CREAT, 0644);
+	if (my_descriptor < 0) return false;
+
+	if (length < HEADER_SIZE) {
+		if (ftruncate (my_descriptor, 0) != 0 || 
+		    !writeAll (makeHeader (generation))) {
+			::close (my_descriptor);
+			my_descriptor = -1;
+			return false;
+		}
+	}
+	else if (ftruncate (my_descriptor, length) != 0) {
+		::close (my_descriptor);
+		my_descriptor = -1;
+		return false;
+	}
+	lseek (my_descriptor, 0, SEEK_END);
+
+	my_pending.clear ();
+	my_waiting  = 0;
+	my_appended = 0;
+	my_durable  = 0;
+	my_group    = group > 0 ? group : 1;
+	my_delay    = delay > 0 ? delay : 0;
+	my_force    = false;
+	my_closing  = false;
+	my_failed   = false;
+
+	// Without the thread, the appending thread commits each group.
+	my_threaded = pthread_create (&my_thread, NULL, flusher, this) == 0;
+	return true;
+}
+
+
+//---------------------append-----------------------------------------
+/**
+ * @brief Appends the record of a transaction. The record is encoded
+ *	  before the lock is taken, so the flusher is held up only
+ *	  while it is copied in. Waits only if the flusher is more
+ *	  than a group behind, which bounds the memory buffered.
+ *
+ * Preconditions: The journal is open.
+ *
+ * Postconditions: The record will be durable once its group was
+ *		   synced.
+ *
+ * @param record The transaction to record.
+ */
+void JournalWriter::append (const Object &record)
+{
+	string payload, bytes;
+
+	my_encoder.beginSection (0);
+	record.save (my_encoder);
+	my_encoder.takeSection (payload);
+	putNumber (bytes, payload.size (), 4);
+	putNumber (bytes, snapshotChecksum (payload.data (),
+					payload.size ()), 8);
+	bytes += payload;
+
+	pthread_mutex_lock (&my_lock);
+	while (my_threaded && my_waiting >= 2 * my_group && !my_failed)
+		pthread_cond_wait (&my_synced, &my_lock);
+	my_pending += bytes;
+	my_waiting++;
+	my_appended++;
+
+	// The first record starts the delay; a full group cuts it short.
+	if (my_threaded) {
+		if (my_waiting == 1 || my_waiting == my_group)
+			pthread_cond_signal (&my_wake);
+	}
+	else if (my_waiting >= my_group) commit ();
+	pthread_mutex_unlock (&my_lock);
+}
+
+
+//---------------------sync-------------------------------------------
+/**
+ * @brief Waits until every record appended is durable. The flusher is
+ *	  told not to wait for the group to fill.
+ *
+ * Preconditions: The journal is open.
+ *
+ * Postconditions: True was returned if every record has been written
+ *		   and synced, false otherwise.
+ *
+ * @return True if durable, false otherwise.
+ */
+bool JournalWriter::sync ()
+{
+	bool durable;
+
+	pthread_mutex_lock (&my_lock);
+	if (my_threaded) {
+		my_force = true;
+		pthread_cond_signal (&my_wake);
+		while (my_durable < my_appended && !my_failed)
+			pthread_cond_wait (&my_synced, &my_lock);
+		my_force = false;
+	}
+	else if (my_waiting > 0) commit ();
+	durable = my_durable == my_appended && !my_failed;
+	pthread_mutex_unlock (&my_lock);
+	return durable;
+}
+
+
+//---------------------reset------------------------------------------
+/**
+ * @brief Empties the journal, and gives it a new generation. The
+ *	  records appended so far are synced first, so that none is
+ *	  written after the file was cut. The records are cut, and 
+ *	  that synced, before the header changes, so a crash never
+ *	  leaves old records under the new generation.
+ *
+ * Preconditions: The journal is open, and a synced snapshot holds
+ *		  everything it recorded.
+ *
+ * Postconditions: True was returned if the journal is empty on disk,
+ *		   false otherwise.
+ *
+ * @param generation The new generation.
+ * @return True if emptied, false otherwise.
+ */
+bool JournalWriter::reset (unsigned int generation)
+{
+	string header = makeHeader (generation);
+	bool emptied;
+
+	if (my_descriptor < 0 || !sync ()) return false;
+	pthread_mutex_lock (&my_lock);
+	emptied = ftruncate (my_descriptor, HEADER_SIZE) == 0 &&
+		  fdatasync (my_descriptor) == 0 &&
+		  pwrite (my_descriptor, header.data (), HEADER_SIZE, 0)
+			== HEADER_SIZE &&
+		  lseek (my_descriptor, 0, SEEK_END) == HEADER_SIZE &&
+		  fdatasync (my_descriptor) == 0;
+	if (!emptied) my_failed = true;
+	pthread_mutex_unlock (&my_lock);
+	return emptied;
+}
+
+
+//---------------------close------------------------------------------
+/**
+ * @brief Syncs the journal, stops the flusher and closes the file. The
+ *	  flusher writes whatever is waiting before it stops.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if every record was durable,
+ *		   false otherwise.
+ *
+ * @return True if durable, false otherwise.
+ */
+bool JournalWriter::close ()
+{
+	bool durable;
+
+	if (my_descriptor < 0) return !my_failed;
+	pthread_mutex_lock (&my_lock);
+	my_closing = true;
+	if (my_threaded) pthread_cond_signal (&my_wake);
+	else if (my_waiting > 0) commit ();
+	pthread_mutex_unlock (&my_lock);
+
+	if (my_threaded) pthread_join (my_thread, NULL);
+	my_threaded = false;
+	::close (my_descriptor);
+	my_descriptor = -1;
+	durable = my_durable == my_appended && !my_failed;
+	return durable;
+}
+
+
+//---------------------flusher----------------------------------------
+/**
+ * @brief Writes and syncs groups of records until the journal is
+ *	  closed. Once a record is waiting, the flusher waits up to the
+ *	  delay for the group to fill, unless a sync or close hurries
+ *	  it, then commits whatever has come.
+ *
+ * Preconditions: journal points to an open JournalWriter.
+ *
+ * Postconditions: Every record appended was written.
+ *
+ * @param journal The JournalWriter.
+ * @return NULL.
+ */
+void * JournalWriter::flusher (void *journal)
+{
+	JournalWriter *self = static_cast<JournalWriter *> (journal);
+	struct timespec deadline;
+
+	pthread_mutex_lock (&self->my_lock);
+	while (true) {
+		while (self->my_waiting == 0 && !self->my_closing)
+			pthread_cond_wait (&self->my_wake, &self->my_lock);
+		if (self->my_waiting == 0) break;
+
+		clock_gettime (CLOCK_REALTIME, &deadline);
+		deadline.tv_sec  += self->my_delay / 1000;
+		deadline.tv_nsec += (self->my_delay % 1000) * 1000000L;
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+		while (self->my_waiting < self->my_group &&
+		       !self->my_force && !self->my_closing) {
+			if (pthread_cond_timedwait (&self->my_wake,
+				&self->my_lock, &deadline) == ETIMEDOUT) break;
+		}
+		self->commit ();
+	}
+	pthread_mutex_unlock (&self->my_lock);
+	return NULL;
+}
+
+
+//---------------------commit-----------------------------------------
+/**
+ * @brief Writes and syncs the records waiting, and marks them durable.
+ *	  They are swapped out first, so that records can be appended
+ *	  while the disk is written.
+ *
+ * Preconditions: my_lock is held; it is released while the disk is
+ *		  written.
+ *
+ * Postconditions: The records that were waiting are durable, unless
+ *		   the write failed.
+ */
+void JournalWriter::commit ()
+{
+	string group;
+	long long count;
+	bool written;
+
+	group.swap (my_pending);
+	count      = my_appended;
+	my_waiting = 0;
+
+	pthread_mutex_unlock (&my_lock);
+	written = writeAll (group);
+	pthread_mutex_lock (&my_lock);
+
+	if (written) my_durable = count;
+	else my_failed = true;
+	pthread_cond_broadcast (&my_synced);
+}
+
+
+//---------------------writeAll---------------------------------------
+/**
+ * @brief Writes the provided bytes at the end of the file and syncs
+ *	  it. Short writes are retried.
+ *
+ * Preconditions: The file is open.
+ *
+ * Postconditions: True was returned if the bytes are on disk.
+ *
+ * @param bytes The bytes to write.
+ * @return True if written, false otherwise.
+ */
+bool JournalWriter::writeAll (const string &bytes)
+{
+	const char *data = bytes.data ();
+	size_t left = bytes.size ();
+	ssize_t written;
+
+	while (left > 0) {
+		written = write (my_descriptor, data, left);
+		if (written < 0) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+		data += written;
+		left -= written;
+	}
+	return fdatasync (my_descriptor) == 0;
+}
+
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a JournalReader with no file open.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This JournalReader was created closed.
+ */
+JournalReader::JournalReader ()
+{
+	my_position   = 0;
+	my_generation = 0;
+}
+
+
+//---------------------open-------------------------------------------
+/**
+ * @brief Maps the journal and checks its header.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the file is a journal of this
+ *		   version, false otherwise.
+ *
+ * @param file The journal file.
+ * @return True if it can be read, false otherwise.
+ */
+bool JournalReader::open (const char *file)
+{
+	const char *data;
+
+	my_position = 0;
+	if (!my_file.open (file)) return false;
+	data = my_file.getData ();
+
+	if (my_file.getLength () < HEADER_SIZE ||
+	    string (data, 8) != MAGIC ||
+	    getNumber (data + 8, 4) != JOURNAL_VERSION ||
+	    getNumber (data + 16, 8) != snapshotChecksum (data, 16))
+		return false;
+	my_generation = (unsigned int)getNumber (data + 12, 4);
+	my_position   = HEADER_SIZE;
+	return true;
+}
+
+
+//---------------------nextRecord-------------------------------------
+/**
+ * @brief Reads the next record whose checksum matches. A record cut
+ *	  short or damaged ends the journal, as nothing after it can
+ *	  have been durable.
+ *
+ * Preconditions: The journal was opened.
+ *
+ * Postconditions: If there is another whole record, record reads its
+ *		   payload and true was returned. At the end, or at a
+ *		   torn or damaged record, false was returned.
+ *
+ * @param record Set to read the payload.
+ * @return True if a record was read, false otherwise.
+ */
+bool JournalReader::nextRecord (SnapshotReader &record)
+{
+	const char *data = my_file.getData ();
+	long left = my_file.getLength () - my_position;
+	unsigned long long size, checksum;
+
+	if (my_position == 0 || left < RECORD_HEADER_SIZE) return false;
+	size     = getNumber (data + my_position, 4);
+	checksum = getNumber (data + my_position + 4, 8);
+	if (size > (unsigned long long)(left - RECORD_HEADER_SIZE))
+		return false;
+	data += my_position + RECORD_HEADER_SIZE;
+	if (checksum != snapshotChecksum (data, size)) return false;
+
+	record.readSection (data, size);
+	my_position += RECORD_HEADER_SIZE + size;
+	return true;
+}
+
+
+//---------------------getGeneration----------------------------------
+/**
+ * @brief Returns the generation of the journal.
+ *
+ * Preconditions: The journal was opened.
+ *
+ * Postconditions: The generation was returned.
+ *
+ * @return The journal generation.
+ */
+unsigned int JournalReader::getGeneration () const
+{
+	return my_generation;
+}
+
+
+//---------------------getLength--------------------------------------
+/**
+ * @brief Returns the length of the header and the records read so
+ *	  far, which is where the next record should be appended.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The length was returned, or 0 if the file is not a
+ *		   journal.
+ *
+ * @return The length of what was read.
+ */
+long JournalReader::getLength () const
+{
+	return my_position;
+}
@@ -0,0 +1,425 @@
+/**
+ * @file journal_file.h
+ *
+ * @brief The JournalWriter and JournalReader classes keep an append
+ *	  only journal of the transactions that changed the store, so
+ *	  that they can be replayed after a crash.
+ *
+ * @brief A journal starts with a header like a snapshot's: the magic
+ *	  bytes STOREJNL, the format version, the generation and a 
+ *	  checksum of the header. Records follow. Each has the length and checksum of
+ *	  its payload, and the payload, which is what save writes for
+ *	  the transaction. A crash can leave a torn record at the end;
+ *	  reading stops there.
+ *
+ * @brief Records are committed in groups. The writer buffers them, and
+ *	  a flusher thread writes and syncs a whole group at a time,
+ *	  so the thread that appends seldom waits for the disk.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows appending a record, which is durable once its group
+ *	  was synced.
+ *	- Allows waiting until every record appended is durable.
+ *	- Allows emptying the journal, once a snapshot holds all it
+ *	  recorded. Its generation is raised, so a snapshot tells
+ *	  whether the records of a journal are already part of it.
+ *	- Allows reading the records back in order, up to the first
+ *	  torn or damaged one.
+ *
+ * Assumptions:
+ *	- One thread appends to a JournalWriter.
+ *	- A group is written when it holds the group size of records,
+ *	  when its oldest record has waited the delay, or on sync.
+ */
+//--------------------------------------------------------------------
+
+#ifndef JOURNAL_FILE_H
+#define JOURNAL_FILE_H
+
+#include <string>
+#include <pthread.h>
+#include "object.h"
+#include "mapped_file.h"
+#include "snapshot_file.h"
+/**
+ * @namespace std
+ */
+using namespace std;
+
+/**
+ * @brief The version of the journal format written.
+ */
+unsigned int const JOURNAL_VERSION = 1;
+
+
+/**
+ * @class JournalWriter
+ */
+class JournalWriter {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a JournalWriter with no file open.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This JournalWriter was created closed.
+	 */
+	JournalWriter ();
+
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Syncs and closes the journal.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The journal has been closed.
+	 */
+	~JournalWriter ();
+
+
+	//---------------------open-----------------------------------
+	/**
+	 * @brief Opens the journal for appending, keeping its first
+	 *	  length bytes, and starts the flusher thread.
+	 *
+	 * Preconditions: length is 0, or the length of the records
+	 *		  a JournalReader read from the file.
+	 *
+	 * Postconditions: True was returned if the journal was opened,
+	 *		   false otherwise.
+	 *
+	 * @param file The journal file.
+	 * @param length The bytes to keep; 0 starts a new journal.
+	 * @param generation The generation of a new journal.
+	 * @param group The most records in a group.
+	 * @param delay The longest a record waits for its group to
+	 *		fill, in milliseconds.
+	 * @return True if opened, false otherwise.
+	 */
+	bool open (const char *file, long length, unsigned int generation,
+						int group, int delay);
+
+
+	//---------------------append---------------------------------
+	/**
+	 * @brief Appends the record of a transaction. Waits only if
+	 *	  the flusher is more than a group behind.
+	 *
+	 * Preconditions: The journal is open.
+	 *
+	 * Postconditions: The record will be durable once its group
+	 *		   was synced.
+	 *
+	 * @param record The transaction to record.
+	 */
+	void append (const Object &record);
+
+
+	//---------------------sync-----------------------------------
+	/**
+	 * @brief Waits until every record appended is durable.
+	 *
+	 * Preconditions: The journal is open.
+	 *
+	 * Postconditions: True was returned if every record has been
+	 *		   written and synced, false otherwise.
+	 *
+	 * @return True if durable, false otherwise.
+	 */
+	bool sync ();
+
+
+	//---------------------reset----------------------------------
+	/**
+	 * @brief Empties the journal, and gives it a new generation.
+	 *
+	 * Preconditions: The journal is open, and a synced snapshot
+	 *		  holds everything it recorded.
+	 *
+	 * Postconditions: True was returned if the journal is empty
+	 *		   on disk, false otherwise.
+	 *
+	 * @param generation The new generation.
+	 * @return True if emptied, false otherwise.
+	 */
+	bool reset (unsigned int generation);
+
+
+	//---------------------close----------------------------------
+	/**
+	 * @brief Syncs the journal, stops the flusher and closes the
+	 *	  file.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if every record was
+	 *		   durable, false otherwise.
+	 *
+	 * @return True if durable, false otherwise.
+	 */
+	bool close ();
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------Copy-Constructor-----------------------
+	/**
+	 * @brief Not implemented; a journal has a single writer.
+	 */
+	JournalWriter (const JournalWriter &the_other);
+
+
+	//---------------------operator(=)----------------------------
+	/**
+	 * @brief Not implemented; a journal has a single writer.
+	 */
+	const JournalWriter & operator= (const JournalWriter &the_other);
+
+
+	//---------------------flusher--------------------------------
+	/**
+	 * @brief Writes and syncs groups of records until the journal
+	 *	  is closed. A thread entry point.
+	 *
+	 * Preconditions: journal points to an open JournalWriter.
+	 *
+	 * Postconditions: Every record appended was written.
+	 *
+	 * @param journal The JournalWriter.
+	 * @return NULL.
+	 */
+	static void * flusher (void *journal);
+
+
+	//---------------------commit---------------------------------
+	/**
+	 * @brief Writes and syncs the records waiting, and marks them
+	 *	  durable.
+	 *
+	 * Preconditions: my_lock is held; it is released while the
+	 *		  disk is written.
+	 *
+	 * Postconditions: The records that were waiting are durable,
+	 *		   unless the write failed.
+	 */
+	void commit ();
+
+
+	//---------------------writeAll-------------------------------
+	/**
+	 * @brief Writes the provided bytes at the end of the file and
+	 *	  syncs it.
+	 *
+	 * Preconditions: The file is open.
+	 *
+	 * Postconditions: True was returned if the bytes are on disk.
+	 *
+	 * @param bytes The bytes to write.
+	 * @return True if written, false otherwise.
+	 */
+	bool writeAll (const string &bytes);
+
+	/**
+	 * @brief The journal file, or -1 if closed.
+	 */
+	int my_descriptor;
+
+	/**
+	 * @brief Encodes the records. Used only by the appending
+	 *	  thread.
+	 */
+	SnapshotWriter my_encoder;
+
+	/**
+	 * @brief The records waiting to be written.
+	 */
+	string my_pending;
+
+	/**
+	 * @brief The number of records in my_pending.
+	 */
+	int my_waiting;
+
+	/**
+	 * @brief The number of records appended.
+	 */
+	long long my_appended;
+
+	/**
+	 * @brief The number of records durable.
+	 */
+	long long my_durable;
+
+	/**
+	 * @brief The most records in a group.
+	 */
+	int my_group;
+
+	/**
+	 * @brief The longest a record waits, in milliseconds.
+	 */
+	int my_delay;
+
+	/**
+	 * @brief True while a caller waits in sync or reset.
+	 */
+	bool my_force;
+
+	/**
+	 * @brief True once close was called.
+	 */
+	bool my_closing;
+
+	/**
+	 * @brief True once a write failed.
+	 */
+	bool my_failed;
+
+	/**
+	 * @brief True if the flusher thread is running. Otherwise
+	 *	  groups are committed by the appending thread.
+	 */
+	bool my_threaded;
+
+	/**
+	 * @brief The flusher thread.
+	 */
+	pthread_t my_thread;
+
+	/**
+	 * @brief Guards every member above but my_encoder.
+	 */
+	pthread_mutex_t my_lock;
+
+	/**
+	 * @brief Wakes the flusher.
+	 */
+	pthread_cond_t my_wake;
+
+	/**
+	 * @brief Signalled when records become durable.
+	 */
+	pthread_cond_t my_synced;
+};
+
+
+/**
+ * @class JournalReader
+ */
+class JournalReader {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a JournalReader with no file open.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This JournalReader was created closed.
+	 */
+	JournalReader ();
+
+
+	//---------------------open-----------------------------------
+	/**
+	 * @brief Maps the journal and checks its header.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the file is a journal
+	 *		   of this version, false otherwise.
+	 *
+	 * @param file The journal file.
+	 * @return True if it can be read, false otherwise.
+	 */
+	bool open (const char *file);
+
+
+	//---------------------nextRecord-----------------------------
+	/**
+	 * @brief Reads the next record whose checksum matches.
+	 *
+	 * Preconditions: The journal was opened.
+	 *
+	 * Postconditions: If there is another whole record, record
+	 *		   reads its payload and true was returned. At
+	 *		   the end, or at a torn or damaged record,
+	 *		   false was returned.
+	 *
+	 * @param record Set to read the payload.
+	 * @return True if a record was read, false otherwise.
+	 */
+	bool nextRecord (SnapshotReader &record);
+
+
+	//---------------------getGeneration--------------------------
+	/**
+	 * @brief Returns the generation of the journal.
+	 *
+	 * Preconditions: The journal was opened.
+	 *
+	 * Postconditions: The generation was returned.
+	 *
+	 * @return The journal generation.
+	 */
+	unsigned int getGeneration () const;
+
+
+	//---------------------getLength------------------------------
+	/**
+	 * @brief Returns the length of the header and the records
+	 *	  read so far, which is where the next record should
+	 *	  be appended.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The length was returned, or 0 if the file
+	 *		   is not a journal.
+	 *
+	 * @return The length of what was read.
+	 */
+	long getLength () const;
+
+/**
+ * @private
+ */
+private:
+
+	/**
+	 * @brief The mapped journal.
+	 */
+	MappedFile my_file;
+
+	/**
+	 * @brief The offset of the next record.
+	 */
+	long my_position;
+
+	/**
+	 * @brief The generation of the journal.
+	 */
+	unsigned int my_generation;
+};
+#endif /* JOURNAL_FILE_H */
@@ -0,0 +1,295 @@
+/**
+ * @file mapped_file.cpp
+ *
+ * @brief A class to represent a MappedFile. A MappedFile maps an
+ *	  input file into memory and hands out its lines as
+ *	  FieldReaders over the mapped bytes, so parsing a file
+ *	  copies nothing but the fields objects keep.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows opening and closing a file.
+ *	- Allows reading the file a line at a time.
+ *	- Allows reading the mapped bytes directly.
+ *	- Allows giving back the memory of the lines already read,
+ *	  so a long file can be streamed in constant memory.
+ *	- Allows splitting the file into runs of whole lines, so
+ *	  that they can be parsed in parallel.
+ *
+ * Assumptions:
+ *	- The file is not changed while it is open.
+ *	- A file that cannot be mapped, such as a pipe, is read
+ *	  into memory instead.
+ */
+//--------------------------------------------------------------------
+
+#include "mapped_file.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a MappedFile with no file open.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This MappedFile was created closed.
+ */
+MappedFile::MappedFile ()
+{
+	my_data     = NULL;
+	my_length   = 0;
+	my_position = 0;
+	my_released = 0;
+	my_mapped   = false;
+}
+
+
+//---------------------Destructor-------------------------------------
+/**
+ * @brief Closes the file.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The file has been unmapped.
+ */
+MappedFile::~MappedFile ()
+{
+	close ();
+}
+
+
+//---------------------open-------------------------------------------
+/**
+ * @brief Maps the provided file, closing any file that was open
+ *	  before. The kernel is told the file will be read in order,
+ *	  so it reads ahead.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the file was opened, false
+ *		   otherwise.
+ *
+ * @param file The file to open.
+ * @return True if opened, false otherwise.
+ */
+bool MappedFile::open (const char *file)
+{
+	struct stat info;
+	void *data;
+	int descriptor;
+	bool opened = true;
+
+	close ();
+	descriptor = ::open (file, O_RDONLY);
+	if (descriptor < 0) return false;
+
+	if (fstat (descriptor, &info) == 0 && S_ISREG (info.st_mode)) {
+		// An empty file cannot be mapped, and needs nothing.
+		if (info.st_size > 0) {
+			data = mmap (NULL, info.st_size, PROT_READ,
+				     MAP_PRIVATE, descriptor, 0);
+			if (data != MAP_FAILED) {
+				my_data   = (char *)data;
+				my_length = (long)info.st_size;
+				my_mapped = true;
+				madvise (data, info.st_size, MADV_SEQUENTIAL);
+			} else
+				opened = readAll (descriptor);
+		}
+	} else
+		opened = readAll (descriptor);
+
+	::close (descriptor);
+	return opened;
+}
+
+
+//---------------------close------------------------------------------
+/**
+ * @brief Unmaps the file. FieldReaders over its lines must no longer
+ *	  be used.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: No file is open.
+ */
+void MappedFile::close ()
+{
+	if (my_mapped)
+		munmap (my_data, my_length);
+	else
+		delete [] my_data;
+	my_data     = NULL;
+	my_length   = 0;
+	my_position = 0;
+	my_released = 0;
+	my_mapped   = false;
+}
+
+
+//---------------------nextLine---------------------------------------
+/**
+ * @brief Reads the next line, without its end of line. The last line
+ *	  counts even when the file does not end with an end of line.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: If there was another line, line walks it and true
+ *		   was returned. Otherwise false was returned.
+ *
+ * @param line Set to walk the line.
+ * @return True if a line was read, false at the end of file.
+ */
+bool MappedFile::nextLine (FieldReader &line)
+{
+	FieldReader rest (my_data + my_position, my_data + my_length);
+
+	if (!rest.readLine (line)) return false;
+	my_position = (rest.readRest ().data - my_data);
+	return true;
+}
+
+
+//---------------------release----------------------------------------
+/**
+ * @brief Gives back the memory of the lines already read by nextLine. 
+ *	  The pages stay readable, and are read from the file again if
+ *	  touched, so FieldReaders over those lines stay valid.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The mapped pages before the next line were dropped.
+ *		   A file read into memory is kept.
+ */
+void MappedFile::release ()
+{
+	long page = sysconf (_SC_PAGESIZE);
+	long end  = my_position - my_position % page;
+
+	if (my_mapped && end > my_released) {
+		madvise (my_data + my_released, end - my_released, 
+			 MADV_DONTNEED);
+		my_released = end;
+	}
+}
+
+
+//---------------------split------------------------------------------
+/**
+ * @brief Splits the whole file into up to count runs of whole lines,
+ *	  of about the same size, in file order. Each run but the last
+ *	  ends just past an end of line. Does not change the next line
+ *	  read by nextLine.
+ *
+ * Preconditions: count is positive.
+ *
+ * Postconditions: chunks holds a FieldReader over each run.
+ *
+ * @param count The most runs to split into.
+ * @param chunks Filled with the runs.
+ */
+void MappedFile::split (int count, vector<FieldReader> &chunks) const
+{
+	long start = 0, end;
+	const char *found;
+
+	chunks.clear ();
+	for (int i = 1; i <= count && start < my_length; i++) {
+		end = (long)((double)my_length * i / count);
+		if (end <= start) continue;
+
+		// Move the cut past the end of the line it falls in.
+		found = (const char *)memchr (my_data + end - 1, '\n',
+					      my_length - end + 1);
+		end = (found != NULL) ? (found - my_data) + 1 : my_length;
+		chunks.push_back (FieldReader (my_data + start,
+					       my_data + end));
+		start = end;
+	}
+}
+
+
+//---------------------getData----------------------------------------
+/**
+ * @brief Returns the bytes of the file.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The first byte, or NULL if no file is open or it is
+ *		   empty, was returned.
+ *
+ * @return The bytes of the file.
+ */
+const char * MappedFile::getData () const
+{
+	return my_data;
+}
+
+
+//---------------------getLength--------------------------------------
+/**
+ * @brief Returns the size of the file.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The number of bytes was returned.
+ *
+ * @return The size of the file.
+ */
+long MappedFile::getLength () const
+{
+	return my_length;
+}
+
+
+//---------------------readAll----------------------------------------
+/**
+ * @brief Reads the whole of an open file into memory, for files that
+ *	  cannot be mapped. The buffer doubles as it fills.
+ *
+ * Preconditions: descriptor is open for reading.
+ *
+ * Postconditions: True was returned if the file was read, false
+ *		   otherwise.
+ *
+ * @param descriptor The file descriptor.
+ * @return True if read, false otherwise.
+ */
+bool MappedFile::readAll (int descriptor)
+{
+	long capacity = 4096;
+	char *bigger;
+	ssize_t count;
+
+	my_data   = new char [capacity];
+	my_length = 0;
+	for (;;) {
+		if (my_length == capacity) {
+			bigger = new char [capacity * 2];
+			memcpy (bigger, my_data, my_length);
+			delete [] my_data;
+			my_data   = bigger;
+			capacity *= 2;
+		}
+		count = read (descriptor, my_data + my_length,
+			      capacity - my_length);
+		if (count == 0) return true;
+		if (count < 0) {
+			close ();
+			return false;
+		}
+		my_length += count;
+	}
+}
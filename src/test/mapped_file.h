@@ -0,0 +1,233 @@
+/**
+ * @file mapped_file.h
+ *
+ * @brief A class to represent a MappedFile. A MappedFile maps an
+ *	  input file into memory and hands out its lines as
+ *	  FieldReaders over the mapped bytes, so parsing a file
+ *	  copies nothing but the fields objects keep.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows opening and closing a file.
+ *	- Allows reading the file a line at a time.
+ *	- Allows reading the mapped bytes directly.
+ *	- Allows giving back the memory of the lines already read,
+ *	  so a long file can be streamed in constant memory.
+ *	- Allows splitting the file into runs of whole lines, so
+ *	  that they can be parsed in parallel.
+ *
+ * Assumptions:
+ *	- The file is not changed while it is open.
+ *	- A file that cannot be mapped, such as a pipe, is read
+ *	  into memory instead.
+ */
+//--------------------------------------------------------------------
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <vector>
+#include "field_reader.h"
+
+
+/**
+ * @class MappedFile
+ */
+class MappedFile {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a MappedFile with no file open.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This MappedFile was created closed.
+	 */
+	MappedFile ();
+
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Closes the file.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The file has been unmapped.
+	 */
+	~MappedFile ();
+
+
+	//---------------------open-----------------------------------
+	/**
+	 * @brief Maps the provided file, closing any file that was
+	 *	  open before.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the file was opened,
+	 *		   false otherwise.
+	 *
+	 * @param file The file to open.
+	 * @return True if opened, false otherwise.
+	 */
+	bool open (const char *file);
+
+
+	//---------------------close----------------------------------
+	/**
+	 * @brief Unmaps the file. FieldReaders over its lines must
+	 *	  no longer be used.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: No file is open.
+	 */
+	void close ();
+
+
+	//---------------------nextLine-------------------------------
+	/**
+	 * @brief Reads the next line, without its end of line.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: If there was another line, line walks it
+	 *		   and true was returned. Otherwise false was
+	 *		   returned.
+	 *
+	 * @param line Set to walk the line.
+	 * @return True if a line was read, false at the end of file.
+	 */
+	bool nextLine (FieldReader &line);
+
+
+	//---------------------release--------------------------------
+	/**
+	 * @brief Gives back the memory of the lines already read by
+	 *	  nextLine. The pages stay readable, and are read 
+	 *	  from the file again if touched.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The mapped pages before the next line were
+	 *		   dropped. A file read into memory is kept.
+	 */
+	void release ();
+
+
+	//---------------------split----------------------------------
+	/**
+	 * @brief Splits the whole file into up to count runs of
+	 *	  whole lines, of about the same size, in file order.
+	 *	  Does not change the next line read by nextLine.
+	 *
+	 * Preconditions: count is positive.
+	 *
+	 * Postconditions: chunks holds a FieldReader over each run.
+	 *
+	 * @param count The most runs to split into.
+	 * @param chunks Filled with the runs.
+	 */
+	void split (int count, vector<FieldReader> &chunks) const;
+
+
+	//---------------------getData--------------------------------
+	/**
+	 * @brief Returns the bytes of the file.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The first byte, or NULL if no file is open
+	 *		   or it is empty, was returned.
+	 *
+	 * @return The bytes of the file.
+	 */
+	const char * getData () const;
+
+
+	//---------------------getLength------------------------------
+	/**
+	 * @brief Returns the size of the file.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number of bytes was returned.
+	 *
+	 * @return The size of the file.
+	 */
+	long getLength () const;
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------Copy-Constructor-----------------------
+	/**
+	 * @brief Not implemented; a mapping has a single owner.
+	 */
+	MappedFile (const MappedFile &the_other);
+
+
+	//---------------------operator(=)----------------------------
+	/**
+	 * @brief Not implemented; a mapping has a single owner.
+	 */
+	const MappedFile & operator= (const MappedFile &the_other);
+
+
+	//---------------------readAll--------------------------------
+	/**
+	 * @brief Reads the whole of an open file into memory, for
+	 *	  files that cannot be mapped.
+	 *
+	 * Preconditions: descriptor is open for reading.
+	 *
+	 * Postconditions: True was returned if the file was read,
+	 *		   false otherwise.
+	 *
+	 * @param descriptor The file descriptor.
+	 * @return True if read, false otherwise.
+	 */
+	bool readAll (int descriptor);
+
+	/**
+	 * @brief The bytes of the file.
+	 */
+	char *my_data;
+
+	/**
+	 * @brief The number of bytes in the file.
+	 */
+	long my_length;
+
+	/**
+	 * @brief The offset of the next line.
+	 */
+	long my_position;
+
+	/**
+	 * @brief The offset up to which the pages were released.
+	 */
+	long my_released;
+
+	/**
+	 * @brief True if my_data is mapped, false if it was read
+	 *	  into memory allocated with new.
+	 */
+	bool my_mapped;
+};
+#endif /* MAPPED_FILE_H */
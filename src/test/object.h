@@ -20,6 +20,12 @@
  * 	- Allows clients to compare Objects for less than value.
  *	- Allows clients to display an Object using <<. 
  *	- Allows clients to clone an Object.
+ *	- Allows derived classes to set a precomputed sort key, so 
+ *	  containers can order Objects with one byte comparison.
+ *	  Sort keys are interned, so equal keys are one string and
+ *	  compare equal by address.
+ *	- Objects are allocated from the Region, so every Object of
+ *	  a run is freed at once when the Region is reset.
  * Assumptions:
  * 	- All derived classes of Item implement getNewInstance, and 
  *	  within the method return a dynamically allocated object of
@@ -32,7 +38,11 @@
 #define _OBJECT_H_
 
 #include <iostream>
-#include <fstream>
+#include "field_reader.h"
+#include "snapshot_file.h"
+#include "string_pool.h"
+#include "region.h"
+#include <string>
 /** 
  * @namespace std
  */
@@ -90,14 +100,49 @@ public:
 	 */
 	virtual ~Object () {}
 
+
+	//---------------------operator new---------------------------
+	/**
+	 * @brief Allocates a derived Object from the Region.
+	 * 
+ 	 * Preconditions: None.	
+	 *
+ 	 * Postconditions: Memory for the Object was returned.
+	 *
+	 * @param size The size of the derived Object.
+	 * @return The memory.
+	 */
+	static void * operator new (size_t size) 
+	{
+		return Region::allocate (size);
+	}
+
+
+	//---------------------operator delete------------------------
+	/**
+	 * @brief Gives the memory of a derived Object back to the 
+	 *	  Region, to be reused.
+	 * 
+ 	 * Preconditions: memory came from operator new for size.
+	 *
+ 	 * Postconditions: The memory was released.
+	 *
+	 * @param memory The memory of the Object.
+	 * @param size The size of the derived Object.
+	 */
+	static void operator delete (void *memory, size_t size)
+	{
+		Region::release (memory, size);
+	}
+
 	
 	//---------------------getNewInstance-------------------------
 	/**
 	 * @brief Retuns a pointer to a new instance of the derived
  	 *	  Object. The data of the new object will be set
-  	 *	  using the provided file stream.
+  	 *	  using the provided line.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *		  formatted according to Lab 4 specs.  	
 	 *
 	 * Postconditions: A new object of the derived type was 
@@ -105,11 +150,42 @@ public:
 	 *		   its data. A pointer to the object was then
 	 *		   returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return A pointer to a  new instance of the derived
 	 *	   Object.
 	 */
-	virtual Object * getNewInstance (ifstream &input) const = 0; 
+	virtual Object * getNewInstance (FieldReader &input) const = 0; 
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new derived Object, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a derived Object saved by save.
+	 *
+	 * Postconditions: A new derived Object was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Object * getNewInstance (SnapshotReader &input) const = 0;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes this Object to a snapshot, starting 
+	 *	  with the byte that a factory uses to pick the type
+	 *	  to read it back as.
+	 *	
+ 	 * Preconditions: A section of the snapshot is being written.
+	 *
+	 * Postconditions: This Object was written.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	virtual void save (SnapshotWriter &output) const = 0;
 
 	
 	//---------------------clone----------------------------------
@@ -174,6 +250,102 @@ public:
 	 *	   false otherwise.
  	 */
 	virtual bool operator== (const Object &the_other) const = 0; 
+
+
+	//---------------------compareTo------------------------------
+	/**
+	 * @brief Compares this Object with the_other in a single 
+	 *	  call. If both have a sort key the keys are compared
+	 *	  byte by byte, with no virtual calls, unless they are
+	 *	  the same pooled key. Otherwise the overloaded 
+	 *	  comparison operators are used.
+	 *
+	 * Preconditions: Sort keys order Objects the same way as the
+	 *		  overloaded comparison operators.
+	 *
+	 * Postconditions: A negative value was returned if this is 
+	 *		   less than the_other, zero if they are equal,
+	 *		   and a positive value otherwise.
+	 *
+	 * @param the_other The other Object to compare with.
+	 * @return The sign of the comparison.
+	 */
+	int compareTo (const Object &the_other) const
+	{
+		if (!my_sort_key.empty () && !the_other.my_sort_key.empty ()) {
+			if (my_sort_key == the_other.my_sort_key) return 0;
+			return my_sort_key.toString ().compare 
+					(the_other.my_sort_key.toString ());
+		}
+
+		if (*this < the_other) return -1;
+		if (the_other < *this) return 1;
+		return 0;
+	}
+
+
+	//---------------------getSortKey----------------------------
+	/**
+	 * @brief Returns the sort key of this Object.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The sort key, or an empty string if none 
+	 *		   was set, was returned.
+	 *
+	 * @return The sort key.
+	 */
+	const string & getSortKey () const 
+	{ 
+		return my_sort_key.toString (); 
+	}
+
+
+	//---------------------sameKey-------------------------------
+	/**
+	 * @brief Returns whether this Object and the_other have equal
+	 *	  sort keys, by comparing their handles.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the keys are equal.
+	 *
+	 * @param the_other The other Object.
+	 * @return True if the keys are equal, false otherwise.
+	 */
+	bool sameKey (const Object &the_other) const 
+	{ 
+		return my_sort_key == the_other.my_sort_key; 
+	}
+
+/**
+ * @protected
+ */
+protected:
+
+	//---------------------setSortKey----------------------------
+	/**
+	 * @brief Sets the sort key of this Object. Comparing two keys
+	 *	  as unsigned bytes must give the same order as the 
+	 *	  overloaded comparison operators.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The sort key was set.
+	 *
+	 * @param key The sort key, interned if it is a string.
+	 */
+	void setSortKey (const InternedString &key) { my_sort_key = key; }
+
+/**
+ * @private
+ */
+private:
+
+	/**
+	 * @brief The precomputed sort key, empty if not set.
+	 */
+	InternedString my_sort_key;
 }; 
 #endif /* _OBJECT_H_ */
 
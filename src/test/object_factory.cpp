@@ -47,7 +47,7 @@
  */
 ObjectFactory::ObjectFactory ()
 {
-	my_table   = new HashTable ();
+	my_table   = new HashTable<char, Object *> ();
 	my_objects = new vector<Object *>();
 }
  
@@ -92,18 +92,17 @@ void ObjectFactory::addObject (char key, Object *value)
 //---------------------getNewObject-----------------------------------
 /**
  * @brief Returns a new instance of a derived type of Object. Uses the
- *	  file to determine which type of object to instantiate.
+ *	  line to determine which type of object to instantiate.
  *
  * Preconditions: The Object class has a getNewInstance method. 
  *
  * Postconditions: A pointer to a new Object was returned.
  *
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return Returns a pointer to a new object.
  */
-Object * ObjectFactory::getNewObject (ifstream &input) const
+Object * ObjectFactory::getNewObject (FieldReader &input) const
 {
-	Object *ptr;
 	char type;
 
 	// Get the object type.	
@@ -111,15 +110,47 @@ Object * ObjectFactory::getNewObject (ifstream &input) const
 	// Is it a valid character?
 	if (isalpha (type)) { 
 		// Search the table for the type of object.  
-		ptr =  my_table->get (type);
+		Object * const *found = my_table->get (type);
 
 		// If found, return a new instance.
-		if (ptr) return ptr->getNewInstance (input);	
+		if (found) return (*found)->getNewInstance (input);	
 	}
 
-	// Bad type, or not found in table, so skip the line.
-	input.ignore (INT_MAX, '\n');
-	ptr = NULL;
+	// Bad type, or not found in table, so the line is skipped.
 	return NULL;
 }
 
+
+//---------------------getNewObject-----------------------------------
+/**
+ * @brief Returns a new instance of a derived type of Object, read from
+ *	  a snapshot. The type byte saved first determines which type
+ *	  of object to instantiate. A '\0' byte, saved in place of a 
+ *	  missing object, is read and NULL is returned.
+ *
+ * Preconditions: The snapshot is at an object written by save, or at
+ *		  a '\0' byte.
+ *
+ * Postconditions: A pointer to a new Object, or NULL, was returned. An
+ *		   unknown type fails input.
+ *
+ * @param input The snapshot to read from.
+ * @return Returns a pointer to a new object, or NULL.
+ */
+Object * ObjectFactory::getNewObject (SnapshotReader &input) const
+{
+	char type = input.peekByte ();
+
+	if (isalpha (type)) { 
+		Object * const *found = my_table->get (type);
+		if (found) return (*found)->getNewInstance (input);	
+	}
+	else if (type == '\0') {
+		input.getByte ();
+		return NULL;
+	}
+
+	// Nothing of this type was ever saved, so the snapshot is bad.
+	input.fail ();
+	return NULL;
+}
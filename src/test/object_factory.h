@@ -34,11 +34,11 @@
 //--------------------------------------------------------------------
 
 #ifndef OBJECT_FACTORY_H
-#define OBJECT_FACTORY_h
+#define OBJECT_FACTORY_H
 
-#include <fstream>
 #include <iostream>
 #include <string>
+#include "object.h"
 #include "hash_table.h"
 #include <vector>
 #include <cctype>
@@ -101,7 +101,7 @@ public:
 	//---------------------getNewObject---------------------------
 	/**
 	 * @brief Returns a new instance of a derived type of Object.
-	 *	  Uses the file to determine which type of object
+	 *	  Uses the line to determine which type of object
 	 *	  to instantiate.
 	 *
  	 * Preconditions: The Object class has a getNewInstance 
@@ -109,10 +109,30 @@ public:
 	 *
 	 * Postconditions: A pointer to a new Object was returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
  	 * @return Returns a pointer to a new object.
 	 */
-	Object * getNewObject (ifstream &input) const;	
+	Object * getNewObject (FieldReader &input) const;	
+
+
+	//---------------------getNewObject---------------------------
+	/**
+	 * @brief Returns a new instance of a derived type of Object,
+	 *	  read from a snapshot. The type byte saved first 
+	 *	  determines which type of object to instantiate. A
+	 *	  '\0' byte, saved in place of a missing object, is 
+	 *	  read and NULL is returned.
+	 *
+ 	 * Preconditions: The snapshot is at an object written by 
+	 *		  save, or at a '\0' byte.
+	 *
+	 * Postconditions: A pointer to a new Object, or NULL, was 
+	 *		   returned. An unknown type fails input.
+	 *
+	 * @param input The snapshot to read from.
+ 	 * @return Returns a pointer to a new object, or NULL.
+	 */
+	Object * getNewObject (SnapshotReader &input) const;
 
 /**
  * @private 
@@ -122,7 +142,7 @@ private:
 	/**
 	 * @brief The look-up hashtable for objects.
 	 */	
-	HashTable *my_table; 
+	HashTable<char, Object *> *my_table; 
 
 	/**
 	 * @brief The list of objects in the factory.
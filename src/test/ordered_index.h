@@ -0,0 +1,237 @@
+/**
+ * @file ordered_index.h 
+ * 
+ * @brief OrderedIndex is an abstract base class for the sorted 
+ *	  containers the store keeps its Objects in. It lets the 
+ *	  StoreManager hold a BSTree or a BPlusTree behind the same
+ *	  interface. 
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\> 
+ *  
+ * @version 1.0.0
+ * @date November 16, 2010
+ */ 
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ *	- Allows displaying the contents of an OrderedIndex using <<.
+ * 	- Allows inserting an object into the index.
+ *	- Allows retrieving a specified object from the index.
+ *	- Allows removing an occurrence of an object from the index.
+ *	- Allows making the index empty, with or without deleting
+ *	  the stored objects.
+ *	- Allows getting the occurrence count of an object.
+ *	- Allows building the index from sorted objects at once.
+ * Assumptions:
+ * 	- Data objects are not NULL when stored in the index.
+ *	- Data objects have overloaded operator<< for displaying.
+ *	- Data objects have overloaded comparison operators for 
+ *	  sorting.
+ *	- Occurrence counts count how often an equal object was
+ *	  added. The StoreManager's inventory trees hold each title
+ *	  once with a count of 1; their stock is kept apart, so 
+ *	  those counts do not track it.
+ */
+//--------------------------------------------------------------------
+
+#ifndef ORDERED_INDEX_H
+#define ORDERED_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include "object.h"
+
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class OrderedIndex
+ */
+class OrderedIndex {
+
+	//---------------------operator<<-----------------------------
+	/**
+	 * @brief Overloaded output operator.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The objects of the index have been sent 
+ 	 *		   to the output stream in order.
+	 * 
+	 * @param output The output stream.
+	 * @param index The OrderedIndex to output.
+	 * @return The output stream.
+	 */
+	friend ostream& operator<< (ostream &output, 
+					const OrderedIndex &index)
+	{ 
+		index.print (output);
+		return output;
+	}	
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Releases all resources obtained by this index. 
+	 * 
+ 	 * Preconditions: None.	
+	 *
+ 	 * Postconditions: All dynamic memory has been released. 
+	 */
+	virtual ~OrderedIndex () {}
+
+
+	//---------------------insert---------------------------------
+	/**
+	 * @brief Inserts an item into the index. If an equal item is
+	 *	  already stored its occurrence count is incremented
+	 *	  and ownership of item stays with the client.
+	 *
+	 * Preconditions: The item is not NULL.
+	 *
+ 	 * Postconditions: The item was inserted into the index.
+	 *
+	 * @param item The item to insert into the index.
+	 * @return True if successfully inserted, false otherwise.
+	 */
+	virtual bool insert (Object *item) = 0;
+
+
+	//---------------------retrieve-------------------------------
+	/**
+	 * @brief Searches the index for the given target.
+	 * 
+	 * Preconditions: None.
+	 * 	
+	 * Postconditions: A pointer to the object was returned if it
+	 *		   was found, NULL otherwise.
+	 * 
+	 * @param target The item to search for.
+	 * @return Pointer to the object if found, NULL otherwise.
+	 */
+	virtual const Object * retrieve (const Object &target) const = 0;
+
+
+	//---------------------remove---------------------------------
+	/**
+	 * @brief Removes one occurrence of the provided item from 
+	 *	  the index.
+	 *
+	 * Preconditions: None.
+	 * 	
+ 	 * Postconditions: True was returned if an occurrence of the
+	 *		   item was found and removed, false otherwise.
+	 *
+	 * @param item The item to remove from the index.
+	 * @return True if removed, false otherwise.
+	 */
+	virtual bool remove (const Object &item) = 0;
+
+
+	//---------------------makeEmpty------------------------------
+	/**
+	 * @brief Empties this index and deletes the stored items.
+	 * 	
+ 	 * Preconditions: None.
+	 *
+	 * Postconditions: The index is empty.
+	 */
+	virtual void makeEmpty () = 0;
+
+
+	//---------------------clear----------------------------------
+	/**
+	 * @brief Empties this index without deleting the stored items,
+	 *	  which are freed with the Region.
+	 * 	
+ 	 * Preconditions: None.
+	 *
+	 * Postconditions: The index is empty.
+	 */
+	virtual void clear () = 0;
+
+
+	//---------------------getOccurrence--------------------------
+	/**
+	 * @brief Returns the occurrence count of the item. For the
+	 *	  inventory trees this is 1 for every stored title, 
+	 *	  not its stock.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The occurrence count, or zero if the item is
+	 *		   not stored, was returned. 
+	 * 
+	 * @param item The item to get the count of. 
+	 * @return Occurrence count of the item.
+	 */
+	virtual int getOccurrence (const Object &item) const = 0;
+
+
+	//---------------------print----------------------------------
+	/** 
+	 * @brief Prints the objects of this index to the output 
+	 *	  stream in order, one per line.
+	 * 
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The objects have been displayed.
+	 *
+	 * @param output The output stream. 
+ 	 */
+	virtual void print (ostream &output) const = 0;
+
+
+	//---------------------build----------------------------------
+	/**
+	 * @brief Adds the provided items, with their occurrence 
+	 *	  counts, to the index. Derived classes that can load
+	 *	  sorted input faster override this; by default each
+	 *	  item is inserted count times.
+	 * 
+	 * Preconditions: items is sorted in ascending order with no 
+	 *		  two items equal, and counts[i] is positive
+	 *		  for every items[i].
+	 * 
+	 * Postconditions: The index took ownership of the items and
+	 *		   holds them with their counts.
+	 * 
+	 * @param items The sorted items.
+	 * @param counts The occurrence count of each item.
+	 */
+	virtual void build (const vector<Object *> &items, 
+					const vector<int> &counts)
+	{
+		int index, count;
+		for (index = 0; index < (int)items.size (); index++)
+			for (count = 0; count < counts [index]; count++)
+				insert (items [index]);
+	}
+
+
+	//---------------------collect--------------------------------
+	/**
+	 * @brief Lists the items of the index in ascending order,
+	 *	  with their occurrence counts; the inverse of build.
+	 * 
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: items and counts were appended to. The 
+	 *		   index still owns the items.
+	 * 
+	 * @param items Filled with the items.
+	 * @param counts Filled with the occurrence count of each item.
+	 */
+	virtual void collect (vector<const Object *> &items, 
+					vector<int> &counts) const = 0;
+};
+#endif /* ORDERED_INDEX_H */
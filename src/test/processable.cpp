@@ -52,7 +52,7 @@ Processable::Processable () : Transaction ()
  * @param type The type of transaction. 
  * @param item The Item associated with this transaction. 
  */
-Processable::Processable (int cust_id, char type, Item *item)
+Processable::Processable (long long cust_id, char type, Item *item)
 				: Transaction (type)
 {
 	my_item = item;
@@ -110,6 +110,28 @@ void Processable::print (ostream &output) const
 }
 
 
+//---------------------save-------------------------------------------
+/**
+ * @brief Writes this Processable to a snapshot: its type and customer ID, 
+ *	  then its Item, or a '\0' byte if it has none.
+ *	
+ * Preconditions: A section of the snapshot is being written.
+ *
+ * Postconditions: This Processable was written.
+ *
+ * @param output The snapshot to write to.
+ */
+void Processable::save (SnapshotWriter &output) const
+{
+	Transaction::save (output);
+	output.putLong (my_id);
+	if (my_item) 
+		my_item->save (output);
+	else 
+		output.putByte ('\0');
+}
+
+
 //---------------------getCustomerId----------------------------------
 /**
  * @brief Returns the customer's ID associated with this transaction. 
@@ -120,7 +142,7 @@ void Processable::print (ostream &output) const
  *
  * @return The customer ID.
  */
-int Processable::getCustomerId () const
+long long Processable::getCustomerId () const
 {
 	return my_id;
 }
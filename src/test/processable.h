@@ -66,7 +66,7 @@ public:
 	 * @param type The type of transaction. 
 	 * @param item The Item associated with this transaction. 
 	 */
-	Processable (int cust_id, char type, Item *item);
+	Processable (long long cust_id, char type, Item *item);
 
 	
 	//---------------------Destructor-----------------------------
@@ -116,19 +116,52 @@ public:
 	/**
 	 * @brief Retuns a pointer to a new Processable. 
 	 *	  The data of the new object will be set using the 
-	 *	  provided file stream.
+	 *	  provided line.
 	 *	
-	 * Preconditions: The file stream is open and correctly 
+	 * Preconditions: The line is correctly
 	 *		  formatted according to Lab 4 specs.  	
 	 *
 	 * Postconditions: A new object was created using the provided
 	 *		   file to set its data. A pointer to the 
 	 *		   object was then returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return A pointer to the new instance.
 	 */
-	virtual Processable * getNewInstance (ifstream &input) const = 0;
+	virtual Processable * getNewInstance (FieldReader &input) const = 0;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new Processable, read from a 
+	 *	  snapshot written by save.
+	 *	  The Item saved with it is left in the snapshot, 
+	 *	  for the caller to read with the Item factory.
+	 *	
+ 	 * Preconditions: The snapshot is at a Processable saved by save.
+	 *
+	 * Postconditions: A new Processable was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Processable * getNewInstance (SnapshotReader &input) const = 0;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes this Processable to a snapshot: its 
+	 *	  type and customer ID, then its Item, or a '\0' byte
+	 *	  if it has none.
+	 *	
+ 	 * Preconditions: A section of the snapshot is being written.
+	 *
+	 * Postconditions: This Processable was written.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	virtual void save (SnapshotWriter &output) const;
 
 
 	//---------------------clone----------------------------------
@@ -155,21 +188,9 @@ public:
 	 *
 	 * @return The customer ID.
 	 */
-	int getCustomerId () const;
+	long long getCustomerId () const;
 
 
-	//---------------------execute--------------------------------
-	/**
-	 * @brief Calls the appropriate method on the store manager.
-	 * 
-	 * Preconditions: The storemanager is not NULL.
-	 *
-	 * Postconditions: The storemanager's method has been called.
-	 *
-	 * @param mgr The store manager.
-	 */
-	virtual void execute (StoreManager *mgr) const = 0;
-
 		
 	//---------------------setItem--------------------------------
 	/**
@@ -196,10 +217,7 @@ private:
 	/**
 	 * @brief The customer ID associated with this transaction.
 	 */
-	int my_id; 
-
-	item *tem = new Item;
-	item *tem = new item;
+	long long my_id; 
 };
 #endif /* PROCESSABL_H */
 
@@ -29,7 +29,6 @@
 //--------------------------------------------------------------------
 
 #include "purchase_transaction.h"
-#include "store_manager.h"
 
 //--------------------Default-Constructor-----------------------------
 /**
@@ -57,7 +56,7 @@ PurchaseTransaction::PurchaseTransaction () : Processable () {}
  * @param item The item assocaited with the transaction.
  * @param type The type of transaction.
  */
-PurchaseTransaction::PurchaseTransaction (int cust_id,
+PurchaseTransaction::PurchaseTransaction (long long cust_id,
 	 char type, Item *item) : Processable (cust_id, type, item) {}
 
 
@@ -94,30 +93,54 @@ void PurchaseTransaction::print (ostream &output) const
 //---------------------getNewInstance---------------------------------
 /**
  * @brief Retuns a pointer to a new PurchaseTransaction. The data of
- *	  the new object will be set using the provided file stream.
+ *	  the new object will be set using the provided line.
  *	
- * Preconditions: The file stream is open and correctly formatted
+ * Preconditions: The line is correctly formatted
  *		  according to Lab 4 specs.  	
  *
  * Postconditions: A new object was created using the provided file to
  *		   set its data. A pointer to the object was then 
  *		   returned.
  *
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return A pointer to the new instance.
  */
 PurchaseTransaction * PurchaseTransaction::getNewInstance 
-				(ifstream &input) const
+				(FieldReader &input) const
 {
 	char type;
-	int id;
-	string temp;
-	input >> type; input.ignore ();
-	input >> id;  input.ignore (); input.ignore (); 
+	long long id;
+	type = input.readChar (); input.skip (1);
+	input.readLong (id);  input.skip (2); 
 	return new PurchaseTransaction (id, type, NULL);	
 }
 
 
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new PurchaseTransaction, read from a snapshot 
+ *	  written by save.
+ *	  The Item saved with it is left in the snapshot, for the 
+ *	  caller to read with the Item factory.
+ *	
+ * Preconditions: The snapshot is at a PurchaseTransaction saved by save.
+ *
+ * Postconditions: A new PurchaseTransaction was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+PurchaseTransaction * PurchaseTransaction::getNewInstance (SnapshotReader &input) const
+{
+	char type;
+	long long id;
+	type = input.getByte ();
+	id   = input.getLong ();
+	return new PurchaseTransaction (id, type, NULL);
+}
+
+
 //---------------------clone------------------------------------------
 /**
  * @brief Clones this Transaction.
@@ -141,20 +164,3 @@ PurchaseTransaction * PurchaseTransaction::clone () const
 					getType(),
 					NULL);
 }
-
-
-//---------------------execute----------------------------------------
-/**
- * @brief Calls the appropriate method on the store manager.
- * 
- * Preconditions: The storemanager is not NULL.
- *
- * Postconditions: The storemanager's method has been called.
- *
- * @param mgr The store manager.
- */
-void PurchaseTransaction::execute (StoreManager *mgr) const
-{
-	mgr->purchase ();	
-}
-
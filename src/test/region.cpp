@@ -0,0 +1,330 @@
+/**
+ * @file region.cpp
+ *
+ * @brief The Region is the store-wide allocator that the Items,
+ *	  Customers and Transactions of a run come from. Memory is
+ *	  carved out of large chunks by bumping a pointer, so the
+ *	  objects of a run sit together, and a single reset frees all
+ *	  of them at once, without visiting any.
+ *
+ * @brief Each thread carves from a block of its own, so threads
+ *	  that load the store in parallel do not contend. A freed
+ *	  object goes on a free list of its size, and is handed out
+ *	  again before any new memory is carved.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows allocating and releasing memory from several threads
+ *	  at once.
+ *	- Allows freeing everything allocated, in one step.
+ *	- Allows standard containers to keep their elements in the
+ *	  Region, through a RegionAllocator.
+ *
+ * Assumptions:
+ *	- No thread uses memory from the Region while it is reset,
+ *	  and none uses what was allocated before the reset after.
+ *	- Released memory larger than the largest size class stays
+ *	  in the Region until the next reset.
+ */
+//--------------------------------------------------------------------
+
+#include "region.h"
+
+vector<char *> * Region::my_chunks = NULL;
+size_t Region::my_size = 0;
+Region::Block * Region::my_batches [Region::CLASSES];
+unsigned int Region::my_generation = 0;
+pthread_mutex_t Region::my_lock;
+pthread_key_t Region::my_key;
+pthread_once_t Region::my_once = PTHREAD_ONCE_INIT;
+
+//---------------------allocate---------------------------------------
+/**
+ * @brief Returns memory for an object of the provided size. A block
+ *	  released by this thread is reused first, then the rest of
+ *	  its chunk. Only when both run out is the lock taken, to get
+ *	  a batch of blocks other threads released, or a new chunk.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: Memory of at least size bytes, aligned for any
+ *		   object, was returned.
+ *
+ * @param size The number of bytes.
+ * @return The memory.
+ */
+void * Region::allocate (size_t size)
+{
+	Cache *local = cache ();
+	Block *block;
+	char *memory;
+	int index;
+
+	size  = size == 0 ? GRAIN : (size + GRAIN - 1) / GRAIN * GRAIN;
+	index = (int)(size / GRAIN) - 1;
+
+	if (index < CLASSES && local->free [index] != NULL) {
+		block = local->free [index];
+		local->free [index] = block->next;
+		local->count [index]--;
+		return block;
+	}
+	if (local->next + size <= local->end) {
+		memory = local->next;
+		local->next += size;
+		return memory;
+	}
+
+	pthread_mutex_lock (&my_lock);
+	if (index < CLASSES && my_batches [index] != NULL) {
+		// Take a batch, and hand out its first block.
+		block = my_batches [index];
+		my_batches [index] = block->batch;
+		local->free [index] = block->next;
+		for (Block *rest = block->next; rest != NULL; 
+							rest = rest->next) 
+			local->count [index]++;
+		memory = reinterpret_cast<char *> (block);
+	}
+	else if (size > CHUNK_SIZE / 4) {
+		// Too large to carve; it gets a chunk of its own.
+		memory = carve (size);
+	}
+	else {
+		local->next = carve (CHUNK_SIZE);
+		local->end  = local->next + CHUNK_SIZE;
+		memory = local->next;
+		local->next += size;
+	}
+	pthread_mutex_unlock (&my_lock);
+	return memory;
+}
+
+
+//---------------------release----------------------------------------
+/**
+ * @brief Gives back memory so it can be allocated again. The block
+ *	  goes on this thread's free list of its size. When the list
+ *	  grows past two batches, a batch is shared, so a thread that
+ *	  only frees what others allocate does not hoard memory.
+ *
+ * Preconditions: memory is NULL, or was returned by allocate for size
+ *		  bytes since the last reset.
+ *
+ * Postconditions: The memory may be handed out again.
+ *
+ * @param memory The memory to give back.
+ * @param size The number of bytes it was allocated for.
+ */
+void Region::release (void *memory, size_t size)
+{
+	Cache *local;
+	Block *block;
+	int index;
+
+	if (memory == NULL) return;
+	size  = size == 0 ? GRAIN : (size + GRAIN - 1) / GRAIN * GRAIN;
+	index = (int)(size / GRAIN) - 1;
+	if (index >= CLASSES) return;
+
+	local = cache ();
+	block = static_cast<Block *> (memory);
+	block->next = local->free [index];
+	local->free [index] = block;
+	if (++local->count [index] >= 2 * BATCH) {
+		pthread_mutex_lock (&my_lock);
+		share (local, index);
+		pthread_mutex_unlock (&my_lock);
+	}
+}
+
+
+//---------------------reset------------------------------------------
+/**
+ * @brief Frees everything allocated from the Region. The generation
+ *	  is raised, so every thread's Cache is emptied before its
+ *	  next use.
+ *
+ * Preconditions: No thread uses memory from the Region.
+ *
+ * Postconditions: Every chunk was freed, and the Region is empty.
+ */
+void Region::reset ()
+{
+	pthread_once (&my_once, create);
+	pthread_mutex_lock (&my_lock);
+	for (int i = 0; i < (int)my_chunks->size (); i++)
+		delete [] my_chunks->at (i);
+	my_chunks->clear ();
+	for (int i = 0; i < CLASSES; i++)
+		my_batches [i] = NULL;
+	my_size = 0;
+	my_generation++;
+	pthread_mutex_unlock (&my_lock);
+}
+
+
+//---------------------getSize----------------------------------------
+/**
+ * @brief Returns the number of bytes the Region holds, in use or not.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The bytes in all chunks were returned.
+ *
+ * @return The bytes held.
+ */
+size_t Region::getSize ()
+{
+	size_t size;
+
+	pthread_once (&my_once, create);
+	pthread_mutex_lock (&my_lock);
+	size = my_size;
+	pthread_mutex_unlock (&my_lock);
+	return size;
+}
+
+
+//---------------------cache------------------------------------------
+/**
+ * @brief Returns the Cache of the calling thread, creating the Region
+ *	  and the Cache on first use, and emptying the Cache if the
+ *	  Region was reset since it was last used.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: A current Cache was returned.
+ *
+ * @return The thread's Cache.
+ */
+Region::Cache * Region::cache ()
+{
+	Cache *local;
+
+	pthread_once (&my_once, create);
+	local = static_cast<Cache *> (pthread_getspecific (my_key));
+	if (local == NULL) {
+		local = new Cache;
+		local->generation = my_generation - 1;
+		pthread_setspecific (my_key, local);
+	}
+	if (local->generation != my_generation) {
+		// Whatever it held was freed by the reset.
+		local->next = NULL;
+		local->end  = NULL;
+		for (int i = 0; i < CLASSES; i++) {
+			local->free [i]  = NULL;
+			local->count [i] = 0;
+		}
+		local->generation = my_generation;
+	}
+	return local;
+}
+
+
+//---------------------create-----------------------------------------
+/**
+ * @brief Creates the lock, the thread key and the chunk list. Run
+ *	  once, by cache.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The Region was created.
+ */
+void Region::create ()
+{
+	pthread_mutex_init (&my_lock, NULL);
+	pthread_key_create (&my_key, retire);
+	my_chunks = new vector<char *> ();
+	for (int i = 0; i < CLASSES; i++)
+		my_batches [i] = NULL;
+}
+
+
+//---------------------retire-----------------------------------------
+/**
+ * @brief Hands the released blocks of an exiting thread to the other
+ *	  threads, and deletes its Cache. The rest of its chunk is
+ *	  left unused until the next reset.
+ *
+ * Preconditions: cache is the Cache of an exiting thread.
+ *
+ * Postconditions: Its blocks are shared, unless it was stale.
+ *
+ * @param cache The Cache.
+ */
+void Region::retire (void *cache)
+{
+	Cache *local = static_cast<Cache *> (cache);
+
+	pthread_mutex_lock (&my_lock);
+	if (local->generation == my_generation) {
+		for (int i = 0; i < CLASSES; i++)
+			while (local->free [i] != NULL)
+				share (local, i);
+	}
+	pthread_mutex_unlock (&my_lock);
+	delete local;
+}
+
+
+//---------------------share------------------------------------------
+/**
+ * @brief Moves a batch of the released blocks of one size from a
+ *	  Cache to the shared lists. The blocks stay linked through
+ *	  next; the first one links the batch to the others.
+ *
+ * Preconditions: my_lock is held, and the Cache holds at least one
+ *		  block of the size.
+ *
+ * Postconditions: Up to BATCH blocks were moved.
+ *
+ * @param cache The Cache.
+ * @param size The size class.
+ */
+void Region::share (Cache *cache, int size)
+{
+	Block *first = cache->free [size];
+	Block *last  = first;
+	int moved    = 1;
+
+	while (moved < BATCH && last->next != NULL) {
+		last = last->next;
+		moved++;
+	}
+	cache->free [size]   = last->next;
+	cache->count [size] -= moved;
+	last->next   = NULL;
+	first->batch = my_batches [size];
+	my_batches [size] = first;
+}
+
+
+//---------------------carve------------------------------------------
+/**
+ * @brief Allocates a new chunk and records it, so reset can free it.
+ *
+ * Preconditions: my_lock is held.
+ *
+ * Postconditions: A chunk of size bytes was returned.
+ *
+ * @param size The number of bytes.
+ * @return The chunk.
+ */
+char * Region::carve (size_t size)
+{
+	char *chunk = new char [size];
+
+	my_chunks->push_back (chunk);
+	my_size += size;
+	return chunk;
+}
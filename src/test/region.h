@@ -0,0 +1,367 @@
+/**
+ * @file region.h
+ *
+ * @brief The Region is the store-wide allocator that the Items,
+ *	  Customers and Transactions of a run come from. Memory is
+ *	  carved out of large chunks by bumping a pointer, so the
+ *	  objects of a run sit together, and a single reset frees all
+ *	  of them at once, without visiting any.
+ *
+ * @brief Each thread carves from a block of its own, so threads
+ *	  that load the store in parallel do not contend. A freed
+ *	  object goes on a free list of its size, and is handed out
+ *	  again before any new memory is carved.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows allocating and releasing memory from several threads
+ *	  at once.
+ *	- Allows freeing everything allocated, in one step.
+ *	- Allows standard containers to keep their elements in the
+ *	  Region, through a RegionAllocator.
+ *
+ * Assumptions:
+ *	- No thread uses memory from the Region while it is reset,
+ *	  and none uses what was allocated before the reset after.
+ *	- Released memory larger than the largest size class stays
+ *	  in the Region until the next reset.
+ */
+//--------------------------------------------------------------------
+
+#ifndef REGION_H
+#define REGION_H
+
+#include <new>
+#include <cstddef>
+#include <vector>
+#include <pthread.h>
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class Region
+ */
+class Region {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------allocate-------------------------------
+	/**
+	 * @brief Returns memory for an object of the provided size,
+	 *	  reusing a released block of its size if there is one.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: Memory of at least size bytes, aligned for
+	 *		   any object, was returned.
+	 *
+	 * @param size The number of bytes.
+	 * @return The memory.
+	 */
+	static void * allocate (size_t size);
+
+
+	//---------------------release--------------------------------
+	/**
+	 * @brief Gives back memory so it can be allocated again.
+	 *
+	 * Preconditions: memory is NULL, or was returned by allocate
+	 *		  for size bytes since the last reset.
+	 *
+	 * Postconditions: The memory may be handed out again.
+	 *
+	 * @param memory The memory to give back.
+	 * @param size The number of bytes it was allocated for.
+	 */
+	static void release (void *memory, size_t size);
+
+
+	//---------------------reset----------------------------------
+	/**
+	 * @brief Frees everything allocated from the Region.
+	 *
+	 * Preconditions: No thread uses memory from the Region.
+	 *
+	 * Postconditions: Every chunk was freed, and the Region is
+	 *		   empty.
+	 */
+	static void reset ();
+
+
+	//---------------------getSize--------------------------------
+	/**
+	 * @brief Returns the number of bytes the Region holds.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The bytes in all chunks were returned.
+	 *
+	 * @return The bytes held.
+	 */
+	static size_t getSize ();
+
+/**
+ * @private
+ */
+private:
+
+	/**
+	 * @brief The size every block is rounded up to a multiple of.
+	 */
+	static const size_t GRAIN = 16;
+
+	/**
+	 * @brief The number of size classes. Larger blocks are not
+	 *	  reused.
+	 */
+	static const int CLASSES = 16;
+
+	/**
+	 * @brief The blocks moved between a Cache and the shared lists
+	 *	  at a time.
+	 */
+	static const int BATCH = 32;
+
+	/**
+	 * @brief The bytes in the chunk a thread carves from.
+	 */
+	static const size_t CHUNK_SIZE = 64 * 1024;
+
+	/**
+	 * @brief A released block, linked to the next one of its size.
+	 *	  The first block of a batch also links to the next
+	 *	  batch.
+	 */
+	struct Block {
+		Block *next;
+		Block *batch;
+	};
+
+	/**
+	 * @brief The memory a thread allocates from without locking:
+	 *	  the rest of its block, and the released blocks of each
+	 *	  size. It is stale once the Region is reset.
+	 */
+	struct Cache {
+		char *next;
+		char *end;
+		unsigned int generation;
+		Block *free [CLASSES];
+		int count [CLASSES];
+	};
+
+
+	//---------------------cache----------------------------------
+	/**
+	 * @brief Returns the Cache of the calling thread, creating the
+	 *	  Region and the Cache on first use, and emptying the
+	 *	  Cache if it is stale.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: A current Cache was returned.
+	 *
+	 * @return The thread's Cache.
+	 */
+	static Cache * cache ();
+
+
+	//---------------------create---------------------------------
+	/**
+	 * @brief Creates the lock, the thread key and the chunk list.
+	 *	  Run once, by cache.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The Region was created.
+	 */
+	static void create ();
+
+
+	//---------------------retire---------------------------------
+	/**
+	 * @brief Hands the released blocks of an exiting thread to the
+	 *	  other threads, and deletes its Cache. Run by the thread
+	 *	  key.
+	 *
+	 * Preconditions: cache is the Cache of an exiting thread.
+	 *
+	 * Postconditions: Its blocks are shared, unless it was stale.
+	 *
+	 * @param cache The Cache.
+	 */
+	static void retire (void *cache);
+
+
+	//---------------------share----------------------------------
+	/**
+	 * @brief Moves a batch of the released blocks of one size from
+	 *	  a Cache to the shared lists.
+	 *
+	 * Preconditions: my_lock is held, and the Cache holds at
+	 *		  least one block of the size.
+	 *
+	 * Postconditions: Up to BATCH blocks were moved.
+	 *
+	 * @param cache The Cache.
+	 * @param size The size class.
+	 */
+	static void share (Cache *cache, int size);
+
+
+	//---------------------carve----------------------------------
+	/**
+	 * @brief Allocates a new chunk and records it.
+	 *
+	 * Preconditions: my_lock is held.
+	 *
+	 * Postconditions: A chunk of size bytes was returned.
+	 *
+	 * @param size The number of bytes.
+	 * @return The chunk.
+	 */
+	static char * carve (size_t size);
+
+	/**
+	 * @brief The chunks, freed on reset.
+	 */
+	static vector<char *> *my_chunks;
+
+	/**
+	 * @brief The bytes in the chunks.
+	 */
+	static size_t my_size;
+
+	/**
+	 * @brief Batches of released blocks of each size, shared by
+	 *	  the threads.
+	 */
+	static Block *my_batches [CLASSES];
+
+	/**
+	 * @brief Raised on every reset, so the Caches can tell they are
+	 *	  stale.
+	 */
+	static unsigned int my_generation;
+
+	/**
+	 * @brief Guards the chunks and the shared batches.
+	 */
+	static pthread_mutex_t my_lock;
+
+	/**
+	 * @brief Holds the Cache of each thread.
+	 */
+	static pthread_key_t my_key;
+
+	/**
+	 * @brief Makes sure the Region is created once.
+	 */
+	static pthread_once_t my_once;
+};
+
+
+/**
+ * @class RegionAllocator
+ *
+ * @brief A standard allocator that keeps the elements of a container
+ *	  in the Region, so they are freed with the objects that hold
+ *	  the container.
+ */
+template <class T>
+class RegionAllocator {
+
+/**
+ * @public
+ */
+public:
+
+	typedef T		value_type;
+	typedef T *		pointer;
+	typedef const T *	const_pointer;
+	typedef T &		reference;
+	typedef const T &	const_reference;
+	typedef size_t		size_type;
+	typedef ptrdiff_t	difference_type;
+
+	/**
+	 * @brief The RegionAllocator for another element type.
+	 */
+	template <class U>
+	struct rebind {
+		typedef RegionAllocator<U> other;
+	};
+
+	RegionAllocator () {}
+
+	template <class U>
+	RegionAllocator (const RegionAllocator<U> &) {}
+
+	pointer address (reference value) const { return &value; }
+
+	const_pointer address (const_reference value) const
+	{
+		return &value;
+	}
+
+	//---------------------allocate-------------------------------
+	/**
+	 * @brief Returns room for count elements from the Region.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: Uninitialized room was returned.
+	 *
+	 * @param count The number of elements.
+	 * @return The room.
+	 */
+	pointer allocate (size_type count, const void * = 0)
+	{
+		return static_cast<pointer> (
+				Region::allocate (count * sizeof (T)));
+	}
+
+	//---------------------deallocate-----------------------------
+	/**
+	 * @brief Gives room for count elements back to the Region.
+	 *
+	 * Preconditions: room was returned by allocate for count.
+	 *
+	 * Postconditions: The room was released.
+	 *
+	 * @param room The room.
+	 * @param count The number of elements.
+	 */
+	void deallocate (pointer room, size_type count)
+	{
+		Region::release (room, count * sizeof (T));
+	}
+
+	size_type max_size () const { return size_t (-1) / sizeof (T); }
+
+	void construct (pointer room, const T &value)
+	{
+		new (room) T (value);
+	}
+
+	void destroy (pointer room) { room->~T (); }
+
+	bool operator== (const RegionAllocator &) const { return true; }
+
+	bool operator!= (const RegionAllocator &) const { return false; }
+};
+#endif /* REGION_H */
@@ -0,0 +1,294 @@
+/**
+ * @file report_writer.cpp
+ *
+ * @brief The ReportWriter is the sink the StoreManager prints its
+ *	  reports and diagnostics to. It is a stream buffer: what is
+ *	  printed is copied into a large buffer, and a writer thread
+ *	  writes each full buffer to a file descriptor, so printing
+ *	  never waits for a write.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows printing to an ostream made on the ReportWriter.
+ *	  Flushing the ostream, as endl does, does not write.
+ *	- Allows waiting until everything printed was written.
+ *
+ * Assumptions:
+ *	- One thread prints to a ReportWriter.
+ *	- Nothing else writes to the descriptor while output is
+ *	  pending. Callers drain before they write to it another way.
+ */
+//--------------------------------------------------------------------
+
+#include <errno.h>
+#include <unistd.h>
+#include "report_writer.h"
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a ReportWriter for the provided descriptor, and
+ *	  starts the writer thread.
+ *
+ * Preconditions: descriptor is open for writing.
+ *
+ * Postconditions: This ReportWriter was created empty.
+ *
+ * @param descriptor The descriptor to write to.
+ */
+ReportWriter::ReportWriter (int descriptor)
+{
+	my_descriptor = descriptor;
+	my_buffer.resize (BUFFER_SIZE);
+	setp (&my_buffer [0], &my_buffer [0] + BUFFER_SIZE);
+	my_writing    = false;
+	my_closing    = false;
+	my_failed     = false;
+	pthread_mutex_init (&my_lock, NULL);
+	pthread_cond_init  (&my_wake, NULL);
+	pthread_cond_init  (&my_written, NULL);
+
+	// Without the thread, the printing thread writes each buffer.
+	my_threaded = pthread_create (&my_thread, NULL, writer, this) == 0;
+}
+
+
+//---------------------Destructor-------------------------------------
+/**
+ * @brief Writes everything printed, and stops the writer. The writer
+ *	  writes whatever is waiting before it stops. The descriptor
+ *	  is left open.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: Everything printed was written.
+ */
+ReportWriter::~ReportWriter ()
+{
+	handOff ();
+	pthread_mutex_lock (&my_lock);
+	my_closing = true;
+	if (my_threaded) pthread_cond_signal (&my_wake);
+	pthread_mutex_unlock (&my_lock);
+
+	if (my_threaded) pthread_join (my_thread, NULL);
+	pthread_cond_destroy  (&my_written);
+	pthread_cond_destroy  (&my_wake);
+	pthread_mutex_destroy (&my_lock);
+}
+
+
+//---------------------drain------------------------------------------
+/**
+ * @brief Waits until everything printed was written. What is still
+ *	  buffered is handed off first.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if every write succeeded, false
+ *		   otherwise.
+ *
+ * @return True if written, false otherwise.
+ */
+bool ReportWriter::drain ()
+{
+	bool written;
+
+	handOff ();
+	pthread_mutex_lock (&my_lock);
+	while (!my_ready.empty () || my_writing)
+		pthread_cond_wait (&my_written, &my_lock);
+	written = !my_failed;
+	pthread_mutex_unlock (&my_lock);
+	return written;
+}
+
+
+//---------------------overflow---------------------------------------
+/**
+ * @brief Hands the full buffer to the writer, then buffers the
+ *	  provided character.
+ *
+ * Preconditions: The buffer is full.
+ *
+ * Postconditions: The character was buffered.
+ *
+ * @param c The character, or eof.
+ * @return A value other than eof.
+ */
+ReportWriter::int_type ReportWriter::overflow (int_type c)
+{
+	handOff ();
+	if (!traits_type::eq_int_type (c, traits_type::eof ())) {
+		*pptr () = traits_type::to_char_type (c);
+		pbump (1);
+	}
+	return traits_type::not_eof (c);
+}
+
+
+//---------------------xsputn-----------------------------------------
+/**
+ * @brief Buffers the provided characters, handing each buffer that 
+ *	  fills to the writer.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The characters were buffered.
+ *
+ * @param text The characters.
+ * @param count The number of characters.
+ * @return count.
+ */
+streamsize ReportWriter::xsputn (const char *text, streamsize count)
+{
+	streamsize left = count, room;
+
+	while (left > 0) {
+		room = epptr () - pptr ();
+		if (room == 0) {
+			handOff ();
+			continue;
+		}
+		if (room > left) room = left;
+		traits_type::copy (pptr (), text, room);
+		pbump ((int)room);
+		text += room;
+		left -= room;
+	}
+	return count;
+}
+
+
+//---------------------sync-------------------------------------------
+/**
+ * @brief Does nothing, so that endl, which flushes every line, does
+ *	  not cost a write. Use drain to wait for the output.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: None.
+ *
+ * @return 0.
+ */
+int ReportWriter::sync ()
+{
+	return 0;
+}
+
+
+//---------------------handOff----------------------------------------
+/**
+ * @brief Hands what is buffered to the writer, and starts an empty
+ *	  buffer. The buffer is swapped into the queue, not copied.
+ *	  Waits only if the writer is MAX_QUEUED buffers behind, which
+ *	  bounds the memory buffered.
+ *
+ * Preconditions: my_lock is not held.
+ *
+ * Postconditions: The buffer is empty.
+ */
+void ReportWriter::handOff ()
+{
+	long used = pptr () - pbase ();
+
+	if (used == 0) return;
+	my_buffer.resize (used);
+
+	if (!my_threaded) {
+		if (!my_failed && !writeAll (my_buffer)) my_failed = true;
+	}
+	else {
+		pthread_mutex_lock (&my_lock);
+		while ((int)my_ready.size () >= MAX_QUEUED)
+			pthread_cond_wait (&my_written, &my_lock);
+		my_ready.push (vector<char> ());
+		my_ready.back ().swap (my_buffer);
+		pthread_cond_signal (&my_wake);
+		pthread_mutex_unlock (&my_lock);
+	}
+
+	my_buffer.resize (BUFFER_SIZE);
+	setp (&my_buffer [0], &my_buffer [0] + BUFFER_SIZE);
+}
+
+
+//---------------------writer-----------------------------------------
+/**
+ * @brief Writes the buffers handed off, oldest first, until the 
+ *	  ReportWriter is closed. The lock is released while a buffer
+ *	  is written, so printing goes on meanwhile. After a failed
+ *	  write, buffers are dropped rather than written.
+ *
+ * Preconditions: report points to a ReportWriter.
+ *
+ * Postconditions: Every buffer handed off was written.
+ *
+ * @param report The ReportWriter.
+ * @return NULL.
+ */
+void * ReportWriter::writer (void *report)
+{
+	ReportWriter *self = static_cast<ReportWriter *> (report);
+	vector<char> bytes;
+	bool written;
+
+	pthread_mutex_lock (&self->my_lock);
+	while (true) {
+		while (self->my_ready.empty () && !self->my_closing)
+			pthread_cond_wait (&self->my_wake, &self->my_lock);
+		if (self->my_ready.empty ()) break;
+
+		bytes.swap (self->my_ready.front ());
+		self->my_ready.pop ();
+		self->my_writing = true;
+
+		pthread_mutex_unlock (&self->my_lock);
+		written = self->my_failed || self->writeAll (bytes);
+		pthread_mutex_lock (&self->my_lock);
+
+		if (!written) self->my_failed = true;
+		self->my_writing = false;
+		pthread_cond_broadcast (&self->my_written);
+	}
+	pthread_mutex_unlock (&self->my_lock);
+	return NULL;
+}
+
+
+//---------------------writeAll---------------------------------------
+/**
+ * @brief Writes the provided bytes to the descriptor. Short writes 
+ *	  are retried.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the bytes were written.
+ *
+ * @param bytes The bytes to write.
+ * @return True if written, false otherwise.
+ */
+bool ReportWriter::writeAll (const vector<char> &bytes)
+{
+	const char *data = bytes.empty () ? NULL : &bytes [0];
+	size_t left = bytes.size ();
+	ssize_t written;
+
+	while (left > 0) {
+		written = write (my_descriptor, data, left);
+		if (written < 0) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+		data += written;
+		left -= written;
+	}
+	return true;
+}
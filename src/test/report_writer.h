@@ -0,0 +1,269 @@
+/**
+ * @file report_writer.h
+ *
+ * @brief The ReportWriter is the sink the StoreManager prints its
+ *	  reports and diagnostics to. It is a stream buffer: what is
+ *	  printed is copied into a large buffer, and a writer thread
+ *	  writes each full buffer to a file descriptor, so printing
+ *	  never waits for a write.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows printing to an ostream made on the ReportWriter.
+ *	  Flushing the ostream, as endl does, does not write.
+ *	- Allows waiting until everything printed was written.
+ *
+ * Assumptions:
+ *	- One thread prints to a ReportWriter.
+ *	- Nothing else writes to the descriptor while output is
+ *	  pending. Callers drain before they write to it another way.
+ */
+//--------------------------------------------------------------------
+
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <streambuf>
+#include <vector>
+#include <queue>
+#include <pthread.h>
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class ReportWriter
+ */
+class ReportWriter : public streambuf {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a ReportWriter for the provided descriptor,
+	 *	  and starts the writer thread.
+	 *
+	 * Preconditions: descriptor is open for writing.
+	 *
+	 * Postconditions: This ReportWriter was created empty.
+	 *
+	 * @param descriptor The descriptor to write to.
+	 */
+	ReportWriter (int descriptor);
+
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Writes everything printed, and stops the writer. The
+	 *	  descriptor is left open.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: Everything printed was written.
+	 */
+	virtual ~ReportWriter ();
+
+
+	//---------------------drain----------------------------------
+	/**
+	 * @brief Waits until everything printed was written.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if every write succeeded,
+	 *		   false otherwise.
+	 *
+	 * @return True if written, false otherwise.
+	 */
+	bool drain ();
+
+/**
+ * @protected
+ */
+protected:
+
+	//---------------------overflow-------------------------------
+	/**
+	 * @brief Hands the full buffer to the writer, then buffers the
+	 *	  provided character.
+	 *
+	 * Preconditions: The buffer is full.
+	 *
+	 * Postconditions: The character was buffered.
+	 *
+	 * @param c The character, or eof.
+	 * @return A value other than eof.
+	 */
+	virtual int_type overflow (int_type c);
+
+
+	//---------------------xsputn---------------------------------
+	/**
+	 * @brief Buffers the provided characters, handing each buffer
+	 *	  that fills to the writer.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The characters were buffered.
+	 *
+	 * @param text The characters.
+	 * @param count The number of characters.
+	 * @return count.
+	 */
+	virtual streamsize xsputn (const char *text, streamsize count);
+
+
+	//---------------------sync-----------------------------------
+	/**
+	 * @brief Does nothing, so that a flush does not cost a write.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: None.
+	 *
+	 * @return 0.
+	 */
+	virtual int sync ();
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------Copy-Constructor-----------------------
+	/**
+	 * @brief Not implemented; a descriptor has a single writer.
+	 */
+	ReportWriter (const ReportWriter &the_other);
+
+
+	//---------------------operator(=)----------------------------
+	/**
+	 * @brief Not implemented; a descriptor has a single writer.
+	 */
+	const ReportWriter & operator= (const ReportWriter &the_other);
+
+
+	//---------------------handOff--------------------------------
+	/**
+	 * @brief Hands what is buffered to the writer, and starts an
+	 *	  empty buffer. Waits only if the writer is MAX_QUEUED
+	 *	  buffers behind.
+	 *
+	 * Preconditions: my_lock is not held.
+	 *
+	 * Postconditions: The buffer is empty.
+	 */
+	void handOff ();
+
+
+	//---------------------writer---------------------------------
+	/**
+	 * @brief Writes the buffers handed off until the ReportWriter
+	 *	  is closed. A thread entry point.
+	 *
+	 * Preconditions: report points to a ReportWriter.
+	 *
+	 * Postconditions: Every buffer handed off was written.
+	 *
+	 * @param report The ReportWriter.
+	 * @return NULL.
+	 */
+	static void * writer (void *report);
+
+
+	//---------------------writeAll-------------------------------
+	/**
+	 * @brief Writes the provided bytes to the descriptor. Short
+	 *	  writes are retried.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the bytes were written.
+	 *
+	 * @param bytes The bytes to write.
+	 * @return True if written, false otherwise.
+	 */
+	bool writeAll (const vector<char> &bytes);
+
+	/**
+	 * @brief The bytes in a buffer.
+	 */
+	static const int BUFFER_SIZE = 64 * 1024;
+
+	/**
+	 * @brief The most full buffers waiting to be written.
+	 */
+	static const int MAX_QUEUED = 4;
+
+	/**
+	 * @brief The descriptor written to.
+	 */
+	int my_descriptor;
+
+	/**
+	 * @brief The buffer being filled. Used only by the printing
+	 *	  thread.
+	 */
+	vector<char> my_buffer;
+
+	/**
+	 * @brief The full buffers waiting to be written, oldest first.
+	 */
+	queue< vector<char> > my_ready;
+
+	/**
+	 * @brief True while the writer writes a buffer.
+	 */
+	bool my_writing;
+
+	/**
+	 * @brief True once the destructor runs.
+	 */
+	bool my_closing;
+
+	/**
+	 * @brief True once a write failed.
+	 */
+	bool my_failed;
+
+	/**
+	 * @brief True if the writer thread is running. Otherwise each
+	 *	  buffer is written by the printing thread.
+	 */
+	bool my_threaded;
+
+	/**
+	 * @brief The writer thread.
+	 */
+	pthread_t my_thread;
+
+	/**
+	 * @brief Guards every member above but my_buffer.
+	 */
+	pthread_mutex_t my_lock;
+
+	/**
+	 * @brief Wakes the writer.
+	 */
+	pthread_cond_t my_wake;
+
+	/**
+	 * @brief Signalled when a buffer was written.
+	 */
+	pthread_cond_t my_written;
+};
+#endif /* REPORT_WRITER_H */
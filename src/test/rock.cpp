@@ -21,7 +21,7 @@
  *	- Allows clients to print the Rock Item. 
  *      - Allows clients to clone a Rock Item. 
  * Assumptions:
- * 	- The file stream is open and correctly formatted according to
+ * 	- The line is correctly formatted according to
  *	  Lab 4 specifications. 
  */
 //--------------------------------------------------------------------
@@ -37,7 +37,10 @@
  * Postconditions: This Rock Item was instantiated with default
  *	   	   values. 
  */
-Rock::Rock () : Item() {}
+Rock::Rock () : Item() 
+{
+	buildKey ();
+}
 
 
 //---------------------Constructor------------------------------------
@@ -54,8 +57,12 @@ Rock::Rock () : Item() {}
  * @param title The title of the Rock. 
  * @param year  The year of the Rock.
  */
-Rock::Rock (char type, string name, string title, int year, int count)
-		: Item (type, name, title, year, count) {}
+Rock::Rock (char type, const InternedString &name, 
+		const InternedString &title, int year, int count)
+		: Item (type, name, title, year, count) 
+{
+	buildKey ();
+}
 
 
 //---------------------Destructor-----------------------------
@@ -72,40 +79,66 @@ Rock::~Rock () {}
 //---------------------getNewInstance---------------------------------
 /**
  * @brief Retuns a pointer to a new Rock object. The objects' data
- *	  will be set using the provided file stream.
+ *	  will be set using the provided line.
  *	
- * Preconditions: The file stream is open and correctly formatted
+ * Preconditions: The line is correctly formatted
  *		  according to Lab 4 specs.
  *	
  * Postconditions: A new Rock object was created using the provided 
  *		   file stream, and a pointer to it is returned. 
  *
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return Returns a pointer to a new instance of a Rock.
  */
-Rock * Rock::getNewInstance (ifstream &input) const
+Rock * Rock::getNewInstance (FieldReader &input) const
 {
 	char type, test;
 	int year, count;
-	string title, name;	
+	Field title, name;	
 
-	input >> type;  
-	input.ignore (); input.ignore ();
+	type = input.readChar ();  
+	input.skip (2);
 
 	// See if there's a quantity.
 	test = input.peek ();	
 	if (isdigit (test)) {
-		input >> count; input.ignore ();
-		input.ignore ();	
+		input.readInt (count);
+		input.skip (2);	
 	} 
 	else { count = 0; }	
 	
-	getline (input, name,  ','); 
-	input.ignore ();
-	getline (input, title, ','); 
-	input >> year; 
-	// Move to the next line.
-	input.ignore(INT_MAX, '\n'); 
+	name = input.readField (','); 
+	input.skip (1);
+	title = input.readField (','); 
+	input.readInt (year); 
+	return new Rock (type, name, title, year, count);
+}
+
+
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new Rock, read from a snapshot 
+ *	  written by save.
+ *	
+ * Preconditions: The snapshot is at a Rock saved by save.
+ *
+ * Postconditions: A new Rock was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+Rock * Rock::getNewInstance (SnapshotReader &input) const
+{
+	char type;
+	int year, count;
+	string title, name;
+
+	type  = input.getByte ();
+	name  = input.getString ();
+	title = input.getString ();
+	year  = input.getInt ();
+	count = input.getInt ();
 	return new Rock (type, name, title, year, count);
 }
 
@@ -122,8 +155,8 @@ Rock * Rock::getNewInstance (ifstream &input) const
  */
 Rock * Rock::clone () const
 {
-	return new Rock (getType(), getName(), getTitle(), 
-				getYear(), getCount());
+	// The copy shares the pooled strings, sort key included.
+	return new Rock (*this);
 }
 
 
@@ -147,19 +180,8 @@ Rock * Rock::clone () const
  */
 bool Rock::operator< (const Object &the_other) const
 {
-	try {
-		const Rock &r = dynamic_cast<const Rock &> (the_other);
-
-		if ((getName()  < r.getName()) && 
-		    (getYear()  < r.getYear()) &&
-		    (getTitle() < r.getTitle())) {
-			return true;
-		}
-			
-	} catch (exception &e) {
-		cout << "Exception: " << e.what() << endl;
-	}
-	return false; 
+	// The sort key orders by the same fields, without RTTI.
+	return getSortKey () < the_other.getSortKey ();
 }
 
 
@@ -200,18 +222,25 @@ void Rock::print (ostream &output) const
  */
 bool Rock::operator== (const Object &the_other) const
 {
-	try {
-		const Rock &r = dynamic_cast<const Rock &> (the_other);
-
-		if ((getName()  == r.getName()) && 
-		    (getYear()  == r.getYear()) &&    
-		    (getTitle() == r.getTitle())) {
-			return true;
-		}
-			
-	} catch (exception &e) {
-		cout << "Exception: " << e.what() << endl;
-	}
-	return false; 
+	// Equal sort keys mean equal fields, without RTTI.
+	return sameKey (the_other);
 }
 
+
+//---------------------buildKey---------------------------------------
+/**
+ * @brief Builds the sort key of this Rock from its type followed by 
+ *	  the artist name, year and title.
+ *
+ * Preconditions: The data members have been initialized.
+ *
+ * Postconditions: The sort key of this Rock was set.
+ */
+void Rock::buildKey ()
+{
+	string key (1, getType ());
+	appendKey (key, getName ());
+	appendKey (key, getYear ());
+	appendKey (key, getTitle ());
+	setSortKey (key);
+}
@@ -21,7 +21,7 @@
  *	- Allows clients to print the Rock Item. 
  *      - Allows clients to clone a Rock Item. 
  * Assumptions:
- * 	- The file stream is open and correctly formatted according to
+ * 	- The line is correctly formatted according to
  *	  Lab 4 specifications. 
  */
 //--------------------------------------------------------------------
@@ -67,10 +67,10 @@ public:
 	 * @param name  The name of the Rock.
 	 * @param title The title of the Rock. 
 	 * @param year  The year of the Rock.
-	 * @param count The occurence count of the Rock Item.
+	 * @param count The occurrence count of the Rock Item.
 	 */
-	Rock (char type, string name, string title, 
-					int year, int count);
+	Rock (char type, const InternedString &name, 
+			const InternedString &title, int year, int count);
 
 
 	//---------------------Destructor-----------------------------
@@ -107,17 +107,33 @@ public:
 	 *	  The objects' data will be set using the provided
  	 *	  file stream.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *	 	  formatted according to Lab 4 specs.
 	 *	
 	 * Postconditions: A new Rock object was created using
-	 *		   the provided file stream, and a pointer
+	 *		   the provided line, and a pointer
 	 *		   to it is returned. 
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return Returns a pointer to a new instance of a Rock.
 	 */
-	virtual Rock * getNewInstance (ifstream &input) const;
+	virtual Rock * getNewInstance (FieldReader &input) const;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new Rock, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a Rock saved by save.
+	 *
+	 * Postconditions: A new Rock was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Rock * getNewInstance (SnapshotReader &input) const;
 
 
 	//---------------------clone----------------------------------
@@ -171,6 +187,22 @@ public:
 	 *		   otherwise.
  	 */
 	virtual bool operator== (const Object &the_other) const; 
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------buildKey-------------------------------
+	/**
+	 * @brief Builds the sort key of this Rock from its type 
+	 *	  followed by the artist name, year and title.
+	 *
+	 * Preconditions: The data members have been initialized.
+	 *
+	 * Postconditions: The sort key of this Rock was set.
+	 */
+	void buildKey ();
 };
 #endif /* ROCK_H */
 
@@ -0,0 +1,583 @@
+/**
+ * @file snapshot_file.cpp
+ *
+ * @brief The SnapshotWriter and SnapshotReader classes save and load
+ *	  the state of the store as a compact binary file, so that a
+ *	  restart does not have to parse the text files again.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows writing bytes, numbers and strings into sections.
+ *	- Allows reading them back, in the same order, after every
+ *	  checksum in the file has been checked.
+ *	- Allows encoding and decoding a payload kept outside of a
+ *	  snapshot, such as a journal record.
+ *
+ * Assumptions:
+ *	- A reader that runs past the end of a section, or a file
+ *	  that fails its checks, makes the reader fail. A failed
+ *	  reader returns zeros and empty strings.
+ */
+//--------------------------------------------------------------------
+
+#include "snapshot_file.h"
+
+/**
+ * @brief The first bytes of every snapshot.
+ */
+static char const MAGIC[] = "STORESNP";
+
+/**
+ * @brief The bytes of the header: the magic bytes, the version, a
+ *	  reserved word and the checksum of the first 16 bytes.
+ */
+static int const HEADER_SIZE = 24;
+
+/**
+ * @brief The bytes before each payload: tag, length and checksum.
+ */
+static int const SECTION_HEADER_SIZE = 20;
+
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a SnapshotWriter with no file open.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This SnapshotWriter was created closed.
+ */
+SnapshotWriter::SnapshotWriter ()
+{
+	my_tag = 0;
+}
+
+
+//---------------------open-------------------------------------------
+/**
+ * @brief Creates the file and writes the header.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the file was created, false
+ *		   otherwise.
+ *
+ * @param file The file to create.
+ * @return True if created, false otherwise.
+ */
+bool SnapshotWriter::open (const char *file)
+{
+	string header (MAGIC, 8);
+
+	my_file.open (file, ios::out | ios::binary | ios::trunc);
+	if (!my_file) return false;
+
+	// The header is checked like a section payload.
+	my_section.clear ();
+	putInt (SNAPSHOT_VERSION);
+	putInt (0);
+	header += my_section;
+	my_section.clear ();
+
+	my_file.write (header.data (), header.size ());
+	write (snapshotChecksum (header.data (), header.size ()), 8);
+	return !my_file.fail ();
+}
+
+
+//---------------------close------------------------------------------
+/**
+ * @brief Writes the END section and closes the file.
+ *
+ * Preconditions: No section is being written.
+ *
+ * Postconditions: True was returned if everything written reached the
+ *		   file, false otherwise.
+ *
+ * @return True if the snapshot was saved, false otherwise.
+ */
+bool SnapshotWriter::close ()
+{
+	bool saved;
+
+	beginSection (SECTION_END);
+	endSection ();
+	my_file.flush ();
+	saved = !my_file.fail ();
+	my_file.close ();
+	return saved;
+}
+
+
+//---------------------beginSection-----------------------------------
+/**
+ * @brief Starts a section. What is put until endSection is its
+ *	  payload, which is kept in memory so that its length and
+ *	  checksum can be written ahead of it.
+ *
+ * Preconditions: No section is being written.
+ *
+ * Postconditions: A section with the tag was started.
+ *
+ * @param tag The section tag.
+ */
+void SnapshotWriter::beginSection (unsigned int tag)
+{
+	my_tag = tag;
+	my_section.clear ();
+}
+
+
+//---------------------endSection-------------------------------------
+/**
+ * @brief Writes the section that was started to the file.
+ *
+ * Preconditions: A section is being written.
+ *
+ * Postconditions: The section was written.
+ */
+void SnapshotWriter::endSection ()
+{
+	write (my_tag, 4);
+	write (my_section.size (), 8);
+	write (snapshotChecksum (my_section.data (), my_section.size ()), 8);
+	my_file.write (my_section.data (), my_section.size ());
+	my_section.clear ();
+}
+
+
+//---------------------takeSection------------------------------------
+/**
+ * @brief Ends the section that was started, handing its payload to the
+ *	  caller instead of the file. The file need not be open.
+ *
+ * Preconditions: A section is being written.
+ *
+ * Postconditions: payload holds the payload, and no section is being
+ *		   written.
+ *
+ * @param payload Set to the payload.
+ */
+void SnapshotWriter::takeSection (string &payload)
+{
+	payload.swap (my_section);
+	my_section.clear ();
+}
+
+
+//---------------------putByte----------------------------------------
+/**
+ * @brief Puts one byte.
+ *
+ * Preconditions: A section is being written.
+ *
+ * Postconditions: The byte was added to the section.
+ *
+ * @param value The byte.
+ */
+void SnapshotWriter::putByte (char value)
+{
+	my_section += value;
+}
+
+
+//---------------------putInt-----------------------------------------
+/**
+ * @brief Puts a 4 byte number.
+ *
+ * Preconditions: A section is being written.
+ *
+ * Postconditions: The number was added to the section.
+ *
+ * @param value The number.
+ */
+void SnapshotWriter::putInt (int value)
+{
+	for (int i = 0; i < 4; i++)
+		my_section += (char)((unsigned int)value >> (8 * i));
+}
+
+
+//---------------------putLong----------------------------------------
+/**
+ * @brief Puts an 8 byte number.
+ *
+ * Preconditions: A section is being written.
+ *
+ * Postconditions: The number was added to the section.
+ *
+ * @param value The number.
+ */
+void SnapshotWriter::putLong (long long value)
+{
+	for (int i = 0; i < 8; i++)
+		my_section += (char)((unsigned long long)value >> (8 * i));
+}
+
+
+//---------------------putString--------------------------------------
+/**
+ * @brief Puts a string, as its length and its bytes.
+ *
+ * Preconditions: A section is being written.
+ *
+ * Postconditions: The string was added to the section.
+ *
+ * @param value The string.
+ */
+void SnapshotWriter::putString (const string &value)
+{
+	putInt ((int)value.size ());
+	my_section += value;
+}
+
+
+//---------------------write------------------------------------------
+/**
+ * @brief Writes a little endian number straight to the file.
+ *
+ * Preconditions: The file is open.
+ *
+ * Postconditions: The number was written.
+ *
+ * @param value The number.
+ * @param size The number of low bytes to write.
+ */
+void SnapshotWriter::write (unsigned long long value, int size)
+{
+	char bytes [8];
+
+	for (int i = 0; i < size; i++)
+		bytes [i] = (char)(value >> (8 * i));
+	my_file.write (bytes, size);
+}
+
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates a SnapshotReader with no file open.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This SnapshotReader was created closed.
+ */
+SnapshotReader::SnapshotReader ()
+{
+	my_data     = NULL;
+	my_next     = 0;
+	my_position = 0;
+	my_end      = 0;
+	my_failed   = true;
+}
+
+
+//---------------------open-------------------------------------------
+/**
+ * @brief Maps the file and checks its header, version and the
+ *	  checksum of every section, so that a damaged snapshot is
+ *	  turned down before anything is loaded from it.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the file is a sound snapshot
+ *		   of this version, false otherwise.
+ *
+ * @param file The file to open.
+ * @return True if the snapshot can be read, false otherwise.
+ */
+bool SnapshotReader::open (const char *file)
+{
+	long length, offset;
+	unsigned long long size, checksum;
+	unsigned int tag, version;
+
+	my_failed = true;
+	if (!my_file.open (file)) return false;
+	my_data = my_file.getData ();
+	length  = my_file.getLength ();
+
+	// Check the header.
+	if (length < HEADER_SIZE || string (my_data, 8) != MAGIC)
+		return false;
+	my_position = 8;
+	my_end      = HEADER_SIZE;
+	my_failed   = false;
+	version  = (unsigned int)read (4);
+	read (4);
+	checksum = read (8);
+	if (version != SNAPSHOT_VERSION ||
+	    checksum != snapshotChecksum (my_data, HEADER_SIZE - 8)) {
+		my_failed = true;
+		return false;
+	}
+
+	// Check every section, up to the END section.
+	for (offset = HEADER_SIZE; ; offset += size) {
+		if (length - offset < SECTION_HEADER_SIZE) break;
+		my_position = offset;
+		my_end      = offset + SECTION_HEADER_SIZE;
+		tag      = (unsigned int)read (4);
+		size     = read (8);
+		checksum = read (8);
+		offset  += SECTION_HEADER_SIZE;
+		if (size > (unsigned long long)(length - offset)) break;
+		if (checksum != snapshotChecksum (my_data + offset, size))
+			break;
+		if (tag == SECTION_END) {
+			my_next     = HEADER_SIZE;
+			my_position = my_end = HEADER_SIZE;
+			return true;
+		}
+	}
+	my_failed = true;
+	return false;
+}
+
+
+//---------------------nextSection------------------------------------
+/**
+ * @brief Moves to the next section, skipping whatever was not read of
+ *	  the current one.
+ *
+ * Preconditions: The file was opened.
+ *
+ * Postconditions: If there is another section before END, tag was
+ *		   set to its tag and true was returned. Otherwise
+ *		   false was returned.
+ *
+ * @param tag Set to the section tag.
+ * @return True if at a section, false at the end.
+ */
+bool SnapshotReader::nextSection (unsigned int &tag)
+{
+	long size;
+
+	if (my_failed) return false;
+
+	// open has checked that every header and payload fits.
+	my_position = my_next;
+	my_end      = my_next + SECTION_HEADER_SIZE;
+	tag  = (unsigned int)read (4);
+	size = (long)read (8);
+	read (8);
+	my_end  = my_position + size;
+	my_next = my_end;
+	return tag != SECTION_END;
+}
+
+
+//---------------------readSection------------------------------------
+/**
+ * @brief Reads the provided payload as the current section, for 
+ *	  payloads kept outside of a snapshot. The bytes are not copied.
+ *
+ * Preconditions: The bytes stay valid while they are read. nextSection
+ *		  is not called afterwards.
+ *
+ * Postconditions: The next read is at the start of payload.
+ *
+ * @param payload The first byte of the payload.
+ * @param length The number of bytes.
+ */
+void SnapshotReader::readSection (const char *payload, long length)
+{
+	my_file.close ();
+	my_data     = payload;
+	my_position = 0;
+	my_end      = length;
+	my_next     = length;
+	my_failed   = false;
+}
+
+
+//---------------------peekByte---------------------------------------
+/**
+ * @brief Returns the next byte without reading it.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The next byte, or '\0' at the end of the section,
+ *		   was returned.
+ *
+ * @return The next byte.
+ */
+char SnapshotReader::peekByte () const
+{
+	return (my_position < my_end) ? my_data [my_position] : '\0';
+}
+
+
+//---------------------getByte----------------------------------------
+/**
+ * @brief Reads one byte.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The byte was returned.
+ *
+ * @return The byte.
+ */
+char SnapshotReader::getByte ()
+{
+	return (char)read (1);
+}
+
+
+//---------------------getInt-----------------------------------------
+/**
+ * @brief Reads a 4 byte number.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The number was returned.
+ *
+ * @return The number.
+ */
+int SnapshotReader::getInt ()
+{
+	return (int)(unsigned int)read (4);
+}
+
+
+//---------------------getLong----------------------------------------
+/**
+ * @brief Reads an 8 byte number.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The number was returned.
+ *
+ * @return The number.
+ */
+long long SnapshotReader::getLong ()
+{
+	return (long long)read (8);
+}
+
+
+//---------------------getString--------------------------------------
+/**
+ * @brief Reads a string.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The string was returned.
+ *
+ * @return The string.
+ */
+string SnapshotReader::getString ()
+{
+	int size = getInt ();
+
+	if (my_failed || size < 0 || size > my_end - my_position) {
+		my_failed = true;
+		return string ();
+	}
+	my_position += size;
+	return string (my_data + my_position - size, size);
+}
+
+
+//---------------------fail-------------------------------------------
+/**
+ * @brief Marks the reader failed, for readers that find data they
+ *	  cannot use.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This reader has failed.
+ */
+void SnapshotReader::fail ()
+{
+	my_failed = true;
+}
+
+
+//---------------------failed-----------------------------------------
+/**
+ * @brief Returns whether the reader has failed.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if it failed.
+ *
+ * @return True if failed, false otherwise.
+ */
+bool SnapshotReader::failed () const
+{
+	return my_failed;
+}
+
+
+//---------------------read-------------------------------------------
+/**
+ * @brief Reads a little endian number of the provided size.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The number, or 0 if the section is too short, was
+ *		   returned.
+ *
+ * @param size The number of bytes.
+ * @return The number.
+ */
+unsigned long long SnapshotReader::read (int size)
+{
+	unsigned long long value = 0;
+
+	if (my_failed || my_end - my_position < size) {
+		my_failed = true;
+		return 0;
+	}
+	for (int i = 0; i < size; i++)
+		value |= (unsigned long long)(unsigned char)
+			 my_data [my_position + i] << (8 * i);
+	my_position += size;
+	return value;
+}
+
+
+//---------------------snapshotChecksum-------------------------------
+/**
+ * @brief Returns the checksum of the provided bytes. Eight bytes are
+ *	  folded in at a time, as a little endian word, then mixed.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The checksum was returned.
+ *
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @return The checksum.
+ */
+unsigned long long snapshotChecksum (const char *data, long length)
+{
+	const unsigned char *bytes = (const unsigned char *)data;
+	unsigned long long hash = 14695981039346656037ULL ^ length;
+	unsigned long long word;
+	long i = 0;
+	int k;
+
+	for (; i + 8 <= length; i += 8) {
+		word = 0;
+		for (k = 0; k < 8; k++)
+			word |= (unsigned long long)bytes [i + k] << (8 * k);
+		hash = (hash ^ word) * 0x100000001b3ULL;
+		hash ^= hash >> 29;
+	}
+	for (; i < length; i++)
+		hash = (hash ^ bytes [i]) * 0x100000001b3ULL;
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return hash;
+}
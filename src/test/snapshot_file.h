@@ -0,0 +1,480 @@
+/**
+ * @file snapshot_file.h
+ *
+ * @brief The SnapshotWriter and SnapshotReader classes save and load
+ *	  the state of the store as a compact binary file, so that a
+ *	  restart does not have to parse the text files again.
+ *
+ * @brief A snapshot starts with a header: the magic bytes STORESNP,
+ *	  the format version and a checksum of the header. Sections
+ *	  follow. Each has a tag, the length and checksum of its
+ *	  payload, and the payload. An END section closes the file.
+ *	  Numbers are stored little endian, and strings as a length
+ *	  followed by their bytes.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows writing bytes, numbers and strings into sections.
+ *	- Allows reading them back, in the same order, after every
+ *	  checksum in the file has been checked.
+ *	- Allows encoding and decoding a payload kept outside of a
+ *	  snapshot, such as a journal record.
+ *
+ * Assumptions:
+ *	- A reader that runs past the end of a section, or a file
+ *	  that fails its checks, makes the reader fail. A failed
+ *	  reader returns zeros and empty strings.
+ */
+//--------------------------------------------------------------------
+
+#ifndef SNAPSHOT_FILE_H
+#define SNAPSHOT_FILE_H
+
+#include <string>
+#include <fstream>
+#include "mapped_file.h"
+/**
+ * @namespace std
+ */
+using namespace std;
+
+/**
+ * @brief The version of the snapshot format written.
+ */
+unsigned int const SNAPSHOT_VERSION = 2;
+
+/**
+ * @brief The tag of the section that holds the inventory.
+ */
+unsigned int const SECTION_ITEMS = 0x4d455449;		// "ITEM"
+
+/**
+ * @brief The tag of the section that holds the customers.
+ */
+unsigned int const SECTION_CUSTOMERS = 0x54535543;	// "CUST"
+
+/**
+ * @brief The tag of the section that holds the generation of the 
+ *	  journal whose records follow the saved state.
+ */
+unsigned int const SECTION_JOURNAL = 0x4c4e524a;	// "JRNL"
+
+/**
+ * @brief The tag of the section that ends the file.
+ */
+unsigned int const SECTION_END = 0x20444e45;		// "END "
+
+
+/**
+ * @class SnapshotWriter
+ */
+class SnapshotWriter {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a SnapshotWriter with no file open.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This SnapshotWriter was created closed.
+	 */
+	SnapshotWriter ();
+
+
+	//---------------------open-----------------------------------
+	/**
+	 * @brief Creates the file and writes the header.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the file was created,
+	 *		   false otherwise.
+	 *
+	 * @param file The file to create.
+	 * @return True if created, false otherwise.
+	 */
+	bool open (const char *file);
+
+
+	//---------------------close----------------------------------
+	/**
+	 * @brief Writes the END section and closes the file.
+	 *
+	 * Preconditions: No section is being written.
+	 *
+	 * Postconditions: True was returned if everything written
+	 *		   reached the file, false otherwise.
+	 *
+	 * @return True if the snapshot was saved, false otherwise.
+	 */
+	bool close ();
+
+
+	//---------------------beginSection---------------------------
+	/**
+	 * @brief Starts a section. What is put until endSection is
+	 *	  its payload.
+	 *
+	 * Preconditions: No section is being written.
+	 *
+	 * Postconditions: A section with the tag was started.
+	 *
+	 * @param tag The section tag.
+	 */
+	void beginSection (unsigned int tag);
+
+
+	//---------------------endSection-----------------------------
+	/**
+	 * @brief Writes the section that was started to the file.
+	 *
+	 * Preconditions: A section is being written.
+	 *
+	 * Postconditions: The section was written.
+	 */
+	void endSection ();
+
+
+	//---------------------takeSection----------------------------
+	/**
+	 * @brief Ends the section that was started, handing its 
+	 *	  payload to the caller instead of the file. The file
+	 *	  need not be open.
+	 *
+	 * Preconditions: A section is being written.
+	 *
+	 * Postconditions: payload holds the payload, and no section
+	 *		   is being written.
+	 *
+	 * @param payload Set to the payload.
+	 */
+	void takeSection (string &payload);
+
+
+	//---------------------putByte--------------------------------
+	/**
+	 * @brief Puts one byte.
+	 *
+	 * Preconditions: A section is being written.
+	 *
+	 * Postconditions: The byte was added to the section.
+	 *
+	 * @param value The byte.
+	 */
+	void putByte (char value);
+
+
+	//---------------------putInt---------------------------------
+	/**
+	 * @brief Puts a 4 byte number.
+	 *
+	 * Preconditions: A section is being written.
+	 *
+	 * Postconditions: The number was added to the section.
+	 *
+	 * @param value The number.
+	 */
+	void putInt (int value);
+
+
+	//---------------------putLong--------------------------------
+	/**
+	 * @brief Puts an 8 byte number.
+	 *
+	 * Preconditions: A section is being written.
+	 *
+	 * Postconditions: The number was added to the section.
+	 *
+	 * @param value The number.
+	 */
+	void putLong (long long value);
+
+
+	//---------------------putString------------------------------
+	/**
+	 * @brief Puts a string, as its length and its bytes.
+	 *
+	 * Preconditions: A section is being written.
+	 *
+	 * Postconditions: The string was added to the section.
+	 *
+	 * @param value The string.
+	 */
+	void putString (const string &value);
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------write----------------------------------
+	/**
+	 * @brief Writes an 8 byte number straight to the file.
+	 *
+	 * Preconditions: The file is open.
+	 *
+	 * Postconditions: The number was written.
+	 *
+	 * @param value The number.
+	 * @param size The number of low bytes to write.
+	 */
+	void write (unsigned long long value, int size);
+
+	/**
+	 * @brief The file being written.
+	 */
+	ofstream my_file;
+
+	/**
+	 * @brief The payload of the section being written.
+	 */
+	string my_section;
+
+	/**
+	 * @brief The tag of the section being written.
+	 */
+	unsigned int my_tag;
+};
+
+
+/**
+ * @class SnapshotReader
+ */
+class SnapshotReader {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a SnapshotReader with no file open.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This SnapshotReader was created closed.
+	 */
+	SnapshotReader ();
+
+
+	//---------------------open-----------------------------------
+	/**
+	 * @brief Maps the file and checks its header, version and
+	 *	  the checksum of every section.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the file is a sound
+	 *		   snapshot of this version, false otherwise.
+	 *
+	 * @param file The file to open.
+	 * @return True if the snapshot can be read, false otherwise.
+	 */
+	bool open (const char *file);
+
+
+	//---------------------nextSection----------------------------
+	/**
+	 * @brief Moves to the next section, skipping whatever was not
+	 *	  read of the current one.
+	 *
+	 * Preconditions: The file was opened.
+	 *
+	 * Postconditions: If there is another section before END, tag
+	 *		   was set to its tag and true was returned.
+	 *		   Otherwise false was returned.
+	 *
+	 * @param tag Set to the section tag.
+	 * @return True if at a section, false at the end.
+	 */
+	bool nextSection (unsigned int &tag);
+
+
+	//---------------------readSection----------------------------
+	/**
+	 * @brief Reads the provided payload as the current section,
+	 *	  for payloads kept outside of a snapshot. The bytes
+	 *	  are not copied.
+	 *
+	 * Preconditions: The bytes stay valid while they are read. 
+	 *		  nextSection is not called afterwards.
+	 *
+	 * Postconditions: The next read is at the start of payload.
+	 *
+	 * @param payload The first byte of the payload.
+	 * @param length The number of bytes.
+	 */
+	void readSection (const char *payload, long length);
+
+
+	//---------------------peekByte-------------------------------
+	/**
+	 * @brief Returns the next byte without reading it.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The next byte, or '\0' at the end of the
+	 *		   section, was returned.
+	 *
+	 * @return The next byte.
+	 */
+	char peekByte () const;
+
+
+	//---------------------getByte--------------------------------
+	/**
+	 * @brief Reads one byte.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The byte was returned.
+	 *
+	 * @return The byte.
+	 */
+	char getByte ();
+
+
+	//---------------------getInt---------------------------------
+	/**
+	 * @brief Reads a 4 byte number.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number was returned.
+	 *
+	 * @return The number.
+	 */
+	int getInt ();
+
+
+	//---------------------getLong--------------------------------
+	/**
+	 * @brief Reads an 8 byte number.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number was returned.
+	 *
+	 * @return The number.
+	 */
+	long long getLong ();
+
+
+	//---------------------getString------------------------------
+	/**
+	 * @brief Reads a string.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The string was returned.
+	 *
+	 * @return The string.
+	 */
+	string getString ();
+
+
+	//---------------------fail-----------------------------------
+	/**
+	 * @brief Marks the reader failed, for readers that find data
+	 *	  they cannot use.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This reader has failed.
+	 */
+	void fail ();
+
+
+	//---------------------failed---------------------------------
+	/**
+	 * @brief Returns whether the reader has failed.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if it failed.
+	 *
+	 * @return True if failed, false otherwise.
+	 */
+	bool failed () const;
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------read-----------------------------------
+	/**
+	 * @brief Reads a little endian number of the provided size.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number, or 0 if the section is too
+	 *		   short, was returned.
+	 *
+	 * @param size The number of bytes.
+	 * @return The number.
+	 */
+	unsigned long long read (int size);
+
+	/**
+	 * @brief The mapped snapshot.
+	 */
+	MappedFile my_file;
+
+	/**
+	 * @brief The first byte of the file.
+	 */
+	const char *my_data;
+
+	/**
+	 * @brief The offset of the next section header.
+	 */
+	long my_next;
+
+	/**
+	 * @brief The offset of the next byte to read.
+	 */
+	long my_position;
+
+	/**
+	 * @brief The offset just past the current section.
+	 */
+	long my_end;
+
+	/**
+	 * @brief True once a read went wrong.
+	 */
+	bool my_failed;
+};
+
+
+//---------------------snapshotChecksum-------------------------------
+/**
+ * @brief Returns the checksum of the provided bytes. Eight bytes are
+ *	  folded in at a time, as a little endian word, then mixed.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The checksum was returned.
+ *
+ * @param data The bytes.
+ * @param length The number of bytes.
+ * @return The checksum.
+ */
+unsigned long long snapshotChecksum (const char *data, long length);
+
+#endif /* SNAPSHOT_FILE_H */
@@ -23,10 +23,24 @@
  * Includes following features:
  * 	- Allow clients to run the process of initializing the store,
  *	  and start processing the transactions.
+ *	- Allow clients to stream the transactions, executing each
+ *	  while the next ones are parsed, in constant memory.
+ *	- Allow clients to load the store and stream the transactions
+ *	  as separate steps, so each can be timed.
+ *	- Allow clients to save the store to a snapshot, and to 
+ *	  restart from it instead of the text files.
+ *	- Allow clients to journal the transactions, so that a
+ *	  crash loses none that was synced, and to checkpoint the
+ *	  journal into the snapshot.
+ *	- Allow clients to tear the store down and start over in
+ *	  constant time, however many objects it held.
  * 
  * Assumptions:
  * 	- The file directories exist and contain valid format 
  *	  according to Lab 4 specifications.
+ *	- One store runs at a time. Its Items, Customers and
+ *	  Transactions come from the Region, which is reset when
+ *	  the store is torn down.
  */
 //--------------------------------------------------------------------
 #include "store_initializer.h"
@@ -43,7 +57,9 @@ StoreInitializer::StoreInitializer ()
 {
 	my_item_factory	       = new ObjectFactory ();
 	my_transaction_factory = new ObjectFactory ();
-	my_manager  	       = new StoreManager ();
+	my_manager  	       = NULL;
+	my_journal             = NULL;
+	init_manager ();
 	init_item_factory (); 
 	init_transaction_factory ();
 }
@@ -52,7 +68,8 @@ StoreInitializer::StoreInitializer ()
 // --------------------Destructor-------------------------------------
 /**
  * @brief Deallocates my_manager and the factories and sets their 
- *	  pointers to NULL.
+ *	  pointers to NULL. The objects of the store are freed with the
+ *	  Region.
  *
  * Preconditions: my_manager and my_item_factory point to dynamically 
  *		  allocated objects or NULL. 
@@ -62,12 +79,56 @@ StoreInitializer::StoreInitializer ()
  */ 
 StoreInitializer::~StoreInitializer ()
 {
+	closeJournal ();
+	teardown ();
+}
+
+
+//---------------------reset------------------------------------------
+/**
+ * @brief Tears the store down and starts an empty one, as if this 
+ *	  StoreInitializer were new. The prototypes of the factories
+ *	  were freed with the Region, so the factories are made again.
+ *
+ * Preconditions: No other thread uses the store.
+ *
+ * Postconditions: The journal was closed, every object of the store 
+ *		   was freed, and the store is empty.
+ */
+void StoreInitializer::reset ()
+{
+	closeJournal ();
+	teardown ();
+	my_item_factory	       = new ObjectFactory ();
+	my_transaction_factory = new ObjectFactory ();
+	init_manager ();
+	init_item_factory (); 
+	init_transaction_factory ();
+}
+
+
+//---------------------teardown---------------------------------------
+/**
+ * @brief Deletes my_manager and the factories without visiting the 
+ *	  objects they hold, then frees the objects all at once by 
+ *	  resetting the Region. Only the nodes of the trees are walked.
+ *
+ * Preconditions: The journal is closed.
+ *
+ * Postconditions: my_manager and the factories were deleted and set
+ *		   to NULL.
+ */
+void StoreInitializer::teardown ()
+{
+	if (my_manager != NULL)
+		my_manager->clear ();
 	delete my_item_factory;
 	delete my_transaction_factory;
 	delete my_manager;
 	my_item_factory        = NULL;
 	my_transaction_factory = NULL;
 	my_manager             = NULL;
+	Region::reset ();
 }
 
 
@@ -86,9 +147,25 @@ void StoreInitializer::init_item_factory ()
 	my_item_factory->addObject (ROCK_ID,    new Rock ());
 	my_item_factory->addObject (CLASSIC_ID, new Classical ());
 	my_item_factory->addObject (DVD_ID,     new Dvd ()); 
-	my_manager->mapToTree      (ROCK_ID,    new BSTree ());
-	my_manager->mapToTree      (CLASSIC_ID, new BSTree ());
-	my_manager->mapToTree      (DVD_ID,     new BSTree ());
+}
+
+
+//---------------------init_manager-----------------------------------
+/**
+ * @brief Creates an empty StoreManager, with a tree for each type of
+ *	  Item. Any StoreManager held before is deleted.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: my_manager is empty, and has its trees.
+ */
+void StoreInitializer::init_manager ()
+{
+	delete my_manager;
+	my_manager = new StoreManager ();
+	my_manager->mapToTree (ROCK_ID,    new BPlusTree ());
+	my_manager->mapToTree (CLASSIC_ID, new BPlusTree ());
+	my_manager->mapToTree (DVD_ID,     new BPlusTree ());
 }
 
 
@@ -133,8 +210,291 @@ void StoreInitializer::run ()
 	init_inventory    (INVENTORY_FILE);
 	init_transactions (TRANSACTIONS_FILE);
 	init_customers    (CUSTOMERS_FILE); 
-	// Now pass control to manager to process the transactions.  
+	// Now pass control to manager to process the transactions. Its 
+	// reports are written in the background, so what the loaders
+	// printed goes out first, and the reports are waited for.
+	cout.flush ();
 	my_manager->processTransactions (); 
+	my_manager->flushReport ();
+}
+
+
+// --------------------runStreaming-----------------------------------
+/**
+ * @brief Initializes the store Items and Customers, then streams the
+ *	  Transactions: a parser thread reads the file into a bounded 
+ *	  queue while this thread executes them in order. The parser 
+ *	  waits whenever the queue is full, so memory does not grow 
+ *	  with the file. Customers are loaded first, as a transaction 
+ *	  may now run before the rest of the file is read.
+ * 
+ * Preconditions: my_item_factory and my_manager have been initialized.
+ * 
+ * Postconditions: The store Items and Customers have been initialized,
+ *		   and every Transaction has been processed.
+ */ 
+void StoreInitializer::runStreaming ()
+{
+	initStore ();
+	streamTransactions ();
+}
+
+
+// --------------------initStore--------------------------------------
+/**
+ * @brief Initializes the store Items and Customers from the text files:
+ *	  the first half of runStreaming. Customers are loaded after 
+ *	  the Items, before any transaction runs.
+ * 
+ * Preconditions: my_item_factory and my_manager have been initialized,
+ *		  and nothing was loaded yet.
+ * 
+ * Postconditions: The store Items and Customers have been initialized.
+ */ 
+void StoreInitializer::initStore ()
+{
+	init_inventory (INVENTORY_FILE);
+	init_customers (CUSTOMERS_FILE); 
+}
+
+
+// --------------------streamTransactions-----------------------------
+/**
+ * @brief Streams the Transactions of the text file through the store:
+ *	  the second half of runStreaming.
+ * 
+ * Preconditions: The store Items and Customers have been initialized.
+ * 
+ * Postconditions: Every Transaction has been processed, its report 
+ *		   written, and the number processed returned.
+ *
+ * @return The number of Transactions processed.
+ */ 
+long long StoreInitializer::streamTransactions ()
+{
+	return stream_transactions (TRANSACTIONS_FILE);
+}
+
+
+// --------------------run--------------------------------------------
+/**
+ * @brief Restarts the store from the provided snapshot. If it cannot
+ *	  be loaded, the store is initialized from the text files and
+ *	  the transactions are processed, as by run, and the snapshot
+ *	  is then saved for the next restart.
+ * 
+ * Preconditions: my_item_factory and my_manager have been initialized,
+ *		  and nothing was loaded yet.
+ * 
+ * Postconditions: The store holds the state of the snapshot, or of the
+ *		   processed text files.
+ *
+ * @param snapshot The snapshot file.
+ */ 
+void StoreInitializer::run (const char snapshot[])
+{
+	if (loadSnapshot (snapshot)) return;
+
+	run ();
+	saveSnapshot (snapshot);
+}
+
+
+//---------------------saveSnapshot-----------------------------------
+/**
+ * @brief Saves the inventory and the customers, with their histories,
+ *	  to a snapshot file.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if the snapshot was saved, false 
+ *		   otherwise.
+ *
+ * @param file The snapshot file.
+ * @return True if saved, false otherwise.
+ */
+bool StoreInitializer::saveSnapshot (const char file[]) const
+{
+	SnapshotWriter output;
+
+	if (!output.open (file)) {
+		cout << FILE_O_ERROR << file << endl;
+		return false;
+	}
+	my_manager->save (output);
+	if (!output.close ()) {
+		cout << FILE_C_ERROR << file << endl;
+		return false;
+	}
+	return true;
+}
+
+
+//---------------------loadSnapshot-----------------------------------
+/**
+ * @brief Loads a snapshot saved by saveSnapshot. Every checksum is 
+ *	  checked before anything is loaded, so a damaged file leaves
+ *	  the store untouched. A snapshot that still does not match 
+ *	  the store is dropped.
+ *
+ * Preconditions: Nothing was loaded yet.
+ *
+ * Postconditions: True was returned if the snapshot was loaded. 
+ *		   Otherwise false was returned and the store is empty.
+ *
+ * @param file The snapshot file.
+ * @return True if loaded, false otherwise.
+ */
+bool StoreInitializer::loadSnapshot (const char file[])
+{
+	SnapshotReader input;
+
+	// A missing snapshot is expected before the first save.
+	if (!input.open (file)) {
+		if (access (file, F_OK) == 0) 
+			cout << SNAPSHOT_ERROR << file << endl;
+		return false;
+	}
+	if (!my_manager->load (input, *my_item_factory)) {
+		cout << SNAPSHOT_ERROR << file << endl;
+		init_manager ();
+		return false;
+	}
+	return true;
+}
+
+
+//---------------------openJournal------------------------------------
+/**
+ * @brief Replays the journal onto the store, then journals every 
+ *	  purchase and trade that changes the store from now on. 
+ *	  Replay stops at the first torn or damaged record, which is
+ *	  cut off. A journal of an older generation than the store is
+ *	  already part of it, and is started over, as is a missing 
+ *	  one. One that cannot be used is reported and started over.
+ *
+ * Preconditions: The store holds the state of the last snapshot, or of
+ *		  the text files without the transactions if there is
+ *		  none.
+ *
+ * Postconditions: True was returned if the journal was replayed and 
+ *		   opened, false otherwise.
+ *
+ * @param file The journal file.
+ * @param group The most records synced together.
+ * @param delay The longest a record waits for its group, in 
+ *		milliseconds.
+ * @return True if opened, false otherwise.
+ */
+bool StoreInitializer::openJournal (const char file[], int group, 
+								int delay)
+{
+	JournalReader reader;
+	SnapshotReader record;
+	unsigned int generation = my_manager->getGeneration ();
+	long length = 0;
+
+	closeJournal ();
+	if (reader.open (file)) {
+		if (reader.getGeneration () > generation) 
+			cout << JOURNAL_ERROR << file << endl;
+		else if (reader.getGeneration () == generation) {
+			length = reader.getLength ();
+			while (reader.nextRecord (record) && 
+			       my_manager->replay (record, *my_item_factory))
+				length = reader.getLength ();
+		}
+	} 
+	else if (access (file, F_OK) == 0) 
+		cout << JOURNAL_ERROR << file << endl;
+
+	my_journal = new JournalWriter ();
+	if (!my_journal->open (file, length, generation, group, delay)) {
+		cout << FILE_O_ERROR << file << endl;
+		delete my_journal;
+		my_journal = NULL;
+		return false;
+	}
+	my_manager->setJournal (my_journal);
+	return true;
+}
+
+
+//---------------------closeJournal-----------------------------------
+/**
+ * @brief Syncs and closes the journal. Later transactions are not 
+ *	  journaled.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if every record was durable, false
+ *		   otherwise.
+ *
+ * @return True if durable, false otherwise.
+ */
+bool StoreInitializer::closeJournal ()
+{
+	bool durable;
+
+	if (my_journal == NULL) return true;
+	my_manager->setJournal (NULL);
+	durable = my_journal->close ();
+	delete my_journal;
+	my_journal = NULL;
+	return durable;
+}
+
+
+//---------------------checkpoint-------------------------------------
+/**
+ * @brief Saves the store to the snapshot, replacing it only once the
+ *	  new one is on disk, then empties the journal. The snapshot 
+ *	  holds the next journal generation, so if a crash comes 
+ *	  before the journal was emptied, the restart knows its 
+ *	  records are already in the snapshot.
+ *
+ * Preconditions: The journal is open.
+ *
+ * Postconditions: True was returned if the snapshot was saved and the
+ *		   journal emptied, false otherwise.
+ *
+ * @param snapshot The snapshot file.
+ * @return True if checkpointed, false otherwise.
+ */
+bool StoreInitializer::checkpoint (const char snapshot[])
+{
+	string temp = string (snapshot) + ".tmp";
+	string folder (snapshot);
+	unsigned int generation;
+	int descriptor;
+	bool synced;
+
+	if (my_journal == NULL) return false;
+	generation = my_manager->getGeneration ();
+	my_manager->setGeneration (generation + 1);
+	if (!saveSnapshot (temp.c_str ())) {
+		my_manager->setGeneration (generation);
+		return false;
+	}
+
+	// The snapshot, then its name, must be on disk before the
+	// journal is emptied.
+	descriptor = open (temp.c_str (), O_RDONLY);
+	synced = descriptor >= 0 && fsync (descriptor) == 0;
+	if (descriptor >= 0) close (descriptor);
+	if (!synced || rename (temp.c_str (), snapshot) != 0) {
+		cout << FILE_C_ERROR << snapshot << endl;
+		my_manager->setGeneration (generation);
+		return false;
+	}
+	folder = (folder.rfind ('/') == string::npos) ? "." :
+		 folder.substr (0, folder.rfind ('/') + 1);
+	descriptor = open (folder.c_str (), O_RDONLY);
+	if (descriptor >= 0) {
+		fsync (descriptor);
+		close (descriptor);
+	}
+	return my_journal->reset (generation + 1);
 }
 
 
@@ -153,17 +513,14 @@ void StoreInitializer::run ()
  */
 void StoreInitializer::init_customers (const char file[])
 {
-	ifstream infile;
+	MappedFile infile;
+	vector<Object *> customers;
 	Customer *cust;
-	int cust_id; 
+	long long cust_id; 
 	if (openFile(file, infile)) {
-		for (;;) {
-			cust = new Customer (infile); 
-			if (infile.eof()) {
-				delete cust;
-				cust = NULL;
-				break;	
-			}			
+		loadFile (infile, true, customers);
+		for (unsigned int i = 0; i < customers.size (); i++) {
+			cust = static_cast<Customer *> (customers [i]); 
 			cust_id = cust->getId ();	
 			my_manager->addCustomer (cust, cust_id);
 		}
@@ -174,7 +531,8 @@ void StoreInitializer::init_customers (const char file[])
 
 //---------------------init_inventory---------------------------------
 /**
- * @brief Initializes the store inventory Items.
+ * @brief Initializes the store inventory Items. The whole file is 
+ *	  parsed first and then bulk loaded into my_manager.
  *
  * Preconditions: The file associated with the inventory is in the 
  *		  correct directory and contains a correct format 
@@ -187,32 +545,16 @@ void StoreInitializer::init_customers (const char file[])
  */
 void StoreInitializer::init_inventory (const char file[])
 { 
-	// The input file stream.
-	ifstream infile;
+	// The mapped input file.
+	MappedFile infile;
 
-	char item_type;
-	Object *item;
+	// Parsed items, loaded into the trees all at once.
+	vector<Object *> items;
 
 	if (openFile (file, infile)) {
-		for (;;) {
-			// Get item type.
-			item_type = infile.peek ();
-
-			// Get item from factory.
-			item = my_item_factory->
-				getNewObject (infile); 
-
-			// Handle end of file.
-			if (infile.eof()) {
-				if (item) delete item;
-				break;
-			} 
-			// If valid item type.
-			if(item) my_manager->	
-				addItem(item, item_type);	
-		} 
+		loadFile (infile, false, items);
+		my_manager->addItems (items);
 	}
-	item = NULL;
 }
 
 
@@ -231,47 +573,240 @@ void StoreInitializer::init_inventory (const char file[])
  */
 void StoreInitializer::init_transactions (const char file[])
 {
-	// The input file stream.
-	ifstream infile;
+	// The mapped input file, and its current line.
+	MappedFile infile;
+	FieldReader line;
+	Command transaction;
 
-	Object *obj = NULL;
-	Object *tem = NULL;
 	if (openFile (file, infile)) {
-		for (;;) {
-			// Get item from factory.
-			obj = my_transaction_factory-> 
-				getNewObject (infile); 
-
-			// Handle end of file.
-			if (infile.eof()) {
-				if (obj) delete obj;
-				break;
-			} 
-
-			// If valid item type.
-			if(obj) {
-				// Check for processable transaction.	
-				tem = my_item_factory->		
-					getNewObject (infile);		
-
-				if (tem) { // Link item in.  
-					try {
-					Processable *cast = 
-					dynamic_cast<Processable *>(obj);
-					Item *pt = dynamic_cast<Item *> (tem);
-					cast->setItem (pt);	
-					cast = NULL;
-					} catch (exception &e) {
-						cout << "Exception: "
-					 	<< e.what () << endl;	
-					} 
-				} 
-				my_manager->addTransaction(obj);	
-			}
+		while (infile.nextLine (line)) {
+			if (parseTransaction (line, transaction)) 
+				my_manager->addTransaction (transaction);
 		}
 	}
-	obj = NULL;
-	tem = NULL;
+}
+
+
+//---------------------stream_transactions----------------------------
+/**
+ * @brief Executes the transactions of the file as a parser thread 
+ *	  reads them into a bounded queue. Each is handed to 
+ *	  my_manager alone and processed at once, so the pending queue
+ *	  never holds more than one. If the thread cannot be started,
+ *	  this thread parses and executes each line in turn. The 
+ *	  reports are waited for once, at the end.
+ *
+ * Preconditions: The Items and Customers have been loaded.
+ *
+ * Postconditions: Every transaction has been processed, its reports 
+ *		   written, and the number processed returned. Lines
+ *		   that hold no transaction are not counted.
+ *
+ * @param file The transactions file.
+ * @return The number of transactions processed.
+ */
+long long StoreInitializer::stream_transactions (const char file[])
+{
+	MappedFile infile;
+	FieldReader line;
+	BoundedQueue<Command> queue (PIPELINE_DEPTH);
+	TransactionStream stream;
+	pthread_t parser;
+	Command transaction;
+	long long processed = 0;
+
+	if (!openFile (file, infile)) return 0;
+	stream.loader = this;
+	stream.infile = &infile;
+	stream.queue  = &queue;
+	cout.flush ();
+
+	if (pthread_create (&parser, NULL, parseTransactions, &stream) != 0) {
+		while (infile.nextLine (line)) {
+			if (!parseTransaction (line, transaction)) continue;
+			my_manager->addTransaction (transaction);	
+			my_manager->processTransactions ();
+			processed++;
+		}
+		my_manager->flushReport ();
+		return processed;
+	}
+
+	// Pops fail once the parser has closed the queue and it is empty.
+	while (queue.pop (transaction)) {
+		my_manager->addTransaction (transaction);	
+		my_manager->processTransactions ();
+		processed++;
+	}
+	pthread_join (parser, NULL);
+	my_manager->flushReport ();
+	return processed;
+}
+
+
+//---------------------parseTransactions------------------------------
+/**
+ * @brief Parses the transactions of a TransactionStream into its 
+ *	  queue, then closes the queue. The memory of the lines read is
+ *	  given back every RELEASE_LINES lines. A thread entry point.
+ *
+ * Preconditions: stream points to a TransactionStream.
+ *
+ * Postconditions: Every transaction of the file was queued.
+ *
+ * @param stream The TransactionStream to parse.
+ * @return NULL.
+ */
+void * StoreInitializer::parseTransactions (void *stream)
+{
+	TransactionStream *parse = static_cast<TransactionStream *> (stream);
+	FieldReader line;
+	Command transaction;
+	int lines = 0;
+
+	while (parse->infile->nextLine (line)) {
+		if (parse->loader->parseTransaction (line, transaction)) 
+			parse->queue->push (transaction);
+		if (++lines % RELEASE_LINES == 0) parse->infile->release ();
+	}
+	parse->queue->close ();
+	return NULL;
+}
+
+
+//---------------------parseTransaction-------------------------------
+/**
+ * @brief Parses one line of a transactions file into a Command, with
+ *	  the Item on the rest of the line. No Transaction is made; 
+ *	  that waits until the Command succeeds. Only reads the item
+ *	  factory, so another thread can use it.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned and transaction was set if the 
+ *		   line holds one, false otherwise.
+ *
+ * @param line The line to parse.
+ * @param transaction Set to the parsed Command.
+ * @return True if parsed, false otherwise.
+ */
+bool StoreInitializer::parseTransaction (FieldReader &line, 
+					 Command &transaction) const
+{
+	return transaction.read (line, *my_item_factory);
+}
+
+
+//---------------------loadFile---------------------------------------
+/**
+ * @brief Parses every line of the file into objects. A file of at 
+ *	  least two MIN_CHUNK_SIZE runs is split at line ends into a
+ *	  run per processor, and each run is parsed on its own thread.
+ *	  This thread parses the first run, and any run whose thread 
+ *	  could not be started.
+ *
+ * Preconditions: The file is open, and the factories have been set 
+ *		  up.
+ *
+ * Postconditions: objects holds the parsed objects in file order, 
+ *		   whatever the number of threads.
+ *
+ * @param infile The mapped file.
+ * @param customers True if the file lists customers, false if it 
+ *		    lists items.
+ * @param objects Filled with the parsed objects.
+ */
+void StoreInitializer::loadFile (const MappedFile &infile, 
+			bool customers, vector<Object *> &objects) const
+{
+	vector<FieldReader> runs;
+	vector<LoadChunk> chunks;
+	vector<pthread_t> threads;
+	vector<bool> started;
+	long count = sysconf (_SC_NPROCESSORS_ONLN);
+
+	// Small files are not worth a thread.
+	if (count > infile.getLength () / MIN_CHUNK_SIZE)
+		count = infile.getLength () / MIN_CHUNK_SIZE;
+	if (count > MAX_LOAD_THREADS) count = MAX_LOAD_THREADS;
+	if (count < 1) count = 1;
+	infile.split ((int)count, runs);
+
+	chunks.resize (runs.size ());
+	threads.resize (runs.size ());
+	started.resize (runs.size (), false);
+	for (unsigned int i = 0; i < chunks.size (); i++) {
+		chunks [i].loader    = this;
+		chunks [i].lines     = runs [i];
+		chunks [i].customers = customers;
+	}
+
+	for (unsigned int i = 1; i < chunks.size (); i++)
+		started [i] = (pthread_create (&threads [i], NULL, 
+					loadChunk, &chunks [i]) == 0);
+	for (unsigned int i = 0; i < chunks.size (); i++) {
+		if (started [i]) 
+			pthread_join (threads [i], NULL);
+		else 
+			loadChunk (&chunks [i]);
+	}
+
+	// Merging in file order makes repeated loads identical.
+	for (unsigned int i = 0; i < chunks.size (); i++)
+		objects.insert (objects.end (), chunks [i].objects.begin (),
+				chunks [i].objects.end ());
+}
+
+
+//---------------------loadChunk--------------------------------------
+/**
+ * @brief Parses the lines of a LoadChunk. A thread entry point.
+ *
+ * Preconditions: chunk points to a LoadChunk.
+ *
+ * Postconditions: The objects of the chunk have been parsed.
+ *
+ * @param chunk The LoadChunk to parse.
+ * @return NULL.
+ */
+void * StoreInitializer::loadChunk (void *chunk)
+{
+	LoadChunk *load = static_cast<LoadChunk *> (chunk);
+	FieldReader line;
+	Object *obj;
+
+	while (load->lines.readLine (line)) {
+		obj = load->loader->parseLine (line, load->customers);
+		if (obj) load->objects.push_back (obj);
+	}
+	return NULL;
+}
+
+
+//---------------------parseLine--------------------------------------
+/**
+ * @brief Parses one line of a customer or inventory file. Only reads
+ *	  the factories, so threads can share it.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: A new object, or NULL if the line does not hold 
+ *		   one, was returned.
+ *
+ * @param line The line to parse.
+ * @param customers True for a customer, false for an item.
+ * @return The new object, or NULL.
+ */
+Object * StoreInitializer::parseLine (FieldReader &line, 
+					bool customers) const
+{
+	if (!customers) 
+		return my_item_factory->getNewObject (line);
+
+	// Skip lines without an ID, such as blank ones.
+	if (!isdigit (FieldReader (line).readChar ())) 
+		return NULL;
+	return new Customer (line);
 }
 
 
@@ -286,15 +821,14 @@ void StoreInitializer::init_transactions (const char file[])
  *	 	   returned, false otherwise.
  *
  * @param file The file to open.
- * @param infile The file stream.
+ * @param infile The mapped file.
  * @return True if opened, false otherwise.
  */
 bool StoreInitializer::openFile (const char *file, 
-					ifstream &infile) 
+					MappedFile &infile) 
 {
 	// See if the file opens.
-	infile.open(file);
-	if (!infile) {
+	if (!infile.open (file)) {
 		cout << FILE_O_ERROR << file << endl;
 		return false;
 	}
@@ -23,17 +23,38 @@
  * Includes following features:
  * 	- Allow clients to run the process of initializing the store,
  *	  and start processing the transactions.
+ *	- Allow clients to stream the transactions, executing each
+ *	  while the next ones are parsed, in constant memory.
+ *	- Allow clients to load the store and stream the transactions
+ *	  as separate steps, so each can be timed.
+ *	- Allow clients to save the store to a snapshot, and to 
+ *	  restart from it instead of the text files.
+ *	- Allow clients to journal the transactions, so that a
+ *	  crash loses none that was synced, and to checkpoint the
+ *	  journal into the snapshot.
+ *	- Allow clients to tear the store down and start over in
+ *	  constant time, however many objects it held.
  * 
  * Assumptions:
  * 	- The file directories exist and contain valid format 
  *	  according to Lab 4 specifications.
+ *	- One store runs at a time. Its Items, Customers and
+ *	  Transactions come from the Region, which is reset when
+ *	  the store is torn down.
  */
 //--------------------------------------------------------------------
 
 #ifndef STOREINITIALIZER_H
 #define STOREINITIALIZER_H
 
-#include <fstream>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstdio>
+#include "mapped_file.h"
+#include "bounded_queue.h"
+#include "journal_file.h"
+#include "region.h"
 #include <iostream> 
 #include <iomanip>
 #include "store_manager.h" 
@@ -69,38 +90,59 @@ string const FILE_O_ERROR = "Error: Failed to open file - ";
  * @brief The failed close file error message.  
  */ 
 string const FILE_C_ERROR = "Error: Failed to close file - "; 
+/** 
+ * @brief The unusable snapshot error message.  
+ */ 
+string const SNAPSHOT_ERROR = "Error: Unusable snapshot - "; 
+/** 
+ * @brief The unusable journal error message.  
+ */ 
+string const JOURNAL_ERROR = "Error: Unusable journal - "; 
 /**
- * @brief The Rock CD unique identifer. 
+ * @brief The smallest run of a file parsed on its own thread. 
  */
-char const ROCK_ID = 'R';
+long const MIN_CHUNK_SIZE = 1 << 20;
+
 /**
- * @brief The Classical CD unique identifer. 
+ * @brief The most threads used to parse one file. 
  */
-char const CLASSIC_ID = 'C';
+long const MAX_LOAD_THREADS = 64;
+
 /**
- * @brief The DVD unique identifier.
+ * @brief The most parsed transactions waiting to be executed when the
+ *	  transactions are streamed. 
  */
-char const DVD_ID = 'D';
+int const PIPELINE_DEPTH = 4096;
+
+/**
+ * @brief The number of lines of a streamed file read between giving 
+ *	  back the memory of the lines before them. 
+ */
+int const RELEASE_LINES = 1 << 16;
+
 /**
- * @bief The Purchase Transaction identifier.
+ * @brief The most journal records written and synced together. 
  */
-char const PURCHASE_ID = 'P';
+int const JOURNAL_GROUP = 64;
+
 /**
- * @brief The Trade Transaction identifier.
+ * @brief The longest a journal record waits for its group to fill, in
+ *	  milliseconds. 
  */
-char const TRADE_ID = 'T';
+int const JOURNAL_DELAY = 5;
+
 /**
- * @brief The History Transaction identifier. 
+ * @brief The Rock CD unique identifer. 
  */
-char const HISTORY_ID = 'H';
+char const ROCK_ID = 'R';
 /**
- * @brief The All History Transaction identifier.  
+ * @brief The Classical CD unique identifer. 
  */
-char const ALL_ID = 'A';
+char const CLASSIC_ID = 'C';
 /**
- * @brief The Inventory Transaction identifier.
+ * @brief The DVD unique identifier.
  */
-char const INVENTORY_ID = 'I';
+char const DVD_ID = 'D';
 
 
 /**
@@ -143,7 +185,8 @@ public:
 	// --------------------Destructor-----------------------------
 	/**
 	 * @brief Deallocates my_manager and the factories and sets 
-	 * 	  their pointers to NULL.
+	 * 	  their pointers to NULL. The objects of the store are
+	 *	  freed with the Region.
 	 *
 	 * Preconditions: my_manager and the factories point to 	
 	 *		  dynamically allocated objects or NULL. 
@@ -168,10 +211,196 @@ public:
 	void run ();
 
 
+	// --------------------runStreaming---------------------------
+	/**
+	 * @brief Initializes the store Items and Customers, then 
+	 *	  streams the Transactions: a parser thread reads the
+	 *	  file into a bounded queue while this thread executes
+	 *	  them in order. The parser waits whenever the queue
+	 *	  is full, so memory does not grow with the file.
+	 *
+	 * Preconditions: The factories and my_manager have been	
+	 *	 	  initialized.
+	 *
+	 * Postconditions: The store Items and Customers have been 
+	 *		   initialized, and every Transaction has been
+	 *		   processed.
+	 */ 
+	void runStreaming ();
+
+
+	// --------------------initStore------------------------------
+	/**
+	 * @brief Initializes the store Items and Customers from the
+	 *	  text files: the first half of runStreaming.
+	 *
+	 * Preconditions: The factories and my_manager have been	
+	 *	 	  initialized, and nothing was loaded yet.
+	 *
+	 * Postconditions: The store Items and Customers have been 
+	 *		   initialized.
+	 */ 
+	void initStore ();
+
+
+	// --------------------streamTransactions---------------------
+	/**
+	 * @brief Streams the Transactions of the text file through
+	 *	  the store: the second half of runStreaming.
+	 *
+	 * Preconditions: The store Items and Customers have been 
+	 *		  initialized.
+	 *
+	 * Postconditions: Every Transaction has been processed, its
+	 *		   report written, and the number processed 
+	 *		   returned.
+	 *
+	 * @return The number of Transactions processed.
+	 */ 
+	long long streamTransactions ();
+
+
+	// --------------------run------------------------------------
+	/**
+	 * @brief Restarts the store from the provided snapshot. If it
+	 *	  cannot be loaded, the store is initialized from the
+	 *	  text files and the transactions are processed, as 
+	 *	  by run, and the snapshot is then saved for the next
+	 *	  restart.
+	 *
+	 * Preconditions: The factories and my_manager have been	
+	 *	 	  initialized, and nothing was loaded yet.
+	 *
+	 * Postconditions: The store holds the state of the snapshot,
+	 *		   or of the processed text files.
+	 *
+	 * @param snapshot The snapshot file.
+	 */ 
+	void run (const char snapshot[]);
+
+
+	//---------------------saveSnapshot---------------------------
+	/**
+	 * @brief Saves the inventory and the customers, with their 
+	 *	  histories, to a snapshot file.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the snapshot was 
+	 *		   saved, false otherwise.
+	 *
+	 * @param file The snapshot file.
+	 * @return True if saved, false otherwise.
+	 */
+	bool saveSnapshot (const char file[]) const;
+
+
+	//---------------------loadSnapshot---------------------------
+	/**
+	 * @brief Loads a snapshot saved by saveSnapshot. Every 
+	 *	  checksum is checked before anything is loaded. 
+	 *
+	 * Preconditions: Nothing was loaded yet.
+	 *
+	 * Postconditions: True was returned if the snapshot was 
+	 *		   loaded. Otherwise false was returned and the
+	 *		   store is empty.
+	 *
+	 * @param file The snapshot file.
+	 * @return True if loaded, false otherwise.
+	 */
+	bool loadSnapshot (const char file[]);
+
+
+	//---------------------openJournal----------------------------
+	/**
+	 * @brief Replays the journal onto the store, then journals 
+	 *	  every purchase and trade that changes the store from
+	 *	  now on. Records are synced in groups by a flusher 
+	 *	  thread, so no transaction waits for the disk. A 
+	 *	  journal the snapshot already holds is started over,
+	 *	  as is a missing one.
+	 *
+	 * Preconditions: The store holds the state of the last 
+	 *		  snapshot, or of the text files without the 
+	 *		  transactions if there is none.
+	 *
+	 * Postconditions: True was returned if the journal was 
+	 *		   replayed and opened, false otherwise.
+	 *
+	 * @param file The journal file.
+	 * @param group The most records synced together, such as 
+	 *		JOURNAL_GROUP.
+	 * @param delay The longest a record waits for its group, in
+	 *		milliseconds, such as JOURNAL_DELAY.
+	 * @return True if opened, false otherwise.
+	 */
+	bool openJournal (const char file[], int group, int delay);
+
+
+	//---------------------closeJournal---------------------------
+	/**
+	 * @brief Syncs and closes the journal. Later transactions are
+	 *	  not journaled.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if every record was 
+	 *		   durable, false otherwise.
+	 *
+	 * @return True if durable, false otherwise.
+	 */
+	bool closeJournal ();
+
+
+	//---------------------checkpoint-----------------------------
+	/**
+	 * @brief Saves the store to the snapshot, replacing it only 
+	 *	  once the new one is on disk, then empties the 
+	 *	  journal, whose records the snapshot now holds.
+	 *
+	 * Preconditions: The journal is open.
+	 *
+	 * Postconditions: True was returned if the snapshot was saved
+	 *		   and the journal emptied, false otherwise.
+	 *
+	 * @param snapshot The snapshot file.
+	 * @return True if checkpointed, false otherwise.
+	 */
+	bool checkpoint (const char snapshot[]);
+
+
+	//---------------------reset----------------------------------
+	/**
+	 * @brief Tears the store down and starts an empty one, as if
+	 *	  this StoreInitializer were new. 
+	 *
+	 * Preconditions: No other thread uses the store.
+	 *
+	 * Postconditions: The journal was closed, every object of the
+	 *		   store was freed, and the store is empty.
+	 */
+	void reset ();
+
+
 /**
  * @private
  */	
 private:
+	//---------------------teardown-------------------------------
+ 	/**
+	 * @brief Deletes my_manager and the factories without visiting
+	 *	  the objects they hold, then frees the objects all at
+	 *	  once by resetting the Region.
+	 *
+	 * Preconditions: The journal is closed.
+	 *
+	 * Postconditions: my_manager and the factories were deleted
+	 *		   and set to NULL.
+	 */
+	void teardown ();
+
+
 	//---------------------init_item_factory----------------------
  	/**
 	 * @brief Sets up the ObjectFactory with the different types
@@ -185,6 +414,18 @@ private:
 	void init_item_factory ();
 	
 
+	//---------------------init_manager---------------------------
+ 	/**
+	 * @brief Creates an empty StoreManager, with a tree for each
+	 *	  type of Item.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: my_manager is empty, and has its trees.
+	 */
+	void init_manager ();
+
+
 	//---------------------init_transaction_factory---------------
  	/**
 	 * @brief Sets up the ObjectFactory with the different types
@@ -216,7 +457,9 @@ private:
 
 	//---------------------init_inventory-------------------------
 	/**
-	 * @brief Initializes the store inventory Items.
+	 * @brief Initializes the store inventory Items. The whole
+	 *	  file is parsed first and then bulk loaded into
+	 *	  my_manager.
 	 *
 	 * Preconditions: The file associated with the inventory is 
 	 *	 	  in the correct directory and contains a 
@@ -246,6 +489,133 @@ private:
 	void init_transactions (const char file[]);
 
 
+	//---------------------stream_transactions--------------------
+	/**
+	 * @brief Executes the transactions of the file as a parser
+	 *	  thread reads them into a bounded queue.
+	 *
+	 * Preconditions: The Items and Customers have been loaded.
+ 	 *
+	 * Postconditions: Every transaction has been processed, and
+	 *		   the number processed returned.
+	 *
+	 * @param file The transactions file.
+	 * @return The number of transactions processed.
+	 */
+	long long stream_transactions (const char file[]);
+
+
+	/**
+	 * @brief The file streamed by the parser thread, and the 
+	 *	  queue it fills.
+	 */
+	struct TransactionStream {
+		const StoreInitializer *loader;
+		MappedFile *infile;
+		BoundedQueue<Command> *queue;
+	};
+
+
+	//---------------------parseTransactions----------------------
+	/**
+	 * @brief Parses the transactions of a TransactionStream into
+	 *	  its queue, then closes the queue. A thread entry 
+	 *	  point.
+	 *
+	 * Preconditions: stream points to a TransactionStream.
+	 *
+ 	 * Postconditions: Every transaction of the file was queued.
+	 *
+	 * @param stream The TransactionStream to parse.
+	 * @return NULL.
+	 */
+	static void * parseTransactions (void *stream);
+
+
+	//---------------------parseTransaction-----------------------
+	/**
+	 * @brief Parses one line of a transactions file into a 
+	 *	  Command, with the Item on the rest of the line. Only
+	 *	  reads the item factory, so another thread can use it.
+	 *
+	 * Preconditions: None.
+	 *
+ 	 * Postconditions: True was returned and transaction was set 
+	 *		   if the line holds one, false otherwise.
+	 *
+	 * @param line The line to parse.
+	 * @param transaction Set to the parsed Command.
+	 * @return True if parsed, false otherwise.
+	 */
+	bool parseTransaction (FieldReader &line, 
+			       Command &transaction) const;
+
+
+	/**
+	 * @brief A run of lines of a file being loaded, and the 
+	 *	  objects parsed from it.
+	 */
+	struct LoadChunk {
+		const StoreInitializer *loader;
+		FieldReader lines;
+		bool customers;
+		vector<Object *> objects;
+	};
+
+
+	//---------------------loadFile-------------------------------
+	/**
+	 * @brief Parses every line of the file into objects. Large
+	 *	  files are split into runs of lines that are parsed
+	 *	  on their own threads.
+	 *
+	 * Preconditions: The file is open, and the factories have 
+	 *		  been set up.
+	 *
+ 	 * Postconditions: objects holds the parsed objects in file
+	 *		   order, whatever the number of threads.
+	 *
+	 * @param infile The mapped file.
+	 * @param customers True if the file lists customers, false
+	 *		    if it lists items.
+	 * @param objects Filled with the parsed objects.
+	 */
+	void loadFile (const MappedFile &infile, bool customers, 
+		       vector<Object *> &objects) const;
+
+
+	//---------------------loadChunk------------------------------
+	/**
+	 * @brief Parses the lines of a LoadChunk. A thread entry 
+	 *	  point.
+	 *
+	 * Preconditions: chunk points to a LoadChunk.
+	 *
+ 	 * Postconditions: The objects of the chunk have been parsed.
+	 *
+	 * @param chunk The LoadChunk to parse.
+	 * @return NULL.
+	 */
+	static void * loadChunk (void *chunk);
+
+
+	//---------------------parseLine------------------------------
+	/**
+	 * @brief Parses one line of a customer or inventory file.
+	 *	  Only reads the factories, so threads can share it.
+	 *
+	 * Preconditions: None.
+	 *
+ 	 * Postconditions: A new object, or NULL if the line does not
+	 *		   hold one, was returned.
+	 *
+	 * @param line The line to parse.
+	 * @param customers True for a customer, false for an item.
+	 * @return The new object, or NULL.
+	 */
+	Object * parseLine (FieldReader &line, bool customers) const;
+
+
 	//---------------------openFile-------------------------------
 	/**
 	 * @brief A helper method that opens the file associated with
@@ -258,10 +628,10 @@ private:
 	 *		   is returned, false otherwise.
 	 *
 	 * @param file The file to open.
-	 * @param infile The file stream.
+	 * @param infile The mapped file.
 	 * @return True if opened, false otherwise.
 	 */
-	bool openFile (const char *file, ifstream &infile);
+	bool openFile (const char *file, MappedFile &infile);
 
 
 	/**
@@ -279,6 +649,11 @@ private:
 	 * @brief Allocates appropriate transaction items.
 	 */
 	ObjectFactory *my_transaction_factory; 
+
+	/**
+	 * @brief The journal of the transactions, or NULL.
+	 */
+	JournalWriter *my_journal;
 };
 #endif /* STOREINITIALIZER_H */
 
@@ -19,8 +19,17 @@
  * Includes following features:
  * 	- Allows adding a Customer object.
  *	- Allows adding a Item object to the inventory.
+ *	- Allows bulk loading many Item objects into the inventory.
  * 	- Allows adding a Transaction object.
  *	- Allows processing the Transactions.  
+ *	- Allows saving the inventory and customers to a snapshot,
+ *	  and loading them back.
+ *	- Allows journaling every purchase and trade that changed 
+ *	  the store, and replaying a journal after a restart.
+ *	- Keeps the customers' histories in one TransactionLog, whose
+ *	  entries refer to the Items listed in the inventory.
+ *	- Keeps the units in stock of each inventory tree, so a 
+ *	  category total takes constant time.
  * 
  * Assumptions:
  * 	- The Customers, Transactions, and Items are not NULL when 
@@ -41,10 +50,17 @@
  */
 StoreManager::StoreManager ()
 {
-	my_item_trees      = new BSTree   *[DEFAULT_N_ITEMS];
-	my_customer_table  = new Object *[DEFAULT_N_CUSTOMERS];
-	my_customers       = new BSTree ();
-	my_transactions    = new queue <Object *> ();
+	my_item_trees      = new OrderedIndex *[DEFAULT_N_ITEMS];
+	my_units           = new int [DEFAULT_N_ITEMS];
+	my_customer_table  = new HashTable<long long, Object *> (true);
+	my_customers       = new BSTree (true);
+	my_stock           = new HashTable<string, Stock> (true);
+	my_log             = new TransactionLog ();
+	my_transactions    = new queue <Command> ();
+	my_journal         = NULL;
+	my_generation      = 0;
+	my_writer          = new ReportWriter (STDOUT_FILENO);
+	my_report          = new ostream (my_writer);
 	my_size = DEFAULT_N_ITEMS;
 	init_trees ();
 }
@@ -61,30 +77,67 @@ StoreManager::StoreManager ()
 StoreManager::~StoreManager ()
 {
 	// Get rid of the blood sucking leaches.
-	delete my_item_trees;
+	for (int i = 0; i < my_size; i++)
+		delete my_item_trees [i];
+	delete [] my_item_trees;
+	delete [] my_units;
 	delete my_customer_table;
 	delete my_customers;
+	delete my_stock;
+	delete my_log;
+	delete my_transactions;
+	delete my_report;
+	delete my_writer;
 	my_item_trees      = NULL;
+	my_units           = NULL;
 	my_customer_table  = NULL;
 	my_customers       = NULL; 
+	my_stock           = NULL;
+	my_log             = NULL;
+	my_transactions    = NULL;
+	my_report          = NULL;
+	my_writer          = NULL;
+}
+
+
+//---------------------clear------------------------------------------
+/**
+ * @brief Empties the trees without deleting the Items and Customers 
+ *	  in them, which are freed with the Region. Only the nodes of 
+ *	  the trees and the blocks of the TransactionLog are released.
+ *	  The tables and the pending transactions never delete what 
+ *	  they hold.
+ * 	 
+ * Preconditions: The Region is about to be reset.
+ * 
+ * Postconditions: The store is empty, and deleting it does not touch
+ *		   the objects it held.
+ */
+void StoreManager::clear ()
+{
+	for (int i = 0; i < my_size; i++)
+		if (my_item_trees [i] != NULL)
+			my_item_trees [i]->clear ();
+	my_customers->clear ();
+	my_log->clear ();
 }
 
 
 //---------------------addTransaction---------------------------------
 /**
- * @brief Adds the provided Transaction object to the queue of pending 
- *	  transactions.
+ * @brief Adds the provided Command to the queue of pending 
+ *	  transactions. The queue holds Commands by value.
  * 
  * Preconditions: The queue of pending Transactions has been 
  *		  initialized. 
  * 
- * Postconditions: The provided Transaction was added to the pending
- *		   transaction queue.
+ * Postconditions: The provided Command was added to the pending 
+ *		   transaction queue, which now owns its Item.
  * 
  * @param transaction The transaction to add to the pending 
  *		      transaction queue.
  */
-void StoreManager::addTransaction (Object *transaction)
+void StoreManager::addTransaction (const Command &transaction)
 {
 	my_transactions->push (transaction);	
 }
@@ -103,41 +156,74 @@ void StoreManager::addTransaction (Object *transaction)
  * @param customer The Customer to add.
  * @param id The customer Id.
  */
-void StoreManager::addCustomer (Object *customer, int id)
+void StoreManager::addCustomer (Object *customer, long long id)
 {
-	// Add the customer to the tree and look-up table.
+	// Add the customer to the tree and the ID table.
 	my_customers->insert (customer);
-	my_customer_table [id] = customer;
+	my_customer_table->add (id, customer);
 }
 
 
-//---------------------addItem----------------------------------------
+//---------------------addItems---------------------------------------
 /**
- * @brief Adds the provided store inventory Item to the tree of store
- *	  inventory items.
+ * @brief Bulk loads the provided store inventory Items. The Items are
+ *	  grouped by type and sorted, equal Items are merged by adding
+ *	  their counts, and each inventory tree is then built from its
+ *	  sorted Items in one pass. The trees list each title once, and
+ *	  its count goes to the stock.
  *
- * Preconditions: 
+ * Preconditions: Every Item's type is mapped to a tree.
  * 
- * Postconditions: The provided Item has been added to the collection
- *		   of inventory items.
+ * Postconditions: The Items have been added to the inventory, and 
+ *		   items is empty. Items merged into an equal Item, or
+ *		   with no count, were deleted.
  *
- * @param item The Item to add.
- * @param type The type of item.
+ * @param items The Items to add.
  */
-void StoreManager::addItem (Object *item, char type)
+void StoreManager::addItems (vector<Object *> &items)
 {
-	int count;
-	try {
-		Item *tem = dynamic_cast <Item *> (item);
-		count = tem->getCount ();
-	} catch (exception &e) {
-		cout << "Exception: " << e.what () << endl;
+	vector< vector<Object *> > groups (my_size);
+	vector<Object *> sorted;
+	vector<int>      counts;
+	int i, j, count;
+
+	// Group the Items by the tree they belong in.
+	for (i = 0; i < (int)items.size (); i++) {
+		const Item *tem = static_cast<const Item *> (items [i]);
+		groups [tem->getType () - 'A'].push_back (items [i]);
+	}
+	items.clear ();
+
+	for (i = 0; i < my_size; i++) {
+		if (groups [i].empty ()) continue;
+		sort (groups [i].begin (), groups [i].end (), lessThan);
+
+		// Merge runs of equal Items into one with their counts.
+		sorted.clear ();
+		counts.clear ();
+		for (j = 0; j < (int)groups [i].size (); j++) {
+			Object *item = groups [i][j];
+			count = static_cast<const Item *> (item)->getCount ();
+
+			if (count <= 0) 
+				delete item;
+			else if (!sorted.empty () && 
+				 sorted.back ()->compareTo (*item) == 0) {
+				counts.back () += count;
+				delete item;
+			}
+			else {
+				sorted.push_back (item);
+				counts.push_back (count);
+			}
+		}
+		for (j = 0; j < (int)sorted.size (); j++)
+			addStock (*sorted [j], counts [j]);
+
+		// The trees list each title once; its count is the stock.
+		counts.assign (sorted.size (), 1);
+		my_item_trees [i]->build (sorted, counts);
 	}
-	int i;
-        int index = type - 'A';
-	
-	for (i = 0; i < count; i++)
-        	my_item_trees [index]->insert (item); 
 }
 
 
@@ -153,122 +239,161 @@ void StoreManager::addItem (Object *item, char type)
 void StoreManager::processTransactions () 
 {
 	try {
-		Transaction *ptr;
 		while (!my_transactions->empty()) {
-     ptr = dynamic_cast<Transaction *> (my_transactions->front());
-			ptr->execute (this);	
+			evaluateTransaction (my_transactions->front ());
 			my_transactions->pop();
 		} 
 	} catch (exception &e) {
-		cout << "Exception: " << e.what () << endl;
+		*my_report << "Exception: " << e.what () << endl;
 	} 
 }
 
 
-//---------------------purchase---------------------------------------
+//---------------------evaluateTransaction----------------------------
 /**
- * @brief Processes the purchase transaction. 
+ * @brief Evaluate the transaction by first getting the transaction 
+ *	  type, and then calling the appropriate method for processing.
+ *	  The types are a closed set, so this is a switch, with no cast
+ *	  or virtual call.
  * 
- * Preconditions: The Item exists in the Item tree.
+ * Preconditions: None.
+ *
+ * Postconditions: The transaction has been evaluated, and its Item 
+ *		   kept or deleted.
  *
- * Postconditions: The purchase has been processed.
+ * @param transaction The transaction to evaluate.
  */
-void StoreManager::purchase ()
+void StoreManager::evaluateTransaction (Command &transaction)
 {
-	PurchaseTransaction *ptr;
-	try { 
-		// Get the derived type.
-		ptr = dynamic_cast<PurchaseTransaction *> 
-					(my_transactions->front());
-	} catch (exception &e) {
-		cout << "Exception: " << e.what () << endl;
+	switch (transaction.getType ()) {
+	case PURCHASE_ID:
+		purchase (transaction);
+		break;
+	case TRADE_ID:
+		trade (transaction);
+		break;
+	case HISTORY_ID:
+		printHistory (transaction.getCustomerId ());
+		break;
+	case INVENTORY_ID:
+		printInventory ();
+		break;
+	case ALL_ID:
+		printAllHistory ();
+		break;
+	default:
+		transaction.discard ();
 	}
+}
 
+
+//---------------------purchase---------------------------------------
+/**
+ * @brief Processes the purchase transaction. The purchase is added to
+ *	  the customer's history only if it succeeds.
+ * 
+ * Preconditions: The Item exists in the Item tree.
+ *
+ * Postconditions: The purchase has been processed, and its Item kept
+ *		   or deleted.
+ *
+ * @param transaction The purchase.
+ */
+void StoreManager::purchase (Command &transaction)
+{
 	// Get the Item.
-	const Item *item = ptr->getItem ();
+	Item *item = transaction.getItem ();
 
 	if (item) {	
-		// Check valid customer Id.
-		if (ptr->getCustomerId() > 0 && ptr->getCustomerId() < DEFAULT_N_CUSTOMERS) {
+		// Get the customer.
+		Customer *c = findCustomer (transaction.getCustomerId ());
 
-			// Get the Item tree. 
-			BSTree *p_tree = my_item_trees [(item->getType() - 'A')]; 
+		// Check valid customer Id.
+		if (c) {
 
-			// Query the tree for the item.
-			if (p_tree->remove (*item)) { 
+			// Look up the stock of the title.
+			Stock *stock = my_stock->get (item->getSortKey ());
 
-				Customer *c;
-				try { 
-					// Get the customer.
-					c = dynamic_cast<Customer *> (my_customer_table [ptr->getCustomerId ()]);	
-				} catch (exception &e) {
-					cout << "Exception: " << e.what () << endl;
-				}
+			if (stock != NULL && stock->count > 0) { 
+				journal (transaction);
+				stock->count--;
+				my_units [item->getType () - 'A']--;
 
 				// Add to customer history.
-				c->addTransaction (ptr);
+				keep (*c, transaction, stock->title);
 				c = NULL;
 
 			// Otherwise, display not available.
 			} else {
-				cout << "Product not in stock: " << *item << endl;
-				delete ptr;
+				*my_report << "Product not in stock: " << *item << endl;
+				transaction.discard ();
 			}
-		
-			p_tree = NULL; 
 
 		// Customer doesn't exist 
 		}  else {
-			cout << "Customer ( " 
-			<< ptr->getCustomerId() 
+			*my_report << "Customer ( " 
+			<< transaction.getCustomerId() 
 			<< " )" 
 			<< " does not exist." 
 			<< endl;
-			delete ptr; 
+			transaction.discard (); 
 		} 
 	} 
-	
-	else { // Transaction item is NULL.
-		delete ptr;
-	} 
-	ptr    = NULL;
-	item   = NULL; 
+	item = NULL; 
 }
 
 
 //---------------------trade------------------------------------------
 /**
  * @brief Adds the Item to the collection of store inventory, and adds
- *	  the transaction to the associated customers' history.
+ *	  the transaction to the associated customers' history. The 
+ *	  trade is added to the history only if it succeeds.
  *
  * Preconditions: The Item exists in the item tree. 
  * 
- * Postconditions: The trade-in has been processed.
+ * Postconditions: The trade-in has been processed, and its Item kept 
+ *		   or deleted.
+ *
+ * @param transaction The trade.
  */
-void StoreManager::trade ()
+void StoreManager::trade (Command &transaction)
 {
-	TradeTransaction *ptr;
-	try { 
-		ptr = dynamic_cast<TradeTransaction *> (my_transactions->front());
-	} catch (exception &e) {
-		cout << "Exception: " << e.what () << endl;
+	// Get the customer.
+	Customer *c = findCustomer (transaction.getCustomerId ());
+
+	if (c == NULL) {
+		*my_report << "Customer ( " 
+		<< transaction.getCustomerId() 
+		<< " )" 
+		<< " does not exist." 
+		<< endl;
+		transaction.discard ();
+		return;
 	}
-	
+
+	Item *tem = transaction.getItem ();
+	if (tem == NULL) return;
+	Stock *stock = my_stock->get (tem->getSortKey ());
+
+	// A known title only needs its stock raised.
+	if (stock != NULL) {
+		journal (transaction);
+		stock->count++;
+		my_units [tem->getType () - 'A']++;
+		keep (*c, transaction, stock->title);
+		return;
+	}
+
 	// Make a copy to insert. 
-	Object *item = ptr->getItem ()->clone ();
+	Object *item = tem->clone ();
 	if (item) {
-		const Item *tem = ptr->getItem ();
-
 		// Try inserting item. 
 		if (my_item_trees[(tem->getType () - 'A')]-> insert (item)) {
-			// If success, add transaction to the customer.	
-			Customer *c;	
+			journal (transaction);
+			addStock (*item, 1);
 
-			// Get the customer.
-			c = dynamic_cast<Customer *> (my_customer_table [ptr->getCustomerId ()]);	
-		
-			// Add transaction to customer history.
-			c->addTransaction (ptr);
+			// If success, add transaction to customer history.
+			keep (*c, transaction, static_cast<Item *> (item));
 
 			// No dingleberries in my tree.
 			c = NULL;
@@ -276,11 +401,11 @@ void StoreManager::trade ()
 		
 		// Otherwise, display not available.
 		else {
-			cout << "Unable to Trade Product: " << *item << endl;
+			*my_report << "Unable to Trade Product: " << *item << endl;
 			
 			// The transaction wasn't stored with a customer.
 			// So kill it.
-			delete ptr; // We have to do it for them. 
+			transaction.discard ();
 
 			// Kill the copy.
 			delete item;
@@ -288,9 +413,8 @@ void StoreManager::trade ()
 		tem = NULL;
 	}
 	else { // Ite trade Item is NULL.
-		delete ptr;
+		transaction.discard ();
 	}
-	ptr  = NULL;
 	item = NULL; 
 }
 
@@ -306,12 +430,35 @@ void StoreManager::trade ()
  */
 void StoreManager::printInventory () const
 {
-	cout << BANNER << endl;
-	cout << setw (45) << INVENTORY << endl;
-	cout << BANNER << endl;
-	cout << *my_item_trees ['R' - 'A'] << endl << endl;
-	cout << *my_item_trees ['C' - 'A'] << endl << endl;
-	cout << *my_item_trees ['D' - 'A'] << endl << endl;
+	*my_report << BANNER << endl;
+	*my_report << setw (45) << INVENTORY << endl;
+	*my_report << BANNER << endl;
+	*my_report << *my_item_trees ['R' - 'A'] << endl << endl;
+	*my_report << *my_item_trees ['C' - 'A'] << endl << endl;
+	*my_report << *my_item_trees ['D' - 'A'] << endl << endl;
+}
+
+
+//---------------------getUnits---------------------------------------
+/**
+ * @brief Returns the number of copies in stock of all the titles of an
+ *	  inventory tree, without visiting the titles.
+ *
+ * Preconditions: None.
+ * 
+ * Postconditions: The units in stock were returned, or zero if no 
+ *		   tree is mapped to type.
+ *
+ * @param type The type of item.
+ * @return The units in stock.
+ */
+int StoreManager::getUnits (char type) const
+{
+	int index = type - 'A';
+
+	if (index < 0 || index >= my_size || my_item_trees [index] == NULL)
+		return 0;
+	return my_units [index];
 }
 
 
@@ -326,17 +473,19 @@ void StoreManager::printInventory () const
  *
  * @param id The customer ID who's hitory is to be printed.
  */
-void StoreManager::printHistory (int id) const
+void StoreManager::printHistory (long long id) const
 {
-	if (my_customer_table [id]) {
-		cout << BANNER << endl;
-		cout << setw (49) << HISTORY << endl;
-		cout << BANNER << endl; 
-		cout << *my_customer_table [id];
-		cout << endl << endl;
+	const Object *customer = findCustomer (id);
+
+	if (customer) {
+		*my_report << BANNER << endl;
+		*my_report << setw (49) << HISTORY << endl;
+		*my_report << BANNER << endl; 
+		*my_report << *customer;
+		*my_report << endl << endl;
 	}
 	else {
-		cout << "Unable to Print Customer ( " 
+		*my_report << "Unable to Print Customer ( " 
 	     	<< id 
 	        << " )." 
 	        << "Does not exist." 
@@ -356,11 +505,11 @@ void StoreManager::printHistory (int id) const
  */
 void StoreManager::printAllHistory () const
 {
-	cout << BANNER << endl;
-	cout << setw (55) << ALL_HIS << endl;
-	cout << BANNER << endl << endl; 
-	cout << *my_customers;
-	cout << endl << endl;
+	*my_report << BANNER << endl;
+	*my_report << setw (55) << ALL_HIS << endl;
+	*my_report << BANNER << endl << endl; 
+	*my_report << *my_customers;
+	*my_report << endl << endl;
 }
 
 
@@ -375,18 +524,226 @@ void StoreManager::printAllHistory () const
  * @param key The key.
  * @param tree The tree to map the key to. 
  */
-void StoreManager::mapToTree (char key, BSTree *tree)
+void StoreManager::mapToTree (char key, OrderedIndex *tree)
 {
 	int index = key - 'A';
 
         // Do we need to resize?
-        if (index > my_size)
+        if (index >= my_size)
                 makeBigger (index);
 
         my_item_trees [index] = tree; 
 }
 
 
+//---------------------save-------------------------------------------
+/**
+ * @brief Saves the inventory and the customers to a snapshot. The ITEMS
+ *	  section lists every tree: its key, then each title in order
+ *	  with its stock. The CUSTOMERS section lists every Customer
+ *	  with its history. The JOURNAL section holds the journal
+ *	  generation.
+ *
+ * Preconditions: The snapshot is open, and no section is being written.
+ * 
+ * Postconditions: The sections were written. Pending transactions are
+ *		   not saved.
+ *
+ * @param output The snapshot to write to.
+ */
+void StoreManager::save (SnapshotWriter &output) const
+{
+	vector<const Object *> objects;
+	vector<int> counts;
+	int i, j, trees = 0;
+
+	for (i = 0; i < my_size; i++) 
+		if (my_item_trees [i] != NULL) trees++;
+
+	output.beginSection (SECTION_ITEMS);
+	output.putInt (trees);
+	for (i = 0; i < my_size; i++) {
+		if (my_item_trees [i] == NULL) continue;
+		objects.clear ();
+		counts.clear ();
+		my_item_trees [i]->collect (objects, counts);
+
+		output.putByte ((char)('A' + i));
+		output.putInt ((int)objects.size ());
+		for (j = 0; j < (int)objects.size (); j++) {
+			const Stock *stock = my_stock->get 
+						(objects [j]->getSortKey ());
+			objects [j]->save (output);
+			output.putInt ((stock != NULL) ? stock->count : 0);
+		}
+	}
+	output.endSection ();
+
+	// The customers of the tree come first, in order. A customer 
+	// that shares its name with one of them is only in the table, 
+	// and follows, so loading counts it in the tree the same way.
+	objects.clear ();
+	counts.clear ();
+	my_customers->collect (objects, counts);
+	vector<const Object *> listed (objects);
+	sort (listed.begin (), listed.end ());
+	for (HashTable<long long, Object *>::Iterator it = 
+	     my_customer_table->begin (); 
+	     it != my_customer_table->end (); ++it)
+		if (!binary_search (listed.begin (), listed.end (), 
+				    it.getValue ()))
+			objects.push_back (it.getValue ());
+
+	output.beginSection (SECTION_CUSTOMERS);
+	output.putInt ((int)objects.size ());
+	for (i = 0; i < (int)objects.size (); i++)
+		objects [i]->save (output);
+	output.endSection ();
+
+	output.beginSection (SECTION_JOURNAL);
+	output.putInt ((int)my_generation);
+	output.endSection ();
+}
+
+
+//---------------------load-------------------------------------------
+/**
+ * @brief Loads the inventory and the customers saved by save. Each tree
+ *	  is built from its titles in one pass, as they were saved in 
+ *	  order.
+ *
+ * Preconditions: The snapshot was opened, the store holds no Items or
+ *		  Customers, and the trees are mapped as they were when
+ *		  it was saved. 
+ * 
+ * Postconditions: True was returned if the snapshot was loaded, false
+ *		   if it did not match the store.
+ *
+ * @param input The snapshot to read from.
+ * @param items The factory of the Items.
+ * @return True if loaded, false otherwise.
+ */
+bool StoreManager::load (SnapshotReader &input, const ObjectFactory &items)
+{
+	unsigned int tag;
+
+	// Sections this version does not know are skipped.
+	while (!input.failed () && input.nextSection (tag)) {
+		if (tag == SECTION_ITEMS)
+			loadItems (input, items);
+		else if (tag == SECTION_CUSTOMERS)
+			loadCustomers (input, items);
+		else if (tag == SECTION_JOURNAL)
+			my_generation = (unsigned int)input.getInt ();
+	}
+	return !input.failed ();
+}
+
+
+//---------------------setJournal-------------------------------------
+/**
+ * @brief Sets the journal that every purchase and trade that changes 
+ *	  the store is appended to, before it is applied. Failed 
+ *	  transactions and reports change nothing, so they are not
+ *	  journaled.
+ *
+ * Preconditions: The journal is open, or NULL. It outlives its use by
+ *		  this StoreManager.
+ * 
+ * Postconditions: Later transactions are journaled, or not if journal
+ *		   is NULL.
+ *
+ * @param journal The journal, or NULL.
+ */
+void StoreManager::setJournal (JournalWriter *journal)
+{
+	my_journal = journal;
+}
+
+
+//---------------------flushReport------------------------------------
+/**
+ * @brief Waits until every report and diagnostic printed was written
+ *	  to standard output. Until then, anything else written there
+ *	  may come out ahead of them.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: True was returned if it was all written, false 
+ *		   otherwise.
+ *
+ * @return True if written, false otherwise.
+ */
+bool StoreManager::flushReport ()
+{
+	return my_writer->drain ();
+}
+
+
+//---------------------getGeneration----------------------------------
+/**
+ * @brief Returns the generation of the journal whose records follow 
+ *	  the state of this StoreManager. Journals of an older 
+ *	  generation are already part of the state.
+ *
+ * Preconditions: None.
+ * 
+ * Postconditions: The generation was returned; 0 unless it was set or
+ *		   loaded.
+ *
+ * @return The journal generation.
+ */
+unsigned int StoreManager::getGeneration () const
+{
+	return my_generation;
+}
+
+
+//---------------------setGeneration----------------------------------
+/**
+ * @brief Sets the generation of the journal whose records follow the
+ *	  state of this StoreManager.
+ *
+ * Preconditions: None.
+ * 
+ * Postconditions: The generation was set, and is saved with the 
+ *		   snapshot.
+ *
+ * @param generation The journal generation.
+ */
+void StoreManager::setGeneration (unsigned int generation)
+{
+	my_generation = generation;
+}
+
+
+//---------------------replay-----------------------------------------
+/**
+ * @brief Reads one journal record and processes it again. Only 
+ *	  transactions that succeeded were journaled, so against the
+ *	  same state each succeeds again, silently.
+ *
+ * Preconditions: record reads a journal record, no journal is set, and
+ *		  the store holds the state the record was appended to.
+ * 
+ * Postconditions: True was returned if the transaction was processed,
+ *		   false if the record did not hold one.
+ *
+ * @param record The record to read from.
+ * @param items The factory of the Items.
+ * @return True if replayed, false otherwise.
+ */
+bool StoreManager::replay (SnapshotReader &record, 
+			   const ObjectFactory &items)
+{
+	Command transaction;
+
+	if (!transaction.read (record, items)) return false;
+	evaluateTransaction (transaction);
+	return true;
+}
+
+
 //---------------------init_trees-------------------------------------
 /**
  * @brief Initializes the array of trees.
@@ -397,8 +754,10 @@ void StoreManager::mapToTree (char key, BSTree *tree)
  */
 void StoreManager::init_trees ()
 {
-	for (int i = 0; i <= my_size; i++)
+	for (int i = 0; i < my_size; i++) {
 		my_item_trees [i] = NULL;
+		my_units [i]      = 0;
+	}
 }
 
 
@@ -406,33 +765,40 @@ void StoreManager::init_trees ()
 /**
  * @brief Increase size of tree array.
  *
- * Preconditions: size is bigger than my_tree_size.
+ * Preconditions: size is not less than my_size.
  * 
  * Postconditions: The array was expanded and data copied.
  *
- * @param size The size of the new array.
+ * @param size The largest index the new array holds.
  */
 void StoreManager::makeBigger (int size)
 {
         int index;
 
         // The bigger array.
-        BSTree **copy = new BSTree *[size + 1];
+        OrderedIndex **copy = new OrderedIndex *[size + 1];
 
         // Initialize the pointers.
         for (index = 0; index <= size; index++)
                 copy [index] = NULL;
 
         // Transfer over old data.
-        for (index = 0; index <= my_size; index++)
+        for (index = 0; index < my_size; index++)
                 copy [index] = my_item_trees [index];
 
         // Delete the old array.        
-        delete my_item_trees;
+        delete [] my_item_trees;
 
         // Now hold her hand.
         my_item_trees = copy;
 
+        // The units in stock follow their trees.
+        int *units = new int [size + 1];
+        for (index = 0; index <= size; index++)
+                units [index] = (index < my_size) ? my_units [index] : 0;
+        delete [] my_units;
+        my_units = units;
+
         // Now set our new size.
         my_size = size + 1;
 
@@ -440,3 +806,221 @@ void StoreManager::makeBigger (int size)
         copy = NULL; 
 }
 
+
+//---------------------addStock---------------------------------------
+/**
+ * @brief Adds the provided count to the stock of an Item.
+ *
+ * Preconditions: None.
+ * 
+ * Postconditions: The stock of the Item was raised by count, starting
+ *		   from zero for a new title.
+ *
+ * @param item The Item.
+ * @param count The number of copies to add.
+ */
+void StoreManager::addStock (const Object &item, int count)
+{
+	Stock *stock = my_stock->get (item.getSortKey ());
+
+	my_units [static_cast<const Item &> (item).getType () - 'A'] += count;
+
+	if (stock != NULL) 
+		stock->count += count;
+	else {
+		Stock added;
+		added.count = count;
+		added.title = static_cast<const Item *> (&item);
+		my_stock->add (item.getSortKey (), added);
+	}
+}
+
+
+//---------------------journal----------------------------------------
+/**
+ * @brief Appends a purchase or trade to the journal, if there is one, 
+ *	  as the Transaction made for it is saved. The Transaction is 
+ *	  only borrowed for the record, and gives the Item back.
+ *
+ * Preconditions: The transaction succeeds.
+ * 
+ * Postconditions: The transaction was journaled.
+ *
+ * @param transaction The purchase or trade.
+ */
+void StoreManager::journal (const Command &transaction)
+{
+	if (my_journal == NULL) return;
+
+	if (transaction.getType () == PURCHASE_ID) {
+		PurchaseTransaction record (transaction.getCustomerId (), 
+					    transaction.getType (), 
+					    transaction.getItem ());
+		my_journal->append (record);
+		record.setItem (NULL);
+	}
+	else {
+		TradeTransaction record (transaction.getCustomerId (), 
+					 transaction.getType (), 
+					 transaction.getItem ());
+		my_journal->append (record);
+		record.setItem (NULL);
+	}
+}
+
+
+//---------------------keep-------------------------------------------
+/**
+ * @brief Adds a purchase or trade to a customer's history. The history 
+ *	  refers to the Item listed in the inventory, so the 
+ *	  transaction's own Item is deleted, unless no Item is listed.
+ *
+ * Preconditions: The transaction has an Item.
+ * 
+ * Postconditions: The transaction was added to the history, and its 
+ *		   Item kept or deleted.
+ *
+ * @param customer The customer.
+ * @param transaction The purchase or trade.
+ * @param title The Item listed in the inventory, or NULL.
+ */
+void StoreManager::keep (Customer &customer, Command &transaction, 
+						const Item *title)
+{
+	// An unlisted Item is kept, and freed with the Region.
+	if (title == NULL) title = transaction.getItem ();
+
+	customer.addTransaction (*my_log, transaction.getType (), title);
+	if (title != transaction.getItem ()) transaction.discard ();
+}
+
+
+//---------------------findCustomer-----------------------------------
+/**
+ * @brief Returns the Customer with the provided ID.
+ *
+ * Preconditions: None.
+ * 
+ * Postconditions: The Customer, or NULL if there is none with that ID,
+ *		   was returned.
+ *
+ * @param id The customer ID.
+ * @return The Customer, or NULL.
+ */
+Customer * StoreManager::findCustomer (long long id) const
+{
+	Object **found = my_customer_table->get (id);
+	return (found != NULL) ? static_cast<Customer *> (*found) : NULL;
+}
+
+
+//---------------------loadItems--------------------------------------
+/**
+ * @brief Loads the ITEMS section of a snapshot.
+ *
+ * Preconditions: The snapshot is at the ITEMS section.
+ * 
+ * Postconditions: The trees and the stock were rebuilt, unless input
+ *		   failed.
+ *
+ * @param input The snapshot to read from.
+ * @param items The factory of the Items.
+ */
+void StoreManager::loadItems (SnapshotReader &input, 
+				const ObjectFactory &items)
+{
+	vector<Object *> sorted;
+	vector<int> counts;
+	int trees, titles, index, i, j;
+
+	trees = input.getInt ();
+	for (i = 0; i < trees && !input.failed (); i++) {
+		index  = input.getByte () - 'A';
+		titles = input.getInt ();
+		if (index < 0 || index >= my_size || 
+		    my_item_trees [index] == NULL || titles < 0) {
+			input.fail ();
+			return;
+		}
+
+		sorted.clear ();
+		counts.clear ();
+		for (j = 0; j < titles; j++) {
+			Object *item = items.getNewObject (input);
+			int stock = input.getInt ();
+
+			if (item == NULL || input.failed ()) {
+				delete item;
+				input.fail ();
+				break;
+			}
+			sorted.push_back (item);
+			counts.push_back (1);
+			addStock (*item, stock);
+		}
+		my_item_trees [index]->build (sorted, counts);
+	}
+}
+
+
+//---------------------loadCustomers----------------------------------
+/**
+ * @brief Loads the CUSTOMERS section of a snapshot. Every transaction 
+ *	  of a history is read as a Command, and kept with the Item 
+ *	  listed in the inventory.
+ *
+ * Preconditions: The snapshot is at the CUSTOMERS section, after the 
+ *		  ITEMS section.
+ * 
+ * Postconditions: The Customers read before any failure were added.
+ *
+ * @param input The snapshot to read from.
+ * @param items The factory of the Items.
+ */
+void StoreManager::loadCustomers (SnapshotReader &input, 
+				const ObjectFactory &items)
+{
+	Customer prototype;
+	Customer *cust;
+	Command transaction;
+	int customers, history, i, j;
+
+	customers = input.getInt ();
+	for (i = 0; i < customers && !input.failed (); i++) {
+		cust    = prototype.getNewInstance (input);
+		history = input.getInt ();
+		for (j = 0; j < history && transaction.read (input, items); 
+									j++) {
+			Item *item = transaction.getItem ();
+			if (item == NULL) continue;
+
+			Stock *stock = my_stock->get (item->getSortKey ());
+			keep (*cust, transaction, 
+				(stock != NULL) ? stock->title : NULL);
+		}
+		if (input.failed ()) {
+			delete cust;
+			return;
+		}
+		addCustomer (cust, cust->getId ());
+	}
+}
+
+
+//---------------------lessThan---------------------------------------
+/**
+ * @brief Compares two Items for sorting a bulk load.
+ *
+ * Preconditions: Both Items are of the same type.
+ * 
+ * Postconditions: Returned true if a is less than b.
+ *
+ * @param a The first Item.
+ * @param b The second Item.
+ * @return True if a is less than b, false otherwise.
+ */
+bool StoreManager::lessThan (const Object *a, const Object *b)
+{
+	return a->compareTo (*b) < 0;
+}
+
@@ -19,8 +19,21 @@
  * Includes following features:
  * 	- Allows adding a Customer object.
  *	- Allows adding a Item object to the inventory.
+ *	- Allows bulk loading many Item objects into the inventory.
  * 	- Allows adding a Transaction object.
  *	- Allows processing the Transactions.  
+ *	- Allows saving the inventory and customers to a snapshot,
+ *	  and loading them back.
+ *	- Allows journaling every purchase and trade that changed 
+ *	  the store, and replaying a journal after a restart.
+ *	- Allows emptying the store without visiting its objects,
+ *	  when they are freed with the Region instead.
+ *	- Prints reports and diagnostics to standard output through
+ *	  a ReportWriter, so processing does not wait for writes.
+ *	- Keeps the customers' histories in one TransactionLog, whose
+ *	  entries refer to the Items listed in the inventory.
+ *	- Keeps the units in stock of each inventory tree, so a 
+ *	  category total takes constant time.
  * 
  * Assumptions:
  * 	- The Customers, Transactions, and Items are not NULL when 
@@ -34,16 +47,27 @@
 #include <iostream>
 #include <queue>
 #include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
 #include "customer.h"
 #include "item.h"
 #include "rock.h"
 #include "dvd.h"
 #include "classical.h"
 #include "bstree.h"
+#include "bplus_tree.h"
+#include "ordered_index.h"
 #include "hash_table.h"
 #include "trade_transaction.h"
 #include "purchase_transaction.h"
 #include "processable.h"
+#include "object_factory.h"
+#include "snapshot_file.h"
+#include "journal_file.h"
+#include "command.h"
+#include "report_writer.h"
+#include "transaction_log.h"
 
 const static char BANNER[] = "==============================================================================================";
 /**
@@ -95,23 +119,37 @@ public:
 	 * Postconditions: All dynamic memory has been released. 
  	 */
 	~StoreManager ();
+
+
+	//---------------------clear----------------------------------
+	/**
+	 * @brief Empties the trees without deleting the Items and 
+	 *	  Customers in them, which are freed with the Region.
+	 * 	 
+	 * Preconditions: The Region is about to be reset.
+	 * 
+	 * Postconditions: The store is empty, and deleting it does
+	 *		   not touch the objects it held.
+ 	 */
+	void clear ();
  
 	
 	//---------------------addTransaction-------------------------
 	/**
-	 * @brief Adds the provided Transaction object to the 	
-  	 * 	  queue of pending transactions.
-	 * 
-	 * Preconditions: The queue of pending Transactions has been 
-	 * 		  initialized. 
-	 * 
-	 * Postconditions: The provided Transaction was added to the
-	 *		   pending transaction queue.
-	 * 
+	 * @brief Adds the provided Command to the queue of pending
+  	 * 	  transactions. The queue holds Commands by value.
+	 *
+	 * Preconditions: The queue of pending Transactions has been
+	 * 		  initialized.
+	 *
+	 * Postconditions: The provided Command was added to the
+	 *		   pending transaction queue, which now owns its
+	 *		   Item.
+	 *
 	 * @param transaction The transaction to add to the pending
 	 *	  	      transaction queue.
 	 */
-	void addTransaction (Object *transaction);
+	void addTransaction (const Command &transaction);
 	
 	
 	//---------------------addCustomer----------------------------
@@ -128,23 +166,28 @@ public:
 	 * @param customer The Customer to add.
  	 * @param id The customer Id.
 	 */
-	void addCustomer (Object *customer, int id);
+	void addCustomer (Object *customer, long long id);
 
 
-	//---------------------addItem--------------------------------
+	//---------------------addItems-------------------------------
 	/**
-	 * @brief Adds the provided store inventory Item to the 
-	 *	  tree of store inventory items.
+	 * @brief Bulk loads the provided store inventory Items. The
+	 *	  Items are grouped by type and sorted, equal Items 
+	 *	  are merged by adding their counts, and each 
+	 *	  inventory tree is then built from its sorted Items
+	 *	  in one pass. The trees list each title once, and its
+	 *	  count goes to the stock.
 	 *
-	 * Preconditions: 
+	 * Preconditions: Every Item's type is mapped to a tree.
 	 * 
-	 * Postconditions: The provided Item has been added to the 
-	 *		   collection of inventory items.
+	 * Postconditions: The Items have been added to the 
+	 *		   inventory, and items is empty. Items merged
+	 *		   into an equal Item, or with no count, were
+	 *		   deleted.
  	 *
- 	 * @param type The type of item.
-	 * @param item The Item to add.
+	 * @param items The Items to add.
 	 */
-	void addItem (Object *item, char type);
+	void addItems (vector<Object *> &items);
 
 
 	//---------------------processTransactions--------------------
@@ -163,14 +206,19 @@ public:
 
 	//---------------------purchase-------------------------------
 	/**
-	 * @brief Processese the purchase transaction. 
+	 * @brief Processese the purchase transaction. A 
+	 *	  PurchaseTransaction is made for the customer's 
+	 *	  history only if the purchase succeeds.
 	 *
 	 *	
  	 * Preconditions: The Item exists in the Item tree. 
 	 *
-	 * Postconditions: The purchase has been processed.
+	 * Postconditions: The purchase has been processed, and its
+	 *		   Item kept or deleted.
+	 *
+	 * @param transaction The purchase.
 	 */
-	void purchase ();
+	void purchase (Command &transaction);
 
 
 	//---------------------trade----------------------------------
@@ -181,9 +229,12 @@ public:
  	 *
 	 * Preconditions: The Item exists in the item tree. 
 	 * 
-	 * Postconditions: The trade-in has been processed.
+	 * Postconditions: The trade-in has been processed, and its
+	 *		   Item kept or deleted.
+	 *
+	 * @param transaction The trade.
 	 */
-	void trade ();
+	void trade (Command &transaction);
 
 
 	//---------------------printInventory-------------------------
@@ -198,6 +249,23 @@ public:
 	void printInventory () const;
 
 
+	//---------------------getUnits-------------------------------
+	/**
+	 * @brief Returns the number of copies in stock of all the 
+	 *	  titles of an inventory tree, without visiting the
+	 *	  titles.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The units in stock were returned, or zero
+	 *		   if no tree is mapped to type.
+	 *
+	 * @param type The type of item.
+	 * @return The units in stock.
+	 */
+	int getUnits (char type) const;
+
+
 	//---------------------printHistory---------------------------
 	/**
 	 * @brief Prints the specified customer's transaction history. The 
@@ -209,7 +277,7 @@ public:
  	 *
 	 * @param id The customer ID who's hitory is to be printed.
 	 */ 
-	void printHistory (int id) const;
+	void printHistory (long long id) const;
 
 
 	//---------------------printAllHistory------------------------
@@ -235,7 +303,130 @@ public:
 	 * @param key The key.
 	 * @param tree The tree to map the key to. 
 	 */
-	void mapToTree (char key, BSTree *tree);
+	void mapToTree (char key, OrderedIndex *tree);
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Saves the inventory and the customers to a 
+	 *	  snapshot. The ITEMS section lists every tree: its
+	 *	  key, then each title in order with its stock. The
+	 *	  CUSTOMERS section lists every Customer with its
+	 *	  history. The JOURNAL section holds the journal 
+	 *	  generation.
+	 *
+	 * Preconditions: The snapshot is open, and no section is 
+	 *		  being written. 
+	 * 
+	 * Postconditions: The sections were written. Pending 
+	 *		   transactions are not saved.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	void save (SnapshotWriter &output) const;
+
+
+	//---------------------load-----------------------------------
+	/**
+	 * @brief Loads the inventory and the customers saved by save.
+	 *	  Each tree is built from its titles in one pass, as
+	 *	  they were saved in order.
+	 *
+	 * Preconditions: The snapshot was opened, the store holds no 
+	 *		  Items or Customers, and the trees are mapped as
+	 *		  they were when it was saved. 
+	 * 
+	 * Postconditions: True was returned if the snapshot was 
+	 *		   loaded, false if it did not match the store.
+	 *
+	 * @param input The snapshot to read from.
+	 * @param items The factory of the Items.
+	 * @return True if loaded, false otherwise.
+	 */
+	bool load (SnapshotReader &input, const ObjectFactory &items);
+
+
+	//---------------------setJournal-----------------------------
+	/**
+	 * @brief Sets the journal that every purchase and trade that
+	 *	  changes the store is appended to, before it is 
+	 *	  applied. Failed transactions and reports change 
+	 *	  nothing, so they are not journaled.
+	 *
+	 * Preconditions: The journal is open, or NULL. It outlives 
+	 *		  its use by this StoreManager.
+	 *
+	 * Postconditions: Later transactions are journaled, or not if
+	 *		   journal is NULL.
+	 *
+	 * @param journal The journal, or NULL.
+	 */
+	void setJournal (JournalWriter *journal);
+
+
+	//---------------------flushReport----------------------------
+	/**
+	 * @brief Waits until every report and diagnostic printed was
+	 *	  written to standard output.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if it was all written,
+	 *		   false otherwise.
+	 *
+	 * @return True if written, false otherwise.
+	 */
+	bool flushReport ();
+
+
+	//---------------------getGeneration--------------------------
+	/**
+	 * @brief Returns the generation of the journal whose records
+	 *	  follow the state of this StoreManager. Journals of 
+	 *	  an older generation are already part of the state.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The generation was returned; 0 unless it 
+	 *		   was set or loaded.
+	 *
+	 * @return The journal generation.
+	 */
+	unsigned int getGeneration () const;
+
+
+	//---------------------setGeneration--------------------------
+	/**
+	 * @brief Sets the generation of the journal whose records 
+	 *	  follow the state of this StoreManager.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The generation was set, and is saved with
+	 *		   the snapshot.
+	 *
+	 * @param generation The journal generation.
+	 */
+	void setGeneration (unsigned int generation);
+
+
+	//---------------------replay---------------------------------
+	/**
+	 * @brief Reads one journal record and processes it again.
+	 *
+	 * Preconditions: record reads a journal record, no journal is
+	 *		  set, and the store holds the state the record 
+	 *		  was appended to.
+	 *
+	 * Postconditions: True was returned if the transaction was 
+	 *		   processed, false if the record did not hold 
+	 *		   one.
+	 *
+	 * @param record The record to read from.
+	 * @param items The factory of the Items.
+	 * @return True if replayed, false otherwise.
+	 */
+	bool replay (SnapshotReader &record, const ObjectFactory &items);
 
 
 /**
@@ -247,15 +438,17 @@ private:
 	/**
 	 * @brief Evaluate the transaction by first getting the 
 	 *	  transaction type, and then calling the appropriate 
-	 * 	  method for processing. 
+	 * 	  method for processing. The types are a closed set,
+	 *	  so this is a switch, with no cast or virtual call.
 	 *
-	 * Preconditions: The transaction is not NULL.
+	 * Preconditions: None.
 	 * 
-	 * Postconditions: The transaction has been evaluated.
+	 * Postconditions: The transaction has been evaluated, and its
+	 *		   Item kept or deleted.
 	 * 
 	 * @param transaction The transaction to evaluate.
 	 */
-	void evaluateTransaction (const Transaction *transaction);
+	void evaluateTransaction (Command &transaction);
 
 
 	//---------------------init_trees-----------------------------
@@ -273,15 +466,138 @@ private:
 	/**
 	 * @brief Increase size of tree array.
 	 *
-	 * Preconditions: size is bigger than my_tree_size.
+	 * Preconditions: size is not less than my_size.
 	 * 
 	 * Postconditions: The array was expanded and data copied.
 	 *
- 	 * @param size The size of the new array.
+ 	 * @param size The largest index the new array holds.
 	 */
 	void makeBigger (int size);
 
 
+	//---------------------addStock-------------------------------
+	/**
+	 * @brief Adds the provided count to the stock of an Item.
+	 *
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The stock of the Item was raised by count,
+	 *		   starting from zero for a new title.
+	 *
+	 * @param item The Item.
+	 * @param count The number of copies to add.
+	 */
+	void addStock (const Object &item, int count);
+
+
+	//---------------------journal--------------------------------
+	/**
+	 * @brief Appends a purchase or trade to the journal, if there
+	 *	  is one, as the Transaction made for it is saved.
+	 *
+	 * Preconditions: The transaction succeeds.
+	 * 
+	 * Postconditions: The transaction was journaled.
+	 *
+	 * @param transaction The purchase or trade.
+	 */
+	void journal (const Command &transaction);
+
+
+	//---------------------keep-----------------------------------
+	/**
+	 * @brief Adds a purchase or trade to a customer's history. The
+	 *	  history refers to the Item listed in the inventory,
+	 *	  so the transaction's own Item is deleted, unless no 
+	 *	  Item is listed.
+	 *
+	 * Preconditions: The transaction has an Item.
+	 * 
+	 * Postconditions: The transaction was added to the history, 
+	 *		   and its Item kept or deleted.
+	 *
+	 * @param customer The customer.
+	 * @param transaction The purchase or trade.
+	 * @param title The Item listed in the inventory, or NULL.
+	 */
+	void keep (Customer &customer, Command &transaction, 
+						const Item *title);
+
+
+	//---------------------findCustomer---------------------------
+	/**
+	 * @brief Returns the Customer with the provided ID.
+	 *
+	 * Preconditions: None.
+	 * 
+	 * Postconditions: The Customer, or NULL if there is none with
+	 *		   that ID, was returned.
+	 *
+	 * @param id The customer ID.
+	 * @return The Customer, or NULL.
+	 */
+	Customer * findCustomer (long long id) const;
+
+
+	//---------------------lessThan-------------------------------
+	/**
+	 * @brief Compares two Items for sorting a bulk load.
+	 *
+	 * Preconditions: Both Items are of the same type.
+	 * 
+	 * Postconditions: Returned true if a is less than b.
+	 *
+ 	 * @param a The first Item.
+ 	 * @param b The second Item.
+	 * @return True if a is less than b, false otherwise.
+	 */
+	static bool lessThan (const Object *a, const Object *b);
+
+
+	//---------------------loadItems------------------------------
+	/**
+	 * @brief Loads the ITEMS section of a snapshot.
+	 *
+	 * Preconditions: The snapshot is at the ITEMS section.
+	 * 
+	 * Postconditions: The trees and the stock were rebuilt, unless
+	 *		   input failed.
+	 *
+	 * @param input The snapshot to read from.
+	 * @param items The factory of the Items.
+	 */
+	void loadItems (SnapshotReader &input, const ObjectFactory &items);
+
+
+	//---------------------loadCustomers--------------------------
+	/**
+	 * @brief Loads the CUSTOMERS section of a snapshot. Every 
+	 *	  transaction of a history is read as a Command, and 
+	 *	  kept with the Item listed in the inventory.
+	 *
+	 * Preconditions: The snapshot is at the CUSTOMERS section, 
+	 *		  after the ITEMS section.
+	 * 
+	 * Postconditions: The Customers read before any failure were 
+	 *		   added.
+	 *
+	 * @param input The snapshot to read from.
+	 * @param items The factory of the Items.
+	 */
+	void loadCustomers (SnapshotReader &input, 
+				const ObjectFactory &items);
+
+
+	/**
+	 * @brief The stock of a title, and its Item listed in the
+	 *	  inventory, which the histories refer to.
+	 */
+	struct Stock {
+		int count;
+		const Item *title;
+	};
+
+
 	/**
 	 * @brief The customers.
 	 */	
@@ -290,28 +606,68 @@ private:
 	/**
 	 * @brief The store pending transactions.
 	 */
-	queue <Object *> *my_transactions;
+	queue <Command> *my_transactions;
 	
 	/**
-	 * @brief The customer fast access array.
+	 * @brief The customers by ID, for fast access. Grows
+	 *	  incrementally, so adding a customer never stalls.
 	 */
-	Object **my_customer_table;
+	HashTable<long long, Object *> *my_customer_table;
 
 	/**
-	 * @brief Array of the inventory trees. 
+	 * @brief Array of the inventory trees. Each title is held
+	 *	  once with an occurrence count of 1; its stock is in 
+	 *	  my_stock, not in the tree.
 	 */
-	BSTree **my_item_trees;	
+	OrderedIndex **my_item_trees;	
 
 	/**
-	 * @brief The size of the trees array.
+	 * @brief The units in stock of each inventory tree, kept with
+	 *	  the stock, so a category total is not a scan.
 	 */
-	int my_size;
-	
+	int *my_units;
+
+	/**
+	 * @brief The stock of every title, keyed by the sort key of 
+	 *	  its Item. Purchases and trades of a known title only
+	 *	  change this count. The trees only list the titles, in
+	 *	  order.
+	 */
+	HashTable<string, Stock> *my_stock;
+
+	/**
+	 * @brief The customers' purchases and trades, in order.
+	 */
+	TransactionLog *my_log;
+
 	/**
- 	 * @brief THe default number of customers.
+	 * @brief The journal of the transactions, or NULL. Not owned.
 	 */
-	const static int DEFAULT_N_CUSTOMERS = 1000; 
+	JournalWriter *my_journal;
 
+	/**
+	 * @brief The generation of the journal whose records follow
+	 *	  the state of the store.
+	 */
+	unsigned int my_generation;
+
+	/**
+	 * @brief Writes what is printed to my_report to standard 
+	 *	  output, in the background.
+	 */
+	ReportWriter *my_writer;
+
+	/**
+	 * @brief The stream the reports and diagnostics are printed 
+	 *	  to.
+	 */
+	ostream *my_report;
+
+	/**
+	 * @brief The size of the trees array.
+	 */
+	int my_size;
+	
 	/**
  	 * @brief THe default number of Items.
 	 */
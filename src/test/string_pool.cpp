@@ -0,0 +1,151 @@
+/**
+ * @file string_pool.cpp
+ *
+ * @brief The StringPool keeps one copy of every distinct string put
+ *	  in it, such as artist names, titles and sort keys, for the
+ *	  life of the program. An InternedString is a handle to a
+ *	  pooled string: a single pointer, copied for free, and two
+ *	  handles are equal exactly when they point to the same
+ *	  string.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows interning a string, or the bytes of a Field without
+ *	  first copying them into a string.
+ *	- Allows comparing handles for equality by address.
+ *	- Allows interning from several threads at once. The pool is
+ *	  split into shards, each with its own lock.
+ *
+ * Assumptions:
+ *	- Pooled strings are never freed, so the pool grows with the
+ *	  number of distinct strings, not with the number of uses.
+ */
+//--------------------------------------------------------------------
+
+#include "string_pool.h"
+
+StringPool::Shard * StringPool::my_shards = NULL;
+pthread_once_t StringPool::my_once = PTHREAD_ONCE_INIT;
+
+//---------------------intern-----------------------------------------
+/**
+ * @brief Returns the pooled copy of the provided bytes, adding it on
+ *	  first use. The high bits of the hash pick the shard, leaving
+ *	  the low bits to the shard's table.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The pooled string equal to text was returned.
+ *
+ * @param text The bytes to intern.
+ * @return The pooled string.
+ */
+const string * StringPool::intern (const Field &text)
+{
+	Shard *shard;
+	const string *pooled;
+	const string * const *found;
+	Field key;
+
+	if (text.length == 0) return empty ();
+	shard = &shards () [HashCode<Field> () (text) >> 60 & (SHARDS - 1)];
+
+	pthread_mutex_lock (&shard->lock);
+	found = shard->strings->get (text);
+	if (found != NULL)
+		pooled = *found;
+	else {
+		// The key points into the pooled copy, which never moves.
+		pooled     = new string (text.data, text.length);
+		key.data   = pooled->data ();
+		key.length = text.length;
+		shard->strings->add (key, pooled);
+	}
+	pthread_mutex_unlock (&shard->lock);
+	return pooled;
+}
+
+
+//---------------------intern-----------------------------------------
+/**
+ * @brief Returns the pooled copy of the provided string, adding it on
+ *	  first use.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The pooled string equal to text was returned.
+ *
+ * @param text The string to intern.
+ * @return The pooled string.
+ */
+const string * StringPool::intern (const string &text)
+{
+	Field field;
+
+	field.data   = text.data ();
+	field.length = (int)text.size ();
+	return intern (field);
+}
+
+
+//---------------------empty------------------------------------------
+/**
+ * @brief Returns the pooled empty string, without a lookup. It is a
+ *	  local static so that handles made before main can use it.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The pooled empty string was returned.
+ *
+ * @return The pooled empty string.
+ */
+const string * StringPool::empty ()
+{
+	static const string nothing;
+	return &nothing;
+}
+
+
+//---------------------shards-----------------------------------------
+/**
+ * @brief Returns the shards, creating them on first use.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The SHARDS shards were returned.
+ *
+ * @return The shards.
+ */
+StringPool::Shard * StringPool::shards ()
+{
+	pthread_once (&my_once, create);
+	return my_shards;
+}
+
+
+//---------------------create-----------------------------------------
+/**
+ * @brief Creates the shards. Run once, by shards. Their tables grow
+ *	  incrementally, so no intern stalls on a resize.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The shards were created.
+ */
+void StringPool::create ()
+{
+	my_shards = new Shard [SHARDS];
+	for (int i = 0; i < SHARDS; i++) {
+		pthread_mutex_init (&my_shards [i].lock, NULL);
+		my_shards [i].strings =
+			new HashTable<Field, const string *> (true);
+	}
+}
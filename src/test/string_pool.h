@@ -0,0 +1,325 @@
+/**
+ * @file string_pool.h
+ *
+ * @brief The StringPool keeps one copy of every distinct string put
+ *	  in it, such as artist names, titles and sort keys, for the
+ *	  life of the program. An InternedString is a handle to a
+ *	  pooled string: a single pointer, copied for free, and two
+ *	  handles are equal exactly when they point to the same
+ *	  string.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows interning a string, or the bytes of a Field without
+ *	  first copying them into a string.
+ *	- Allows comparing handles for equality by address.
+ *	- Allows interning from several threads at once. The pool is
+ *	  split into shards, each with its own lock.
+ *
+ * Assumptions:
+ *	- Pooled strings are never freed, so the pool grows with the
+ *	  number of distinct strings, not with the number of uses.
+ */
+//--------------------------------------------------------------------
+
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <string>
+#include <pthread.h>
+#include "field_reader.h"
+#include "hash_table.h"
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class HashCode<Field>
+ *
+ * @brief Hashes the bytes of a Field like HashCode<string> does, so
+ *	  Fields can key a HashTable.
+ */
+template <>
+struct HashCode<Field> {
+
+	//---------------------operator()-----------------------------
+	/**
+	 * @brief Returns the hash code for the provided key.
+	 *
+	 * Preonditions: None.
+	 *
+	 * Postconditions: A hash code was returned.
+	 *
+	 * @param key The key to hash.
+	 * @return The hash code for the key.
+	 */
+	unsigned long long operator() (const Field &key) const
+	{
+		unsigned long long hash = 14695981039346656037ULL;
+
+		for (int i = 0; i < key.length; i++) {
+			hash ^= (unsigned char)key.data [i];
+			hash *= 1099511628211ULL;
+		}
+		return HashCode<unsigned long long>::mix (hash);
+	}
+};
+
+
+/**
+ * @class StringPool
+ */
+class StringPool {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------intern---------------------------------
+	/**
+	 * @brief Returns the pooled copy of the provided bytes, adding
+	 *	  it on first use.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The pooled string equal to text was returned.
+	 *
+	 * @param text The bytes to intern.
+	 * @return The pooled string.
+	 */
+	static const string * intern (const Field &text);
+
+
+	//---------------------intern---------------------------------
+	/**
+	 * @brief Returns the pooled copy of the provided string,
+	 *	  adding it on first use.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The pooled string equal to text was returned.
+	 *
+	 * @param text The string to intern.
+	 * @return The pooled string.
+	 */
+	static const string * intern (const string &text);
+
+
+	//---------------------empty----------------------------------
+	/**
+	 * @brief Returns the pooled empty string, without a lookup.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The pooled empty string was returned.
+	 *
+	 * @return The pooled empty string.
+	 */
+	static const string * empty ();
+
+/**
+ * @private
+ */
+private:
+
+	/**
+	 * @brief A part of the pool. Its table maps the bytes of each
+	 *	  of its strings, which the key points into, to the
+	 *	  string.
+	 */
+	struct Shard {
+		pthread_mutex_t lock;
+		HashTable<Field, const string *> *strings;
+	};
+
+
+	//---------------------shards---------------------------------
+	/**
+	 * @brief Returns the shards, creating them on first use.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The SHARDS shards were returned.
+	 *
+	 * @return The shards.
+	 */
+	static Shard * shards ();
+
+
+	//---------------------create---------------------------------
+	/**
+	 * @brief Creates the shards. Run once, by shards.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The shards were created.
+	 */
+	static void create ();
+
+	/**
+	 * @brief The number of shards; a power of two.
+	 */
+	static const int SHARDS = 16;
+
+	/**
+	 * @brief The shards, once created.
+	 */
+	static Shard *my_shards;
+
+	/**
+	 * @brief Makes sure the shards are created once.
+	 */
+	static pthread_once_t my_once;
+};
+
+
+/**
+ * @class InternedString
+ *
+ * @brief A handle to a string in the StringPool. Strings and Fields
+ *	  convert to handles implicitly, so a constructor taking a
+ *	  handle accepts either.
+ */
+class InternedString {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a handle to the empty string.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This handle is empty.
+	 */
+	InternedString ()
+	{
+		my_text = StringPool::empty ();
+	}
+
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a handle to the pooled copy of text.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This handle refers to a string equal to text.
+	 *
+	 * @param text The string.
+	 */
+	InternedString (const string &text)
+	{
+		my_text = StringPool::intern (text);
+	}
+
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates a handle to the pooled copy of the bytes of
+	 *	  text. No string is made if they are already pooled.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This handle refers to a string equal to text.
+	 *
+	 * @param text The bytes.
+	 */
+	InternedString (const Field &text)
+	{
+		my_text = StringPool::intern (text);
+	}
+
+
+	//---------------------toString-------------------------------
+	/**
+	 * @brief Returns the pooled string.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The string was returned. It lives as long as
+	 *		   the program.
+	 *
+	 * @return The string.
+	 */
+	const string & toString () const
+	{
+		return *my_text;
+	}
+
+
+	//---------------------empty----------------------------------
+	/**
+	 * @brief Returns whether the string is empty.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if it is empty.
+	 *
+	 * @return True if empty, false otherwise.
+	 */
+	bool empty () const
+	{
+		return my_text->empty ();
+	}
+
+
+	//---------------------operator==-----------------------------
+	/**
+	 * @brief Compares two handles. Only one copy of each string is
+	 *	  pooled, so comparing addresses compares the strings.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the strings are equal.
+	 *
+	 * @param the_other The other handle.
+	 * @return True if equal, false otherwise.
+	 */
+	bool operator== (const InternedString &the_other) const
+	{
+		return my_text == the_other.my_text;
+	}
+
+
+	//---------------------operator!=-----------------------------
+	/**
+	 * @brief Compares two handles for inequality.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: True was returned if the strings differ.
+	 *
+	 * @param the_other The other handle.
+	 * @return True if not equal, false otherwise.
+	 */
+	bool operator!= (const InternedString &the_other) const
+	{
+		return my_text != the_other.my_text;
+	}
+
+/**
+ * @private
+ */
+private:
+
+	/**
+	 * @brief The pooled string.
+	 */
+	const string *my_text;
+};
+#endif /* STRING_POOL_H */
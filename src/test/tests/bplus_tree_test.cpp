@@ -0,0 +1,264 @@
+/**
+ * @file bplus_tree_test.cpp
+ *
+ * @brief This is the test of the subtree counts of the BPlusTree. It
+ *	  fills trees with Rock Items, by bulk loading and by random
+ *	  inserts and removes, and checks getSize, getTotal, rank,
+ *	  select, count and countOccurrences against a scan of a
+ *	  std::map holding the same titles.
+ *
+ *	  usage: bplus_tree_test [seed]
+ *
+ *	  Built from src/test, with every source but main.cpp:
+ *
+ *	  g++ -O2 -o bplus_tree_test tests/bplus_tree_test.cpp
+ *	      $(ls *.cpp | grep -v main.cpp) -pthread
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ *	- Tests a bulk loaded tree, a tree grown by inserts, and a
+ *	  bulk loaded tree that is then changed.
+ *	- Tests ranges with absent ends, empty ranges and ranges whose
+ *	  ends are reversed.
+ *	- Prints each failed check, and exits with 1 if any failed.
+ * Assumptions:
+ *	- It is built with the sources of the store, but not with its
+ *	  main.cpp.
+ *	- Rock sort keys of the same artist and year order the titles
+ *	  as their strings, which are zero padded.
+ */
+//--------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include "../bplus_tree.h"
+#include "../rock.h"
+
+/**
+ * @brief The titles a test draws from.
+ */
+const int TITLES = 20000;
+
+/**
+ * @brief The inserts and removes of a random test.
+ */
+const int STEPS = 60000;
+
+/**
+ * @brief The random probes made at each check.
+ */
+const int PROBES = 2000;
+
+/**
+ * @brief The number of checks that failed.
+ */
+static int failures = 0;
+
+
+//---------------------newRock----------------------------------------
+/**
+ * @brief Returns a new Rock with the provided title number.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: A pointer to the new Rock was returned.
+ *
+ * @param title The title number.
+ * @return The new Rock.
+ */
+static Rock * newRock (int title)
+{
+	char text [16];
+	sprintf (text, "%06d", title);
+	return new Rock ('Z', string ("Artist"), string (text), 1990, 1);
+}
+
+
+//---------------------expect-----------------------------------------
+/**
+ * @brief Counts and prints a failed check.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: failures was raised if the values differ.
+ *
+ * @param what The name of the check.
+ * @param got The value the tree gave.
+ * @param want The value the scan gave.
+ */
+static void expect (const char *what, long got, long want)
+{
+	if (got == want) return;
+	cerr << "FAIL " << what << ": got " << got << ", want " << want
+	     << endl;
+	failures++;
+}
+
+
+//---------------------check------------------------------------------
+/**
+ * @brief Checks the counts of the tree against the titles it should
+ *	  hold, at every index and at random probes.
+ *
+ * Preconditions: counts holds each stored title with its count.
+ *
+ * Postconditions: Each failed check was counted.
+ *
+ * @param tree The tree.
+ * @param counts The titles with their occurrence counts.
+ */
+static void check (const BPlusTree &tree, const map<int, int> &counts)
+{
+	map<int, int>::const_iterator it;
+	vector<int> titles;
+	int index, low, high, items, total;
+
+	for (it = counts.begin (); it != counts.end (); ++it)
+		titles.push_back (it->first);
+
+	total = 0;
+	for (it = counts.begin (); it != counts.end (); ++it)
+		total += it->second;
+	expect ("getSize", tree.getSize (), counts.size ());
+	expect ("getTotal", tree.getTotal (), total);
+
+	// select and rank are inverses at every stored title.
+	for (index = 0; index < (int)titles.size (); index++) {
+		const Object *item = tree.select (index);
+		Rock *rock = newRock (titles [index]);
+		expect ("select", item != NULL && item->sameKey (*rock), 1);
+		expect ("rank", tree.rank (*rock), index);
+		delete rock;
+	}
+	expect ("select past end", tree.select (titles.size ()) == NULL, 1);
+	expect ("select negative", tree.select (-1) == NULL, 1);
+
+	for (index = 0; index < PROBES; index++) {
+		low  = rand () % (TITLES + 2) - 1;
+		high = rand () % (TITLES + 2) - 1;
+		Rock *low_rock  = newRock (low);
+		Rock *high_rock = newRock (high);
+
+		items = 0;
+		for (it = counts.begin (); it != counts.end () &&
+						it->first < low; ++it)
+			items++;
+		expect ("rank probe", tree.rank (*low_rock), items);
+
+		items = 0;
+		total = 0;
+		for (it = counts.lower_bound (low); it != counts.end () &&
+						it->first <= high; ++it) {
+			items++;
+			total += it->second;
+		}
+		expect ("count", tree.count (*low_rock, *high_rock), items);
+		expect ("countOccurrences",
+			tree.countOccurrences (*low_rock, *high_rock), total);
+
+		delete low_rock;
+		delete high_rock;
+	}
+}
+
+
+//---------------------change-----------------------------------------
+/**
+ * @brief Makes random inserts and removes on the tree and on the
+ *	  titles it should hold.
+ *
+ * Preconditions: counts holds each stored title with its count.
+ *
+ * Postconditions: The tree and counts were changed alike.
+ *
+ * @param tree The tree.
+ * @param counts The titles with their occurrence counts.
+ */
+static void change (BPlusTree &tree, map<int, int> &counts)
+{
+	int step, title;
+	bool removed, stored;
+
+	for (step = 0; step < STEPS; step++) {
+		title = rand () % TITLES;
+		Rock *rock = newRock (title);
+
+		if (rand () % 3 != 0) {
+			// The tree keeps the Rock only if the title is new.
+			stored = counts.count (title) != 0;
+			tree.insert (rock);
+			counts [title]++;
+			if (stored) delete rock;
+			continue;
+		}
+
+		stored  = counts.count (title) != 0 && counts [title] > 0;
+		removed = tree.remove (*rock);
+		expect ("remove", removed, stored);
+		if (stored) counts [title]--;
+		delete rock;
+	}
+}
+
+
+/**
+ * @brief Runs the tests.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @return Zero if every check passed.
+ */
+int main (int argc, char *argv [])
+{
+	map<int, int> counts;
+	vector<Object *> items;
+	vector<int> occurrences;
+	int title;
+
+	srand (argc > 1 ? atoi (argv [1]) : 343);
+
+	// An empty tree counts nothing.
+	BPlusTree empty;
+	check (empty, counts);
+
+	// A tree grown one insert at a time.
+	BPlusTree grown;
+	change (grown, counts);
+	check (grown, counts);
+
+	// A bulk loaded tree, then changed.
+	counts.clear ();
+	for (title = 0; title < TITLES; title += 1 + rand () % 3) {
+		counts [title] = 1 + rand () % 5;
+		items.push_back (newRock (title));
+		occurrences.push_back (counts [title]);
+	}
+	BPlusTree built;
+	built.build (items, occurrences);
+	check (built, counts);
+	change (built, counts);
+	check (built, counts);
+
+	// A copy keeps the counts.
+	BPlusTree copy (built);
+	check (copy, counts);
+
+	if (failures > 0) {
+		cerr << failures << " checks failed" << endl;
+		return 1;
+	}
+	cout << "All checks passed" << endl;
+	return 0;
+}
@@ -27,7 +27,6 @@
 //--------------------------------------------------------------------
 
 #include "trade_transaction.h"
-#include "store_manager.h"
 
 //---------------------Default-Constructor----------------------------
 /**
@@ -56,7 +55,7 @@ TradeTransaction::TradeTransaction () : Processable () {}
  * @param item The item associated with the transacion.
  * @param type The type of transaction. 
  */
-TradeTransaction::TradeTransaction (int cust_id, char type, 
+TradeTransaction::TradeTransaction (long long cust_id, char type, 
 		Item *item) : Processable (cust_id, type, item) {}
 
 
@@ -74,25 +73,50 @@ TradeTransaction::~TradeTransaction () {}
 //---------------------getNewInstance---------------------------------
 /**
  * @brief Retuns a pointer to a new TradeTransaction. The data of the
- * 	  new object will be set using the provided file stream.
+ * 	  new object will be set using the provided line.
  *	
- * Preconditions: The file stream is open and correctly formatted 
+ * Preconditions: The line is correctly formatted 
  *	 	  according to Lab 4 specs.  	
  *
  * Postconditions: A new object was created using the provided file to
  *		   set its data. A pointer to the object was then
  *		   returned.
  *
- * @param input The input stream to extract from.
+ * @param input The line to read the fields from.
  * @return A pointer to the new instance.
  */
 TradeTransaction * TradeTransaction::getNewInstance 
-				(ifstream &input) const
+				(FieldReader &input) const
 {
 	char type;
-	int id;
-	input >> type; input.ignore ();
-	input >> id; input.ignore (); input.ignore();
+	long long id;
+	type = input.readChar (); input.skip (1);
+	input.readLong (id); input.skip (2);
+	return new TradeTransaction (id, type, NULL);
+}
+
+
+//---------------------getNewInstance---------------------------------
+/**
+ * @brief Retuns a pointer to a new TradeTransaction, read from a snapshot 
+ *	  written by save.
+ *	  The Item saved with it is left in the snapshot, for the 
+ *	  caller to read with the Item factory.
+ *	
+ * Preconditions: The snapshot is at a TradeTransaction saved by save.
+ *
+ * Postconditions: A new TradeTransaction was created using the snapshot, and a
+ *		   pointer to it is returned.
+ *
+ * @param input The snapshot to read from.
+ * @return A pointer to the new instance.
+ */
+TradeTransaction * TradeTransaction::getNewInstance (SnapshotReader &input) const
+{
+	char type;
+	long long id;
+	type = input.getByte ();
+	id   = input.getLong ();
 	return new TradeTransaction (id, type, NULL);
 }
 
@@ -131,20 +155,3 @@ TradeTransaction * TradeTransaction::clone () const
 				     getType(), 
 				     getItem()->clone());
 }
-
-
-//---------------------execute----------------------------------------
-/**
- * @brief Calls the appropriate method on the store manager.
- * 
- * Preconditions: The storemanager is not NULL.
- *
- * Postconditions: The storemanager's method has been called.
- *
- * @param mgr The store manager.
- */
-void TradeTransaction::execute (StoreManager *mgr) const
-{
-	mgr->trade ();
-}
-
@@ -69,7 +69,7 @@ public:
 	 * @param item The item associated with the transacion.
 	 * @param type The type of transaction. 
 	 */
-	TradeTransaction (int cust_id, char type, Item *item);
+	TradeTransaction (long long cust_id, char type, Item *item);
 
 
 	//---------------------Destructor-----------------------------
@@ -102,20 +102,38 @@ public:
 	/**
 	 * @brief Retuns a pointer to a new TradeTransaction. 
  	 *	  The data of the new object will be set using the 
- 	 *	  provided file stream.
+ 	 *	  provided line.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *		  formatted according to Lab 4 specs.  	
 	 *
 	 * Postconditions: A new object was created using the provided
 	 *		   file to set its data. A pointer to the 
 	 *		   object was then returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return A pointer to the new instance.
 	 */
 	virtual TradeTransaction * getNewInstance 
-					(ifstream &input) const;
+					(FieldReader &input) const;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new TradeTransaction, read from a 
+	 *	  snapshot written by save.
+	 *	  The Item saved with it is left in the snapshot, 
+	 *	  for the caller to read with the Item factory.
+	 *	
+ 	 * Preconditions: The snapshot is at a TradeTransaction saved by save.
+	 *
+	 * Postconditions: A new TradeTransaction was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual TradeTransaction * getNewInstance (SnapshotReader &input) const;
 
 
 	//---------------------clone----------------------------------
@@ -131,17 +149,6 @@ public:
 	virtual TradeTransaction * clone () const; 
 
 
-	//---------------------execute--------------------------------
-	/**
-	 * @brief Calls the appropriate method on the store manager.
-	 * 
-	 * Preconditions: The storemanager is not NULL.
-	 *
-	 * Postconditions: The storemanager's method has been called.
-	 *
-	 * @param mgr The store manager.
-	 */
-	virtual void execute (StoreManager *mgr) const;
 
 };
 #endif /* TRADE_TRANSACTION_H */
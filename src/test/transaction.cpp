@@ -131,6 +131,23 @@ void Transaction::print (ostream &output) const
 	output << my_type;
 }
 
+
+//---------------------save-------------------------------------------
+/**
+ * @brief Writes this Transaction to a snapshot: its type. Derived types 
+ *	  add their own fields.
+ *	
+ * Preconditions: A section of the snapshot is being written.
+ *
+ * Postconditions: This Transaction was written.
+ *
+ * @param output The snapshot to write to.
+ */
+void Transaction::save (SnapshotWriter &output) const
+{
+	output.putByte (my_type);
+}
+
 //---------------------operator==-------------------------------------
 /**
  * @brief Compares this Object with the_other Object. 
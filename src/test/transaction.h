@@ -35,7 +35,6 @@
 #include <climits>
 #include "object.h" 
 
-class StoreManager;
 /** 
  * @class Transaction
  */
@@ -101,9 +100,9 @@ public:
 	/**
 	 * @brief Retuns a pointer to a new instance of a Transaction.
  	 *	  The data of the new object will be set using the  
- 	 *	  provided file stream.
+ 	 *	  provided line.
 	 *	
- 	 * Preconditions: The file stream is open and correctly 
+ 	 * Preconditions: The line is correctly
 	 *		  formatted according to Lab 4 specs.  	
 	 *
 	 * Postconditions: A new object of the derived type was 
@@ -111,12 +110,42 @@ public:
 	 *		   its data. A pointer to the object was then
 	 *		   returned.
 	 *
-	 * @param input The input stream to extract from.
+	 * @param input The line to read the fields from.
 	 * @return A pointer to a  new instance of the derived
 	 *	   Transaction.
 	 */
 	virtual Transaction * getNewInstance 
-					(ifstream &input) const = 0;
+					(FieldReader &input) const = 0;
+
+
+	//---------------------getNewInstance-------------------------
+	/**
+	 * @brief Retuns a pointer to a new Transaction, read from a 
+	 *	  snapshot written by save.
+	 *	
+ 	 * Preconditions: The snapshot is at a Transaction saved by save.
+	 *
+	 * Postconditions: A new Transaction was created using the snapshot,
+	 *		   and a pointer to it is returned.
+	 *
+	 * @param input The snapshot to read from.
+	 * @return A pointer to the new instance.
+	 */
+	virtual Transaction * getNewInstance (SnapshotReader &input) const = 0;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes this Transaction to a snapshot: its 
+	 *	  type. Derived types add their own fields.
+	 *	
+ 	 * Preconditions: A section of the snapshot is being written.
+	 *
+	 * Postconditions: This Transaction was written.
+	 *
+	 * @param output The snapshot to write to.
+	 */
+	virtual void save (SnapshotWriter &output) const;
 
 
 	//---------------------clone----------------------------------
@@ -132,19 +161,6 @@ public:
 	virtual Transaction * clone () const = 0;
 
 
-	//---------------------execute--------------------------------
-	/**
-	 * @brief Calls the appropriate method on the store manager.
-	 * 
-	 * Preconditions: The storemanager is not NULL.
-	 *
-	 * Postconditions: The storemanager's method has been called.
-	 *
-	 * @param mgr The store manager.
-	 */
-	virtual void execute (StoreManager *mgr) const = 0;
-
-
 	//---------------------operator<------------------------------
 	/**
 	 * @brief Compares this Object with the_other for less than 
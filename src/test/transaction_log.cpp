@@ -0,0 +1,248 @@
+/**
+ * @file transaction_log.cpp
+ *
+ * @brief The TransactionLog holds the purchases and trades of every
+ *	  customer, in the order they were made. Each is a small fixed
+ *	  size entry: the customer ID, the type, the Item listed in the
+ *	  inventory, and the number of the customer's next entry. A
+ *	  Customer only keeps the numbers of its first and last entry,
+ *	  so its history is a chain through the log.
+ *
+ * @brief The entries are kept in large blocks, so appending never
+ *	  moves an entry, and the entries made one after another sit
+ *	  together.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows appending an entry, and linking it to the entry
+ *	  before it in the same customer's history.
+ *	- Allows walking a history, and printing or saving each entry
+ *	  as a PurchaseTransaction or TradeTransaction would.
+ *	- Allows emptying the log.
+ *
+ * Assumptions:
+ *	- The number of an entry is its sequence number in the log.
+ *	- The Items outlive the log. They are not deleted by it.
+ *	- One thread appends, and no other thread reads meanwhile.
+ */
+//--------------------------------------------------------------------
+
+#include "transaction_log.h"
+
+//---------------------Constructor------------------------------------
+/**
+ * @brief Creates an empty TransactionLog.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: This TransactionLog was created empty.
+ */
+TransactionLog::TransactionLog ()
+{
+	my_size = 0;
+}
+
+
+//---------------------Destructor-------------------------------------
+/**
+ * @brief Frees the blocks of entries. The Items are not deleted.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The blocks were freed.
+ */
+TransactionLog::~TransactionLog ()
+{
+	clear ();
+}
+
+
+//---------------------append-----------------------------------------
+/**
+ * @brief Appends an entry, and links the previous entry of the same 
+ *	  customer to it. A new block is started when the last is full.
+ *
+ * Preconditions: item is not NULL. previous is -1, or the last entry of
+ *		  the customer's history.
+ *
+ * Postconditions: The entry was appended at the end of the log and of 
+ *		   the customer's history, and its number was returned.
+ *
+ * @param cust_id The customer ID.
+ * @param type The type of transaction.
+ * @param item The Item listed in the inventory.
+ * @param previous The customer's last entry, or -1.
+ * @return The number of the new entry.
+ */
+int TransactionLog::append (long long cust_id, char type, const Item *item,
+								int previous)
+{
+	if ((my_size & (BLOCK_SIZE - 1)) == 0) 
+		my_blocks.push_back (new Entry [BLOCK_SIZE]);
+
+	Entry &entry = at (my_size);
+	entry.item    = item;
+	entry.cust_id = cust_id;
+	entry.next    = -1;
+	entry.type    = type;
+
+	if (previous >= 0) at (previous).next = my_size;
+	return my_size++;
+}
+
+
+//---------------------getNext----------------------------------------
+/**
+ * @brief Returns the entry that follows the provided one in its 
+ *	  customer's history.
+ *
+ * Preconditions: entry is in the log.
+ *
+ * Postconditions: The next entry, or -1 if it is the last, was returned.
+ *
+ * @param entry The entry.
+ * @return The next entry, or -1.
+ */
+int TransactionLog::getNext (int entry) const
+{
+	return at (entry).next;
+}
+
+
+//---------------------getType----------------------------------------
+/**
+ * @brief Returns the type of transaction of an entry.
+ *
+ * Preconditions: entry is in the log.
+ *
+ * Postconditions: The type was returned.
+ *
+ * @param entry The entry.
+ * @return The type.
+ */
+char TransactionLog::getType (int entry) const
+{
+	return at (entry).type;
+}
+
+
+//---------------------getItem----------------------------------------
+/**
+ * @brief Returns the Item of an entry.
+ *
+ * Preconditions: entry is in the log.
+ *
+ * Postconditions: The Item was returned.
+ *
+ * @param entry The entry.
+ * @return The Item.
+ */
+const Item * TransactionLog::getItem (int entry) const
+{
+	return at (entry).item;
+}
+
+
+//---------------------print------------------------------------------
+/**
+ * @brief Prints an entry as its PurchaseTransaction or TradeTransaction
+ *	  would.
+ *
+ * Preconditions: entry is in the log.
+ *
+ * Postconditions: The entry was sent to the output stream.
+ *
+ * @param entry The entry.
+ * @param output The output stream.
+ */
+void TransactionLog::print (int entry, ostream &output) const
+{
+	const Entry &found = at (entry);
+
+	if (found.type == PURCHASE_ID)
+		output << "Purchase - ";
+	else
+		output << "Trade    - ";
+	output << *found.item;
+}
+
+
+//---------------------save-------------------------------------------
+/**
+ * @brief Writes an entry to a snapshot as its PurchaseTransaction or 
+ *	  TradeTransaction would: the type, customer ID and Item.
+ *
+ * Preconditions: entry is in the log, and a section of the snapshot is
+ *		  being written.
+ *
+ * Postconditions: The entry was written.
+ *
+ * @param entry The entry.
+ * @param output The snapshot to write to.
+ */
+void TransactionLog::save (int entry, SnapshotWriter &output) const
+{
+	const Entry &found = at (entry);
+
+	output.putByte (found.type);
+	output.putLong (found.cust_id);
+	found.item->save (output);
+}
+
+
+//---------------------getSize----------------------------------------
+/**
+ * @brief Returns the number of entries in the log.
+ *
+ * Preconditions: None.
+ *
+ * Postconditions: The number of entries was returned.
+ *
+ * @return The number of entries.
+ */
+int TransactionLog::getSize () const
+{
+	return my_size;
+}
+
+
+//---------------------clear------------------------------------------
+/**
+ * @brief Removes every entry, and frees the blocks.
+ *
+ * Preconditions: No Customer refers to the entries.
+ *
+ * Postconditions: The log is empty.
+ */
+void TransactionLog::clear ()
+{
+	for (int i = 0; i < (int)my_blocks.size (); i++)
+		delete [] my_blocks [i];
+	my_blocks.clear ();
+	my_size = 0;
+}
+
+
+//---------------------at---------------------------------------------
+/**
+ * @brief Returns an entry by its number.
+ *
+ * Preconditions: entry is in the log.
+ *
+ * Postconditions: The entry was returned.
+ *
+ * @param entry The number of the entry.
+ * @return The entry.
+ */
+TransactionLog::Entry & TransactionLog::at (int entry) const
+{
+	return my_blocks [entry >> BLOCK_BITS][entry & (BLOCK_SIZE - 1)];
+}
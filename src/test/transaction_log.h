@@ -0,0 +1,269 @@
+/**
+ * @file transaction_log.h
+ *
+ * @brief The TransactionLog holds the purchases and trades of every
+ *	  customer, in the order they were made. Each is a small fixed
+ *	  size entry: the customer ID, the type, the Item listed in the
+ *	  inventory, and the number of the customer's next entry. A
+ *	  Customer only keeps the numbers of its first and last entry,
+ *	  so its history is a chain through the log.
+ *
+ * @brief The entries are kept in large blocks, so appending never
+ *	  moves an entry, and the entries made one after another sit
+ *	  together.
+ *
+ * @brief CSS 343 - Lab 4
+ *
+ * @author John Steele  \<steelejr@u.washington.edu\>
+ *
+ * @version 1.0.0
+ * @date December 5, 2010
+ */
+//--------------------------------------------------------------------
+/**
+ * Includes following features:
+ * 	- Allows appending an entry, and linking it to the entry
+ *	  before it in the same customer's history.
+ *	- Allows walking a history, and printing or saving each entry
+ *	  as a PurchaseTransaction or TradeTransaction would.
+ *	- Allows emptying the log.
+ *
+ * Assumptions:
+ *	- The number of an entry is its sequence number in the log.
+ *	- The Items outlive the log. They are not deleted by it.
+ *	- One thread appends, and no other thread reads meanwhile.
+ */
+//--------------------------------------------------------------------
+
+#ifndef TRANSACTION_LOG_H
+#define TRANSACTION_LOG_H
+
+#include <iostream>
+#include <vector>
+#include "item.h"
+#include "snapshot_file.h"
+#include "command.h"
+/**
+ * @namespace std
+ */
+using namespace std;
+
+
+/**
+ * @class TransactionLog
+ */
+class TransactionLog {
+
+/**
+ * @public
+ */
+public:
+
+	//---------------------Constructor----------------------------
+	/**
+	 * @brief Creates an empty TransactionLog.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: This TransactionLog was created empty.
+	 */
+	TransactionLog ();
+
+
+	//---------------------Destructor-----------------------------
+	/**
+	 * @brief Frees the blocks of entries. The Items are not
+	 *	  deleted.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The blocks were freed.
+	 */
+	~TransactionLog ();
+
+
+	//---------------------append---------------------------------
+	/**
+	 * @brief Appends an entry, and links the previous entry of the
+	 *	  same customer to it.
+	 *
+	 * Preconditions: item is not NULL. previous is -1, or the last
+	 *		  entry of the customer's history.
+	 *
+	 * Postconditions: The entry was appended at the end of the
+	 *		   log and of the customer's history, and its
+	 *		   number was returned.
+	 *
+	 * @param cust_id The customer ID.
+	 * @param type The type of transaction.
+	 * @param item The Item listed in the inventory.
+	 * @param previous The customer's last entry, or -1.
+	 * @return The number of the new entry.
+	 */
+	int append (long long cust_id, char type, const Item *item,
+							int previous);
+
+
+	//---------------------getNext--------------------------------
+	/**
+	 * @brief Returns the entry that follows the provided one in
+	 *	  its customer's history.
+	 *
+	 * Preconditions: entry is in the log.
+	 *
+	 * Postconditions: The next entry, or -1 if it is the last, was
+	 *		   returned.
+	 *
+	 * @param entry The entry.
+	 * @return The next entry, or -1.
+	 */
+	int getNext (int entry) const;
+
+
+	//---------------------getType--------------------------------
+	/**
+	 * @brief Returns the type of transaction of an entry.
+	 *
+	 * Preconditions: entry is in the log.
+	 *
+	 * Postconditions: The type was returned.
+	 *
+	 * @param entry The entry.
+	 * @return The type.
+	 */
+	char getType (int entry) const;
+
+
+	//---------------------getItem--------------------------------
+	/**
+	 * @brief Returns the Item of an entry.
+	 *
+	 * Preconditions: entry is in the log.
+	 *
+	 * Postconditions: The Item was returned.
+	 *
+	 * @param entry The entry.
+	 * @return The Item.
+	 */
+	const Item * getItem (int entry) const;
+
+
+	//---------------------print----------------------------------
+	/**
+	 * @brief Prints an entry as its PurchaseTransaction or
+	 *	  TradeTransaction would.
+	 *
+	 * Preconditions: entry is in the log.
+	 *
+	 * Postconditions: The entry was sent to the output stream.
+	 *
+	 * @param entry The entry.
+	 * @param output The output stream.
+	 */
+	void print (int entry, ostream &output) const;
+
+
+	//---------------------save-----------------------------------
+	/**
+	 * @brief Writes an entry to a snapshot as its
+	 *	  PurchaseTransaction or TradeTransaction would: the
+	 *	  type, customer ID and Item.
+	 *
+	 * Preconditions: entry is in the log, and a section of the
+	 *		  snapshot is being written.
+	 *
+	 * Postconditions: The entry was written.
+	 *
+	 * @param entry The entry.
+	 * @param output The snapshot to write to.
+	 */
+	void save (int entry, SnapshotWriter &output) const;
+
+
+	//---------------------getSize--------------------------------
+	/**
+	 * @brief Returns the number of entries in the log.
+	 *
+	 * Preconditions: None.
+	 *
+	 * Postconditions: The number of entries was returned.
+	 *
+	 * @return The number of entries.
+	 */
+	int getSize () const;
+
+
+	//---------------------clear----------------------------------
+	/**
+	 * @brief Removes every entry, and frees the blocks.
+	 *
+	 * Preconditions: No Customer refers to the entries.
+	 *
+	 * Postconditions: The log is empty.
+	 */
+	void clear ();
+
+/**
+ * @private
+ */
+private:
+
+	//---------------------Copy-Constructor-----------------------
+	/**
+	 * @brief Not implemented; the Customers refer to one log.
+	 */
+	TransactionLog (const TransactionLog &the_other);
+
+
+	//---------------------operator(=)----------------------------
+	/**
+	 * @brief Not implemented; the Customers refer to one log.
+	 */
+	const TransactionLog & operator= (const TransactionLog &the_other);
+
+	/**
+	 * @brief An entry: 24 bytes on a 64 bit machine.
+	 */
+	struct Entry {
+		const Item *item;
+		long long   cust_id;
+		int         next;
+		char        type;
+	};
+
+
+	//---------------------at-------------------------------------
+	/**
+	 * @brief Returns an entry by its number.
+	 *
+	 * Preconditions: entry is in the log.
+	 *
+	 * Postconditions: The entry was returned.
+	 *
+	 * @param entry The number of the entry.
+	 * @return The entry.
+	 */
+	Entry & at (int entry) const;
+
+	/**
+	 * @brief The number of bits of an entry number that select the
+	 *	  entry within its block.
+	 */
+	static const int BLOCK_BITS = 12;
+
+	/**
+	 * @brief The entries in a block.
+	 */
+	static const int BLOCK_SIZE = 1 << BLOCK_BITS;
+
+	/**
+	 * @brief The blocks, in order. Only the last is not full.
+	 */
+	vector<Entry *> my_blocks;
+
+	/**
+	 * @brief The number of entries.
+	 */
+	int my_size;
+};
+#endif /* TRANSACTION_LOG_H */